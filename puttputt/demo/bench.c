@@ -0,0 +1,835 @@
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+#include <unistd.h>
+#include "aabb.h"
+#include "aabb_tree.h"
+#include "broadphase.h"
+#include "vector.h"
+#include "body.h"
+#include "scene.h"
+#include "forces.h"
+#include "collision.h"
+#include "job_system.h"
+#include "golf_hole.h"
+
+// Headless benchmarks for the physics library.
+// Run bin/bench and compare the timings printed for each section.
+
+const size_t BENCH_SIZES[] = {100, 1000, 10000};
+const size_t NUM_BENCH_SIZES = sizeof(BENCH_SIZES) / sizeof(BENCH_SIZES[0]);
+const int BENCH_STEPS = 20;
+const double BENCH_DT = 1.0 / 60;
+const double BENCH_SPACING = 20;
+const double BENCH_MIN_SIZE = 2;
+const double BENCH_SIZE_RANGE = 8;
+const double BENCH_MAX_SPEED = 60;
+const double BENCH_TREE_MARGIN = 4;
+const double BENCH_CELL_SIZE = 20;
+const int GRAVITY_TICKS = 3;
+const double GRAVITY_G = 500;
+const double GRAVITY_THETA = 0.5;
+const double GRAVITY_BODY_SIZE = 2;
+const double GRAVITY_MASS = 10;
+const int SPRING_TICKS = 20;
+const double SPRING_K = 10;
+const double SPRING_GAMMA = 2;
+const size_t SAT_WALLS[] = {4, 16, 64};
+const size_t NUM_SAT_WALLS = sizeof(SAT_WALLS) / sizeof(SAT_WALLS[0]);
+const int SAT_TRIALS = 2000;
+const int SAT_BALL_POINTS = 20;
+const double SAT_BALL_RADIUS = 10;
+const double SAT_AREA = 60;
+const double SHAPE_WALL_RADIUS = 1;
+// every ball overlaps the course, so the awake scene gets slow quickly
+const size_t IDLE_SIZES[] = {100, 1000};
+const size_t NUM_IDLE_SIZES = sizeof(IDLE_SIZES) / sizeof(IDLE_SIZES[0]);
+const double IDLE_FRICTION = 100;
+const double IDLE_SLEEP_SPEED = 2;
+const size_t IDLE_SLEEP_TICKS = 30;
+// long enough for every ball to come to rest and fall asleep
+const int IDLE_SETTLE_TICKS = 120;
+const int IDLE_TICKS = 20;
+const int SNAPSHOT_TRIALS = 10000;
+const int SNAPSHOT_TICKS = 200;
+const double HOLE_SIZE = 600;
+const int SNAPSHOT_REBUILDS = 1000;
+const double HOLE_BALL_RADIUS = 12;
+const double HOLE_WALL_RADIUS = 2.5;
+const size_t SCALING_BODIES = 10000;
+const int SCALING_TICKS = 5;
+// the scaling table goes up to at least this many threads, even on fewer cores
+const size_t SCALING_MIN_THREADS = 4;
+const int CLONE_TRIALS = 1000;
+const int CLONE_TICKS = 240;
+const vector_t CLONE_DRAG = {-60, -80};
+const size_t REMOVAL_SIZES[] = {1000, 10000};
+const size_t NUM_REMOVAL_SIZES = sizeof(REMOVAL_SIZES) / sizeof(REMOVAL_SIZES[0]);
+const double REMOVAL_GAMMA = 0.1;
+
+// shared by the sections that time a scene with a job system
+job_system_t *bench_jobs;
+
+typedef struct{
+    vector_t position;
+    vector_t velocity;
+    vector_t half_size;
+    size_t proxy;
+} bench_box_t;
+
+double random_range(double min, double max){
+    return min + (max - min) * rand() / RAND_MAX;
+}
+
+double seconds_since(clock_t start){
+    return (double) (clock() - start) / CLOCKS_PER_SEC;
+}
+
+// clock() adds up the time of every thread, so ticks that may run jobs are timed by the wall clock
+double wall_seconds(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+aabb_t box_bounds(bench_box_t *box){
+    aabb_t bounds = {
+        .min = vec_subtract(box->position, box->half_size),
+        .max = vec_add(box->position, box->half_size)
+    };
+    return bounds;
+}
+
+bench_box_t *random_boxes(size_t n, double world_size){
+    bench_box_t *boxes = malloc(n * sizeof(bench_box_t));
+    assert(boxes);
+    for(size_t i = 0; i < n; i++){
+        boxes[i].position = (vector_t) {random_range(0, world_size), random_range(0, world_size)};
+        boxes[i].velocity = (vector_t) {random_range(-BENCH_MAX_SPEED, BENCH_MAX_SPEED), random_range(-BENCH_MAX_SPEED, BENCH_MAX_SPEED)};
+        double size = random_range(BENCH_MIN_SIZE, BENCH_MIN_SIZE + BENCH_SIZE_RANGE);
+        boxes[i].half_size = (vector_t) {size / 2, size / 2};
+    }
+    return boxes;
+}
+
+// moves every box, bouncing off the edges of the world
+void move_boxes(bench_box_t *boxes, size_t n, double world_size){
+    for(size_t i = 0; i < n; i++){
+        boxes[i].position = vec_add(boxes[i].position, vec_multiply(BENCH_DT, boxes[i].velocity));
+        if(boxes[i].position.x < 0 || boxes[i].position.x > world_size) boxes[i].velocity.x *= -1;
+        if(boxes[i].position.y < 0 || boxes[i].position.y > world_size) boxes[i].velocity.y *= -1;
+    }
+}
+
+size_t brute_force_pairs(aabb_t *bounds, size_t n){
+    size_t pairs = 0;
+    for(size_t i = 0; i < n; i++){
+        for(size_t j = i + 1; j < n; j++){
+            if(aabb_overlap(bounds[i], bounds[j])) pairs++;
+        }
+    }
+    return pairs;
+}
+
+void count_pair(void *item1, void *item2, size_t *pairs){
+    (*pairs)++;
+}
+
+bool count_item(void *item, size_t *items){
+    (*items)++;
+    return true;
+}
+
+// times finding every overlapping pair of moving boxes with each broadphase
+void bench_broadphase(size_t n){
+    double world_size = sqrt((double) n) * BENCH_SPACING;
+    srand(n);
+    bench_box_t *boxes = random_boxes(n, world_size);
+    aabb_t *bounds = malloc(n * sizeof(aabb_t));
+    assert(bounds);
+    broadphase_t *grid = broadphase_init();
+    aabb_tree_t *tree = aabb_tree_init(BENCH_TREE_MARGIN);
+    for(size_t i = 0; i < n; i++){
+        boxes[i].proxy = aabb_tree_insert(tree, &boxes[i], box_bounds(&boxes[i]));
+    }
+    double brute_time = 0;
+    double grid_time = 0;
+    double tree_time = 0;
+    size_t total_pairs = 0;
+    size_t reinserted = 0;
+    for(int step = 0; step < BENCH_STEPS; step++){
+        move_boxes(boxes, n, world_size);
+        for(size_t i = 0; i < n; i++){
+            bounds[i] = box_bounds(&boxes[i]);
+        }
+
+        clock_t start = clock();
+        size_t brute_pairs = brute_force_pairs(bounds, n);
+        brute_time += seconds_since(start);
+
+        start = clock();
+        broadphase_clear(grid, BENCH_CELL_SIZE);
+        for(size_t i = 0; i < n; i++){
+            broadphase_insert(grid, &boxes[i], bounds[i]);
+        }
+        size_t grid_pairs = 0;
+        broadphase_find_pairs(grid, (pair_handler_t) count_pair, &grid_pairs);
+        grid_time += seconds_since(start);
+
+        start = clock();
+        for(size_t i = 0; i < n; i++){
+            reinserted += aabb_tree_move(tree, boxes[i].proxy, bounds[i]);
+        }
+        size_t tree_pairs = 0;
+        aabb_tree_find_pairs(tree, (pair_handler_t) count_pair, &tree_pairs);
+        tree_time += seconds_since(start);
+
+        assert(grid_pairs == brute_pairs);
+        assert(tree_pairs == brute_pairs);
+        total_pairs += brute_pairs;
+    }
+    // spatial queries the size of a typical box
+    clock_t start = clock();
+    size_t found = 0;
+    for(size_t i = 0; i < n; i++){
+        aabb_tree_query(tree, bounds[i], (aabb_query_handler_t) count_item, &found);
+    }
+    double query_time = seconds_since(start);
+    printf("%8zu %12.3f %12.3f %12.3f %10.1f %8zu %8zu %12.3f\n", n,
+        1000 * brute_time / BENCH_STEPS, 1000 * grid_time / BENCH_STEPS, 1000 * tree_time / BENCH_STEPS,
+        (double) total_pairs / BENCH_STEPS, reinserted / BENCH_STEPS, aabb_tree_height(tree), 1000 * query_time);
+    aabb_tree_free(tree);
+    broadphase_free(grid);
+    free(bounds);
+    free(boxes);
+}
+
+// a scene of small triangles spread over a square, all pulling on each other
+scene_t *gravity_scene(size_t n, double theta){
+    double world_size = sqrt((double) n) * BENCH_SPACING;
+    srand(n);
+    scene_t *scene = scene_init();
+    list_t *bodies = list_init(n, (free_func_t) free);
+    for(size_t i = 0; i < n; i++){
+        vector_t center = {random_range(0, world_size), random_range(0, world_size)};
+        list_t *shape = list_init(3, (free_func_t) body_free_vec_list);
+        for(int j = 0; j < 3; j++){
+            vector_t *point = malloc(sizeof(vector_t));
+            assert(point);
+            point->x = center.x + GRAVITY_BODY_SIZE * cos(2 * M_PI * j / 3);
+            point->y = center.y + GRAVITY_BODY_SIZE * sin(2 * M_PI * j / 3);
+            list_add(shape, point);
+        }
+        rgb_color_t color = {0, 0, 0};
+        body_t *body = body_init(shape, GRAVITY_MASS, color);
+        scene_add_body(scene, body);
+        list_add(bodies, body);
+    }
+    create_gravity_field(scene, GRAVITY_G, theta, bodies);
+    return scene;
+}
+
+double time_ticks(scene_t *scene, int ticks){
+    double start = wall_seconds();
+    for(int i = 0; i < ticks; i++){
+        scene_tick(scene, BENCH_DT);
+    }
+    return (wall_seconds() - start) / ticks;
+}
+
+// times exact pairwise gravity against the Barnes-Hut approximation
+void bench_gravity(size_t n){
+    scene_t *exact = gravity_scene(n, 0);
+    scene_t *approx = gravity_scene(n, GRAVITY_THETA);
+    double exact_time = time_ticks(exact, 1);
+    double approx_time = time_ticks(approx, 1);
+    // starting from rest, the velocity after one tick is proportional to the force
+    double error = 0;
+    double total = 0;
+    for(size_t i = 0; i < n; i++){
+        vector_t v_exact = body_get_velocity(scene_get_body(exact, i));
+        vector_t v_approx = body_get_velocity(scene_get_body(approx, i));
+        error += sqrt(vec_dot(vec_subtract(v_approx, v_exact), vec_subtract(v_approx, v_exact)));
+        total += sqrt(vec_dot(v_exact, v_exact));
+    }
+    approx_time = (approx_time + GRAVITY_TICKS * time_ticks(approx, GRAVITY_TICKS)) / (GRAVITY_TICKS + 1);
+    scene_t *threaded = gravity_scene(n, GRAVITY_THETA);
+    scene_set_job_system(threaded, bench_jobs);
+    double threaded_time = time_ticks(threaded, GRAVITY_TICKS + 1);
+    printf("%8zu %12.3f %12.3f %12.3f %12.4f\n", n, 1000 * exact_time, 1000 * approx_time, 1000 * threaded_time, total > 0 ? error / total : 0);
+    scene_free(exact);
+    scene_free(approx);
+    scene_free(threaded);
+}
+
+typedef struct{
+    body_t *body1;
+    body_t *body2;
+    double constant;
+} bench_force_t;
+
+// the same forces as create_spring() and create_drag(), one callback per force
+void callback_spring(bench_force_t *spring){
+    vector_t displacement = vec_subtract(body_get_centroid(spring->body2), body_get_centroid(spring->body1));
+    body_add_force(spring->body1, vec_multiply(spring->constant, displacement));
+}
+
+void callback_drag(bench_force_t *drag){
+    body_add_force(drag->body1, vec_multiply(-1 * drag->constant, body_get_velocity(drag->body1)));
+}
+
+void add_callback_force(scene_t *scene, force_creator_t forcer, body_t *body1, body_t *body2, double constant){
+    bench_force_t *force = malloc(sizeof(bench_force_t));
+    assert(force);
+    force->body1 = body1;
+    force->body2 = body2;
+    force->constant = constant;
+    list_t *bodies = list_init(2, (free_func_t) free);
+    list_add(bodies, body1);
+    if(body2 != body1) list_add(bodies, body2);
+    scene_add_bodies_force_creator(scene, forcer, force, bodies, free);
+}
+
+// n small triangles, each on a damped spring to a fixed anchor
+scene_t *spring_scene(size_t n, bool batched){
+    double world_size = sqrt((double) n) * BENCH_SPACING;
+    srand(n);
+    scene_t *scene = scene_init();
+    for(size_t i = 0; i < n; i++){
+        body_t *pair[2];
+        for(int k = 0; k < 2; k++){
+            vector_t center = {random_range(0, world_size), random_range(0, world_size)};
+            list_t *shape = list_init(3, (free_func_t) body_free_vec_list);
+            for(int j = 0; j < 3; j++){
+                vector_t *point = malloc(sizeof(vector_t));
+                assert(point);
+                point->x = center.x + GRAVITY_BODY_SIZE * cos(2 * M_PI * j / 3);
+                point->y = center.y + GRAVITY_BODY_SIZE * sin(2 * M_PI * j / 3);
+                list_add(shape, point);
+            }
+            rgb_color_t color = {0, 0, 0};
+            pair[k] = body_init(shape, k == 0 ? GRAVITY_MASS : INFINITY, color);
+            scene_add_body(scene, pair[k]);
+        }
+        if(batched){
+            create_spring(scene, SPRING_K, pair[0], pair[1]);
+            create_drag(scene, SPRING_GAMMA, pair[0]);
+        }
+        else{
+            add_callback_force(scene, (force_creator_t) callback_spring, pair[0], pair[1], SPRING_K);
+            add_callback_force(scene, (force_creator_t) callback_drag, pair[0], pair[0], SPRING_GAMMA);
+        }
+    }
+    return scene;
+}
+
+// times per-kind force kernels against a force_creator_t call per force
+void bench_springs(size_t n){
+    scene_t *callbacks = spring_scene(n, false);
+    scene_t *batched = spring_scene(n, true);
+    scene_t *threaded = spring_scene(n, true);
+    scene_set_job_system(threaded, bench_jobs);
+    double callback_time = time_ticks(callbacks, SPRING_TICKS);
+    double batched_time = time_ticks(batched, SPRING_TICKS);
+    double threaded_time = time_ticks(threaded, SPRING_TICKS);
+    double difference = 0;
+    for(size_t i = 0; i < scene_bodies(batched); i++){
+        vector_t c1 = body_get_centroid(scene_get_body(callbacks, i));
+        vector_t c2 = body_get_centroid(scene_get_body(batched, i));
+        difference = fmax(difference, sqrt(vec_dot(vec_subtract(c1, c2), vec_subtract(c1, c2))));
+    }
+    // threads only change who sums each lane, never the order the lanes are added in
+    for(size_t i = 0; i < scene_bodies(batched); i++){
+        vector_t c1 = body_get_centroid(scene_get_body(batched, i));
+        vector_t c2 = body_get_centroid(scene_get_body(threaded, i));
+        assert(c1.x == c2.x && c1.y == c2.y);
+    }
+    printf("%8zu %12.3f %12.3f %12.3f %12.3g\n", n, 1000 * callback_time, 1000 * batched_time, 1000 * threaded_time, difference);
+    scene_free(threaded);
+    scene_free(callbacks);
+    scene_free(batched);
+}
+
+// the separating axis test as it was first written, with a sqrt per vertex, to check against
+vector_t reference_proj(const vector_t *points, size_t n, vector_t axis){
+    double min = INT16_MAX;
+    double max = INT16_MIN;
+    for(size_t i = 0; i < n; i++){
+        vector_t unit = vec_multiply(1/sqrt(vec_dot(axis, axis)), axis);
+        double proj = vec_dot(points[i], unit);
+        if(proj < min) min = proj;
+        if(proj > max) max = proj;
+    }
+    return (vector_t) {min, max};
+}
+
+collision_info_t reference_helper(const vector_t *shape1, size_t n1, const vector_t *shape2, size_t n2, double *min_overlap){
+    *min_overlap = INT16_MAX;
+    vector_t min_axis = VEC_ZERO;
+    for(size_t i = 0; i < n1; i++){
+        vector_t axis = vec_rotate(vec_subtract(shape1[i], shape1[(i + 1) % n1]), M_PI / 2);
+        vector_t proj1 = reference_proj(shape1, n1, axis);
+        vector_t proj2 = reference_proj(shape2, n2, axis);
+        axis = vec_multiply(1/sqrt(vec_dot(axis, axis)), axis);
+        if((proj1.x < proj2.x && proj1.y < proj2.x) || (proj2.x < proj1.x && proj2.y < proj1.x)){
+            return (collision_info_t) {.collided = false};
+        }
+        double overlap = fmin(proj1.y, proj2.y) - fmax(proj1.x, proj2.x);
+        if(overlap < *min_overlap){
+            *min_overlap = overlap;
+            min_axis = axis;
+        }
+    }
+    return (collision_info_t) {.collided = true, .axis = min_axis};
+}
+
+collision_info_t reference_collision(const vector_t *shape1, size_t n1, const vector_t *shape2, size_t n2){
+    double overlap1, overlap2;
+    collision_info_t info1 = reference_helper(shape1, n1, shape2, n2, &overlap1);
+    collision_info_t info2 = reference_helper(shape2, n2, shape1, n1, &overlap2);
+    if(!info1.collided || !info2.collided) return (collision_info_t) {.collided = false};
+    return overlap1 < overlap2 ? info1 : info2;
+}
+
+bool same_collision(collision_info_t info1, collision_info_t info2){
+    if(info1.collided != info2.collided) return false;
+    return !info1.collided || (info1.axis.x == info2.axis.x && info1.axis.y == info2.axis.y);
+}
+
+// times one ball against a number of randomly placed thin walls
+void bench_sat(size_t num_walls){
+    srand(num_walls);
+    vector_t *ball = malloc(SAT_BALL_POINTS * sizeof(vector_t));
+    vector_t *walls = malloc(4 * num_walls * sizeof(vector_t));
+    const vector_t **others = malloc(num_walls * sizeof(vector_t *));
+    size_t *counts = malloc(num_walls * sizeof(size_t));
+    collision_info_t *results = malloc(num_walls * sizeof(collision_info_t));
+    // the axes a body would have cached for the ball and each wall
+    vector_t *ball_axes = malloc(2 * SAT_BALL_POINTS * sizeof(vector_t));
+    vector_t *wall_axes = malloc(2 * 4 * num_walls * sizeof(vector_t));
+    assert(ball && walls && others && counts && results && ball_axes && wall_axes);
+    double reference_time = 0, single_time = 0, batch_time = 0, cached_time = 0;
+    size_t mismatches = 0, hits = 0;
+    for(int trial = 0; trial < SAT_TRIALS; trial++){
+        vector_t center = {random_range(0, SAT_AREA), random_range(0, SAT_AREA)};
+        for(int i = 0; i < SAT_BALL_POINTS; i++){
+            ball[i].x = center.x + SAT_BALL_RADIUS * cos(2 * M_PI * i / SAT_BALL_POINTS);
+            ball[i].y = center.y + SAT_BALL_RADIUS * sin(2 * M_PI * i / SAT_BALL_POINTS);
+        }
+        for(size_t k = 0; k < num_walls; k++){
+            vector_t start = {random_range(0, SAT_AREA), random_range(0, SAT_AREA)};
+            vector_t end = vec_add(start, (vector_t) {random_range(-20, 20), random_range(-20, 20)});
+            vector_t diff = vec_subtract(end, start);
+            vector_t shift = vec_multiply(1 / sqrt(vec_dot(diff, diff)), vec_rotate(diff, M_PI / 2));
+            vector_t *wall = &walls[4 * k];
+            wall[0] = vec_add(start, shift);
+            wall[1] = vec_subtract(start, shift);
+            wall[2] = vec_subtract(end, shift);
+            wall[3] = vec_add(end, shift);
+            others[k] = wall;
+            counts[k] = 4;
+            find_edge_axes(wall, 4, &wall_axes[8 * k], &wall_axes[8 * k + 4]);
+        }
+        find_edge_axes(ball, SAT_BALL_POINTS, ball_axes, ball_axes + SAT_BALL_POINTS);
+        clock_t start = clock();
+        for(size_t k = 0; k < num_walls; k++){
+            results[k] = reference_collision(ball, SAT_BALL_POINTS, others[k], 4);
+        }
+        reference_time += seconds_since(start);
+        start = clock();
+        for(size_t k = 0; k < num_walls; k++){
+            collision_info_t info = find_collision_points(ball, SAT_BALL_POINTS, others[k], 4);
+            if(!same_collision(info, results[k])) mismatches++;
+            hits += info.collided;
+        }
+        single_time += seconds_since(start);
+        start = clock();
+        for(size_t k = 0; k < num_walls; k++){
+            collision_info_t info = find_collision_axes(ball, SAT_BALL_POINTS, ball_axes, ball_axes + SAT_BALL_POINTS,
+                others[k], 4, &wall_axes[8 * k], &wall_axes[8 * k + 4]);
+            if(!same_collision(info, results[k])) mismatches++;
+        }
+        cached_time += seconds_since(start);
+        collision_info_t *expected = malloc(num_walls * sizeof(collision_info_t));
+        assert(expected);
+        for(size_t k = 0; k < num_walls; k++) expected[k] = results[k];
+        start = clock();
+        find_collisions(ball, SAT_BALL_POINTS, others, counts, num_walls, results);
+        batch_time += seconds_since(start);
+        for(size_t k = 0; k < num_walls; k++){
+            if(!same_collision(expected[k], results[k])) mismatches++;
+        }
+        free(expected);
+    }
+    double scale = 1e6 / SAT_TRIALS;
+    printf("%8zu %12.3f %12.3f %12.3f %12.3f %8zu %10zu\n", num_walls,
+        scale * reference_time, scale * single_time, scale * batch_time, scale * cached_time, hits, mismatches);
+    free(wall_axes);
+    free(ball_axes);
+    free(results);
+    free(counts);
+    free(others);
+    free(walls);
+    free(ball);
+}
+
+// times a circular ball against capsule walls, exactly and with SAT on their polygons
+void bench_shapes(size_t num_walls){
+    srand(num_walls);
+    body_t **walls = malloc(num_walls * sizeof(body_t *));
+    assert(walls);
+    rgb_color_t color = {0, 0, 0};
+    double polygon_time = 0, exact_time = 0;
+    size_t polygon_hits = 0, exact_hits = 0;
+    for(int trial = 0; trial < SAT_TRIALS; trial++){
+        vector_t center = {random_range(0, SAT_AREA), random_range(0, SAT_AREA)};
+        body_t *ball = body_init_circle(center, SAT_BALL_RADIUS, SAT_BALL_POINTS, 1, color, NULL, NULL);
+        for(size_t k = 0; k < num_walls; k++){
+            vector_t start = {random_range(0, SAT_AREA), random_range(0, SAT_AREA)};
+            vector_t end = vec_add(start, (vector_t) {random_range(-20, 20), random_range(-20, 20)});
+            walls[k] = body_init_capsule(start, end, SHAPE_WALL_RADIUS, INFINITY, color, NULL, NULL);
+        }
+        size_t n;
+        const vector_t *ball_points = body_shape_view(ball, &n);
+        clock_t start = clock();
+        for(size_t k = 0; k < num_walls; k++){
+            size_t wall_n;
+            const vector_t *wall_points = body_shape_view(walls[k], &wall_n);
+            polygon_hits += find_collision_points(ball_points, n, wall_points, wall_n).collided;
+        }
+        polygon_time += seconds_since(start);
+        start = clock();
+        for(size_t k = 0; k < num_walls; k++){
+            exact_hits += find_body_collision(ball, walls[k]).collided;
+        }
+        exact_time += seconds_since(start);
+        for(size_t k = 0; k < num_walls; k++) body_free(walls[k]);
+        body_free(ball);
+    }
+    double scale = 1e6 / SAT_TRIALS;
+    printf("%8zu %12.3f %12.3f %12zu %12zu\n", num_walls, scale * polygon_time, scale * exact_time, polygon_hits, exact_hits);
+    free(walls);
+}
+
+// n balls rolling to a stop on a course, each next to a wall it can bounce off, like golf between shots
+scene_t *idle_scene(size_t n, bool sleeping){
+    double world_size = sqrt((double) n) * BENCH_SPACING * 2;
+    srand(n);
+    scene_t *scene = scene_init();
+    if(sleeping) scene_enable_sleeping(scene, IDLE_SLEEP_SPEED, IDLE_SLEEP_TICKS);
+    rgb_color_t color = {0, 0, 0};
+    polygon_t *floor = polygon_init(4);
+    // the balls stop within BENCH_SPACING, so none of them roll off the course
+    polygon_add(floor, (vector_t) {-BENCH_SPACING, -BENCH_SPACING});
+    polygon_add(floor, (vector_t) {world_size + BENCH_SPACING, -BENCH_SPACING});
+    polygon_add(floor, (vector_t) {world_size + BENCH_SPACING, world_size + BENCH_SPACING});
+    polygon_add(floor, (vector_t) {-BENCH_SPACING, world_size + BENCH_SPACING});
+    body_t *course = body_init_polygon(floor, INFINITY, color, NULL, NULL);
+    scene_add_body(scene, course);
+    for(size_t i = 0; i < n; i++){
+        vector_t center = {random_range(0, world_size), random_range(0, world_size)};
+        body_t *ball = body_init_circle(center, GRAVITY_BODY_SIZE, SAT_BALL_POINTS, 1, color, NULL, NULL);
+        body_set_velocity(ball, (vector_t) {random_range(-BENCH_MAX_SPEED, BENCH_MAX_SPEED), 0});
+        vector_t wall_start = vec_add(center, (vector_t) {-BENCH_SPACING / 2, -2 * GRAVITY_BODY_SIZE});
+        vector_t wall_end = vec_add(center, (vector_t) {BENCH_SPACING / 2, -2 * GRAVITY_BODY_SIZE});
+        body_t *wall = body_init_capsule(wall_start, wall_end, SHAPE_WALL_RADIUS, INFINITY, color, NULL, NULL);
+        scene_add_body(scene, ball);
+        scene_add_body(scene, wall);
+        create_friction(scene, IDLE_FRICTION, ball, course);
+        create_physics_collision(scene, 1, ball, wall);
+    }
+    return scene;
+}
+
+// times ticks of a scene whose bodies have all stopped, with and without sleeping
+void bench_sleeping(size_t n){
+    scene_t *awake = idle_scene(n, false);
+    scene_t *sleeping = idle_scene(n, true);
+    time_ticks(awake, IDLE_SETTLE_TICKS);
+    time_ticks(sleeping, IDLE_SETTLE_TICKS);
+    double awake_time = time_ticks(awake, IDLE_TICKS);
+    double sleeping_time = time_ticks(sleeping, IDLE_TICKS);
+    printf("%8zu %12.3f %12.3f %12zu\n", n, 1000 * awake_time, 1000 * sleeping_time, scene_awake_bodies(sleeping));
+    scene_free(awake);
+    scene_free(sleeping);
+}
+
+void count_hit(body_t *ball, body_t *target, vector_t axis, size_t *hits){
+    (*hits)++;
+}
+
+// a golf hole like the ones in demo/golf.c: an L-shaped course walled in all around,
+// a rough patch on a slope, a cup, and two balls in play
+scene_t *hole_scene(size_t *hits){
+    scene_t *scene = scene_init();
+    scene_enable_sleeping(scene, IDLE_SLEEP_SPEED, IDLE_SLEEP_TICKS);
+    rgb_color_t color = {0, 0, 0};
+    polygon_t *outline = polygon_init(6);
+    polygon_add(outline, (vector_t) {0, 0});
+    polygon_add(outline, (vector_t) {HOLE_SIZE, 0});
+    polygon_add(outline, (vector_t) {HOLE_SIZE, HOLE_SIZE});
+    polygon_add(outline, (vector_t) {HOLE_SIZE / 2, HOLE_SIZE});
+    polygon_add(outline, (vector_t) {HOLE_SIZE / 2, HOLE_SIZE / 3});
+    polygon_add(outline, (vector_t) {0, HOLE_SIZE / 3});
+    body_t *course = body_init_polygon(outline, INFINITY, color, NULL, NULL);
+    scene_add_body(scene, course);
+    polygon_t *rough = polygon_init(4);
+    polygon_add(rough, (vector_t) {2 * HOLE_SIZE / 5, HOLE_SIZE / 30});
+    polygon_add(rough, (vector_t) {HOLE_SIZE / 2, HOLE_SIZE / 30});
+    polygon_add(rough, (vector_t) {HOLE_SIZE / 2, 3 * HOLE_SIZE / 10});
+    polygon_add(rough, (vector_t) {2 * HOLE_SIZE / 5, 3 * HOLE_SIZE / 10});
+    body_t *patch = body_init_polygon(rough, INFINITY, color, NULL, NULL);
+    scene_add_body(scene, patch);
+    body_t *cup = body_init_circle((vector_t) {3 * HOLE_SIZE / 4, 5 * HOLE_SIZE / 6}, HOLE_BALL_RADIUS, SAT_BALL_POINTS, INFINITY, color, NULL, NULL);
+    scene_add_body(scene, cup);
+    vector_t starts[] = {{HOLE_SIZE / 10, HOLE_SIZE / 6}, {HOLE_SIZE / 5, HOLE_SIZE / 6}};
+    body_t *balls[2];
+    for(int i = 0; i < 2; i++){
+        balls[i] = body_init_circle(starts[i], HOLE_BALL_RADIUS, SAT_BALL_POINTS, 1, color, NULL, NULL);
+        body_set_bullet(balls[i], true);
+        scene_add_body(scene, balls[i]);
+        create_friction(scene, IDLE_FRICTION, balls[i], course);
+        create_frictional_and_slope_force(scene, 0.3, M_PI / 8, (vector_t) {0, 1}, 500, balls[i], patch);
+        create_collision(scene, balls[i], cup, (collision_handler_t) count_hit, hits, NULL);
+    }
+    create_physics_collision(scene, 0.9, balls[0], balls[1]);
+    size_t n;
+    const vector_t *corners = body_shape_view(course, &n);
+    for(size_t i = 0; i < n; i++){
+        body_t *wall = body_init_capsule(corners[i], corners[(i + 1) % n], HOLE_WALL_RADIUS, INFINITY, color, NULL, NULL);
+        scene_add_body(scene, wall);
+        for(int k = 0; k < 2; k++){
+            create_physics_collision(scene, 0.8, balls[k], wall);
+            create_collision(scene, balls[k], wall, (collision_handler_t) count_hit, hits, NULL);
+        }
+    }
+    body_add_impulse(balls[0], (vector_t) {900, 250});
+    body_add_impulse(balls[1], (vector_t) {400, 700});
+    return scene;
+}
+
+// times saving and restoring a hole partway through a shot against building it again,
+// checking that a restored hole plays out exactly as it did the first time
+void bench_snapshot(void){
+    size_t hits = 0;
+    double start = wall_seconds();
+    for(int i = 0; i < SNAPSHOT_REBUILDS; i++){
+        scene_free(hole_scene(&hits));
+    }
+    double rebuild_time = (wall_seconds() - start) / SNAPSHOT_REBUILDS;
+    scene_t *scene = hole_scene(&hits);
+    time_ticks(scene, SNAPSHOT_TICKS / 4);
+    size_t size = scene_snapshot(scene, NULL);
+    char *saved = malloc(size);
+    char *first = malloc(size);
+    char *second = malloc(size);
+    assert(saved && first && second);
+    scene_snapshot(scene, saved);
+    time_ticks(scene, SNAPSHOT_TICKS);
+    scene_snapshot(scene, first);
+    start = wall_seconds();
+    for(int i = 0; i < SNAPSHOT_TRIALS; i++){
+        scene_snapshot(scene, second);
+    }
+    double snapshot_time = (wall_seconds() - start) / SNAPSHOT_TRIALS;
+    start = wall_seconds();
+    for(int i = 0; i < SNAPSHOT_TRIALS; i++){
+        scene_restore(scene, saved);
+    }
+    double restore_time = (wall_seconds() - start) / SNAPSHOT_TRIALS;
+    time_ticks(scene, SNAPSHOT_TICKS);
+    scene_snapshot(scene, second);
+    assert(memcmp(first, second, size) == 0);
+    printf("%8zu %10zu %12.3f %12.3f %12.3f\n", scene_bodies(scene), size, 1e6 * snapshot_time, 1e6 * restore_time, 1e6 * rebuild_time);
+    free(saved);
+    free(first);
+    free(second);
+    scene_free(scene);
+}
+
+bool same_centroids(scene_t *scene1, scene_t *scene2){
+    for(size_t i = 0; i < scene_bodies(scene1); i++){
+        vector_t c1 = body_get_centroid(scene_get_body(scene1, i));
+        vector_t c2 = body_get_centroid(scene_get_body(scene2, i));
+        if(c1.x != c2.x || c1.y != c2.y) return false;
+    }
+    return true;
+}
+
+// times copying each golf hole with scene_clone() against building it again with golf_hole_init(),
+// checking that a copy plays a stroke out exactly as the original does
+void bench_clone(size_t number){
+    scene_t **scenes = malloc(CLONE_TRIALS * sizeof(scene_t *));
+    assert(scenes);
+    double start = wall_seconds();
+    for(int i = 0; i < CLONE_TRIALS; i++){
+        scenes[i] = scene_init();
+        scene_enable_sleeping(scenes[i], IDLE_SLEEP_SPEED, IDLE_SLEEP_TICKS);
+        golf_hole_free(golf_hole_init(scenes[i], number));
+    }
+    double rebuild_time = (wall_seconds() - start) / CLONE_TRIALS;
+    for(int i = 0; i < CLONE_TRIALS; i++){
+        scene_free(scenes[i]);
+    }
+    scene_t *scene = scene_init();
+    scene_enable_sleeping(scene, IDLE_SLEEP_SPEED, IDLE_SLEEP_TICKS);
+    golf_hole_t *hole = golf_hole_init(scene, number);
+    body_t *ball = golf_hole_get_ball(hole, 1);
+    time_ticks(scene, IDLE_SLEEP_TICKS);
+    start = wall_seconds();
+    for(int i = 0; i < CLONE_TRIALS; i++){
+        scenes[i] = scene_clone(scene);
+        assert(scenes[i] != NULL);
+    }
+    double clone_time = (wall_seconds() - start) / CLONE_TRIALS;
+    start = wall_seconds();
+    for(int i = 0; i < CLONE_TRIALS; i++){
+        scene_free(scenes[i]);
+    }
+    double free_time = (wall_seconds() - start) / CLONE_TRIALS;
+    scene_t *clone = scene_clone(scene);
+    assert(clone != NULL);
+    golf_hole_hit(ball, CLONE_DRAG);
+    golf_hole_hit(scene_get_clone(clone, ball), CLONE_DRAG);
+    time_ticks(scene, CLONE_TICKS);
+    time_ticks(clone, CLONE_TICKS);
+    assert(same_centroids(scene, clone));
+    printf("%8zu %8zu %12.3f %12.3f %12.3f\n", number, scene_bodies(scene), 1e6 * rebuild_time, 1e6 * clone_time, 1e6 * free_time);
+    scene_free(clone);
+    golf_hole_free(hole);
+    scene_free(scene);
+    free(scenes);
+}
+
+// a breakout wall of n bricks, each with drag and the forces of a ball that bounces off and breaks it,
+// with the ball kept away so nothing touches
+scene_t *brick_scene(size_t n){
+    size_t columns = (size_t) ceil(sqrt((double) n));
+    scene_t *scene = scene_init();
+    rgb_color_t color = {0, 0, 0};
+    vector_t ball_center = {-10 * BENCH_SPACING, -10 * BENCH_SPACING};
+    body_t *ball = body_init_circle(ball_center, GRAVITY_BODY_SIZE, SAT_BALL_POINTS, 1, color, NULL, NULL);
+    scene_add_body(scene, ball);
+    for(size_t i = 0; i < n; i++){
+        vector_t center = {(i % columns) * BENCH_SPACING, (i / columns) * BENCH_SPACING};
+        body_t *brick = body_init_circle(center, GRAVITY_BODY_SIZE, SAT_BALL_POINTS, 1, color, NULL, NULL);
+        scene_add_body(scene, brick);
+        create_drag(scene, REMOVAL_GAMMA, brick);
+        create_physics_collision(scene, 1, ball, brick);
+        create_destructive_collision(scene, brick, ball);
+    }
+    return scene;
+}
+
+// times the tick that removes every other brick of a breakout wall against one that removes none
+void bench_removal(size_t n){
+    scene_t *scene = brick_scene(n);
+    time_ticks(scene, 1);
+    double tick_time = time_ticks(scene, 1);
+    size_t removed = 0;
+    for(size_t i = 1; i < scene_bodies(scene); i += 2){
+        body_remove(scene_get_body(scene, i));
+        removed++;
+    }
+    double removal_time = time_ticks(scene, 1);
+    assert(scene_bodies(scene) == n + 1 - removed);
+    printf("%8zu %8zu %12.3f %12.3f\n", n, removed, 1000 * tick_time, 1000 * removal_time);
+    scene_free(scene);
+}
+
+// times the gravity field and springs on job systems with more and more threads,
+// checking that every number of threads moves the bodies exactly the same.
+// rows with more threads than cores are marked, since they can only show the job system's overhead
+void bench_scaling(size_t cores){
+    size_t max_threads = cores > SCALING_MIN_THREADS ? cores : SCALING_MIN_THREADS;
+    scene_t *serial_gravity = gravity_scene(SCALING_BODIES, GRAVITY_THETA);
+    scene_t *serial_springs = spring_scene(SCALING_BODIES, true);
+    double gravity_base = time_ticks(serial_gravity, SCALING_TICKS);
+    double springs_base = time_ticks(serial_springs, SCALING_TICKS);
+    for(size_t threads = 1; threads <= max_threads; threads *= 2){
+        job_system_t *jobs = job_system_init(threads);
+        scene_t *gravity = gravity_scene(SCALING_BODIES, GRAVITY_THETA);
+        scene_t *springs = spring_scene(SCALING_BODIES, true);
+        scene_set_job_system(gravity, jobs);
+        scene_set_job_system(springs, jobs);
+        double gravity_time = time_ticks(gravity, SCALING_TICKS);
+        double springs_time = time_ticks(springs, SCALING_TICKS);
+        assert(same_centroids(serial_gravity, gravity));
+        assert(same_centroids(serial_springs, springs));
+        printf(
+            "%8zu %12.3f %10.2fx %12.3f %10.2fx%s\n",
+            threads,
+            1000 * gravity_time,
+            gravity_base / gravity_time,
+            1000 * springs_time,
+            springs_base / springs_time,
+            threads > cores ? "  (more threads than cores)" : ""
+        );
+        scene_free(gravity);
+        scene_free(springs);
+        job_system_free(jobs);
+    }
+    scene_free(serial_gravity);
+    scene_free(serial_springs);
+}
+
+int main(int argc, char *argv[]){
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    bench_jobs = job_system_init(cores > 1 ? (size_t) cores : 1);
+    printf("Broadphase pair finding (ms per step)\n");
+    printf("%8s %12s %12s %12s %10s %8s %8s %12s\n", "bodies", "brute", "grid", "tree", "pairs", "moved", "height", "n queries");
+    for(size_t i = 0; i < NUM_BENCH_SIZES; i++){
+        bench_broadphase(BENCH_SIZES[i]);
+    }
+    printf("\nGravity field (ms per tick, theta = %.2f, %zu threads)\n", GRAVITY_THETA, job_system_size(bench_jobs));
+    printf("%8s %12s %12s %12s %12s\n", "bodies", "exact", "barnes-hut", "threaded", "rel. error");
+    for(size_t i = 0; i < NUM_BENCH_SIZES; i++){
+        bench_gravity(BENCH_SIZES[i]);
+    }
+    printf("\nSprings and drag (ms per tick, %zu threads)\n", job_system_size(bench_jobs));
+    printf("%8s %12s %12s %12s %12s\n", "springs", "callbacks", "batched", "threaded", "max diff");
+    for(size_t i = 0; i < NUM_BENCH_SIZES; i++){
+        bench_springs(BENCH_SIZES[i]);
+    }
+    printf("\nBall against walls, separating axis test (us per ball)\n");
+    printf("%8s %12s %12s %12s %12s %8s %10s\n", "walls", "reference", "single", "batched", "cached", "hits", "mismatches");
+    for(size_t i = 0; i < NUM_SAT_WALLS; i++){
+        bench_sat(SAT_WALLS[i]);
+    }
+    printf("\nCircle against capsules (us per ball)\n");
+    printf("%8s %12s %12s %12s %12s\n", "walls", "polygons", "exact", "poly hits", "exact hits");
+    for(size_t i = 0; i < NUM_SAT_WALLS; i++){
+        bench_shapes(SAT_WALLS[i]);
+    }
+    printf("\nIdle scene (ms per tick)\n");
+    printf("%8s %12s %12s %12s\n", "balls", "awake", "sleeping", "still awake");
+    for(size_t i = 0; i < NUM_IDLE_SIZES; i++){
+        bench_sleeping(IDLE_SIZES[i]);
+    }
+    printf("\nSnapshot and restore of a golf hole (us)\n");
+    printf("%8s %10s %12s %12s %12s\n", "bodies", "bytes", "snapshot", "restore", "rebuild");
+    bench_snapshot();
+    printf("\nCloning a golf hole (us)\n");
+    printf("%8s %8s %12s %12s %12s\n", "hole", "bodies", "rebuild", "clone", "free clone");
+    for(size_t i = 1; i <= GOLF_HOLE_COUNT; i++){
+        bench_clone(i);
+    }
+    printf("\nRemoving half of a breakout wall (ms per tick)\n");
+    printf("%8s %8s %12s %12s\n", "bricks", "removed", "tick", "removal");
+    for(size_t i = 0; i < NUM_REMOVAL_SIZES; i++){
+        bench_removal(REMOVAL_SIZES[i]);
+    }
+    printf(
+        "\nJob system scaling (ms per tick, %zu bodies, speedup over no job system, %zu cores)\n",
+        SCALING_BODIES,
+        job_system_size(bench_jobs)
+    );
+    printf("%8s %12s %11s %12s %11s\n", "threads", "gravity", "", "springs", "");
+    bench_scaling(job_system_size(bench_jobs));
+    job_system_free(bench_jobs);
+    return 0;
+}
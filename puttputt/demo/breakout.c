@@ -12,6 +12,8 @@
 #include "vector.h"
 
 const vector_t MAX_CANVAS_SIZE = {.x=800, .y=800};
+const double PHYSICS_STEP = 1.0 / 240;
+const size_t MAX_SUBSTEPS = 16;
 const double WALL_SIZE = 5;
 const double BRICK_SIZE = 20;
 const double PLAYER_SIZE = 30;
@@ -306,7 +308,7 @@ int main(int argc, char *argv[]) {
             dt_from_last_pellet = 0;
         }
 
-        scene_tick(scene, dt);
+        scene_step_fixed(scene, dt, PHYSICS_STEP, MAX_SUBSTEPS);
         sdl_render_scene(scene);
     }
     scene_free(scene);
@@ -11,6 +11,8 @@
 #include "vector.h"
 
 const vector_t MAX_CANVAS_SIZE = {.x=1000, .y=500};
+const double PHYSICS_STEP = 1.0 / 240;
+const size_t MAX_SUBSTEPS = 16;
 const int COLOR_MAX = 255;
 const int CIRCLE_POINTS = 20;
 const int CIRCLE_SIZE = 10;
@@ -81,7 +83,7 @@ int main(int argc, char *argv[]) {
     //runs untill the window closes
     while (!sdl_is_done(scene)) {
         double dt = time_since_last_tick();
-        scene_tick(scene, dt);
+        scene_step_fixed(scene, dt, PHYSICS_STEP, MAX_SUBSTEPS);
         sdl_render_scene(scene);
     }
     scene_free(scene);
@@ -17,35 +17,29 @@
 #include "body.h"
 #include "list.h"
 #include "vector.h"
-#include "golf_course.h"
+#include "golf_hole.h"
+#include "golf_preview.h"
+#include "typed_vec.h"
+
+// leaderboard scores, read from the leaderboard file
+DECLARE_VEC(score_list, double)
 
 const vector_t MAX_CANVAS_SIZE = {.x=1000, .y=500};
+const double PHYSICS_STEP = 1.0 / 240;
+const size_t MAX_SUBSTEPS = 16;
+// a ball slower than this for SLEEP_TICKS physics steps stops
+const double SLEEP_SPEED = 2;
+const size_t SLEEP_TICKS = 60;
 const double PELLET_SIZE = 5;
-const double HOLE_SIZE = 10;
+const int CIRCLE_POINTS = 20;
 
 // basic color scheme
-const rgb_color_t COURSE_COLOR = {.r=0.2, .g=0.7, .b=0.2};
-const rgb_color_t WALL_COLOR = {.r=0.2, .g=0.5, .b=0.2};
-const rgb_color_t BALL1_COLOR = {.r=1, .g=1, .b=0.5};
-const rgb_color_t BALL2_COLOR = {.r=0.5, .g=1, .b=1};
-const rgb_color_t HOLE_COLOR = {.r=0, .g=0, .b=0};
-const rgb_color_t PATCH_COLOR = {.r=((double) 66)/255, .g=((double) 117)/255, .b=((double) 73)/255};
-const rgb_color_t SLOPE_COLOR = {.r=((double) 30)/255, .g=((double) 117)/255, .b=((double) 73)/255};
-const rgb_color_t BOUNCY_COLOR = {.r=((double) 30)/255, .g=((double) 50)/255, .b=((double) 73)/255};
-const rgb_color_t FORCE_COLOR = {.r=0.5, .g=0.8, .b=0.3};
 const rgb_color_t COIN_COLOR = {.r=0.5, .g=1, .b=0.5};
 const rgb_color_t FREEZE_PELLET_COLOR = {.r=0.25, .g=0.75, .b=0.25};
 const rgb_color_t BACKGROUND_COLOR = {.r=((double) 158)/255, .g=((double) 231)/255, .b=((double) 245)/255};
 const rgb_color_t LINE_COLOR = {.r=((double) 255)/255, .g=((double) 255)/255, .b=((double) 255)/255};
 
 // alternate color scheme (beach mode)
-const rgb_color_t ALT_COURSE_COLOR = {.r=((double) 20)/255, .g=((double) 66)/255, .b=((double) 140)/255};
-const rgb_color_t ALT_WALL_COLOR = {.r=((double) 138)/255, .g=((double) 154)/255, .b=((double) 181)/255};
-const rgb_color_t ALT_HOLE_COLOR = {.r=1, .g=1, .b=1};
-const rgb_color_t ALT_PATCH_COLOR = {.r=((double) 95)/255, .g=((double) 136)/255, .b=((double) 201)/255};
-const rgb_color_t ALT_SLOPE_COLOR = {.r=((double) 95)/255, .g=((double) 136)/255, .b=((double) 100)/255};
-const rgb_color_t ALT_BOUNCY_COLOR = {.r=((double) 40)/255, .g=((double) 136)/255, .b=((double) 150)/255};
-const rgb_color_t ALT_FORCE_COLOR = {.r=0.3, .g=0.8, .b=0.5};
 const rgb_color_t ALT_COIN_COLOR = {.r=0.5, .g=0.5, .b=1};
 const rgb_color_t ALT_FREEZE_PELLET_COLOR = {.r=0.25, .g=0.25, .b=0.75};
 const rgb_color_t ALT_BACKGROUND_COLOR = {.r=((double) 255)/255, .g=((double) 241)/255, .b=((double) 166)/255};
@@ -56,16 +50,10 @@ const double MASS = 0.001;
 const double BUFFER = 10;
 const double NUM_ROWS = 3;
 const double TRANSLATION = 20;
-const int CIRCLE_POINTS = 20;
-const int STAR_POINTS = 5;
 const double SCALE = 1.2;
-const double LAUNCH_FACTOR = 5;
 const vector_t SHIFT = {.x=-20, .y=-20};
 double EPSILON = 0.01;
-double MAX_HOLE_VEL = 1000000;
-double MAX_VEL = 2000000000;
 const int MAX_NUM_WORDS = 100;
-const double OUTER_INNER_RATIO = 2.5;
 
 //a datastructure to keep track of the state of the game and house game variables
 typedef struct game_state{
@@ -92,6 +80,10 @@ typedef struct game_state{
     bool freeze_player_2;
     double freeze_time_1;
     double freeze_time_2;
+    golf_preview_t *preview;
+    bool aiming;
+    vector_t aim_start;
+    vector_t aim_end;
 } game_state_t;
 
 game_state_t *game_state_init(){
@@ -113,6 +105,10 @@ game_state_t *game_state_init(){
     game_state->freeze_player_2 = false;
     game_state->freeze_time_1 = 0;
     game_state->freeze_time_2 = 0;
+    game_state->preview = NULL;
+    game_state->aiming = false;
+    game_state->aim_start = VEC_ZERO;
+    game_state->aim_end = VEC_ZERO;
     return game_state;
 }
 
@@ -130,36 +126,6 @@ coin_data_t *coin_data_init(double amount, scene_t *scene){
     return coin_data;
 }
 
-list_t *draw_circle(vector_t center, size_t size){
-    list_t *circle = list_init(CIRCLE_POINTS, (free_func_t) body_free_vec_list);
-    for (size_t i = 0; i < CIRCLE_POINTS; i++) {
-        vector_t *outer_point = malloc(sizeof(vector_t));
-        assert(outer_point);
-        outer_point->x = center.x + (size * sin(2 * M_PI * i / CIRCLE_POINTS));
-        outer_point->y = center.y - (size * cos(2 * M_PI * i / CIRCLE_POINTS));
-        list_add(circle, outer_point);
-    }
-    return circle;
-}
-
-list_t *draw_star(vector_t center, size_t size) {
-    list_t *star = list_init(2*STAR_POINTS, (free_func_t) body_free_vec_list);
-    //calculates the coordinates of the tip and divot of the star for
-    //each point the star has
-    for (size_t i = 0; i < STAR_POINTS; i++) {
-        vector_t *outer_point = malloc(sizeof(vector_t));
-        outer_point->x = center.x + (size * sin(2 * M_PI * i / STAR_POINTS));
-        outer_point->y = center.y - (size * cos(2 * M_PI * i / STAR_POINTS));
-        list_add(star, outer_point);
-
-        vector_t *inner_point = malloc(sizeof(vector_t));
-        inner_point->x = center.x + ((size / OUTER_INNER_RATIO) * sin((2 * M_PI * i / STAR_POINTS) + (2 * M_PI / (2 *STAR_POINTS))));
-        inner_point->y = center.y - ((size / OUTER_INNER_RATIO) * cos((2 * M_PI * i / STAR_POINTS) + (2 * M_PI / (2 *STAR_POINTS))));
-        list_add(star, inner_point);
-    }
-    return star;
-}
-
 //this is the freeze force for the freeze powerup
 void freeze(body_t *ball, body_t *target, vector_t axis, coin_data_t *data){
     if(strcmp(body_get_info(ball), "golf_ball1") == 0){
@@ -176,8 +142,7 @@ void freeze(body_t *ball, body_t *target, vector_t axis, coin_data_t *data){
 //make as many moves as they want and not count it against their score
 body_t *add_freeze_pellet(scene_t *scene, double pos_x, double pos_y, double amount){
     vector_t center = {.x=pos_x, .y=pos_y};
-    list_t *circle = draw_circle(center, PELLET_SIZE);
-    body_t *freeze_pellet = body_init_with_info(circle, MASS, FREEZE_PELLET_COLOR, "freeze_pellet", free);
+    body_t *freeze_pellet = body_init_circle(center, PELLET_SIZE, CIRCLE_POINTS, MASS, FREEZE_PELLET_COLOR, "freeze_pellet", free);
     scene_add_body(scene, freeze_pellet);
     body_set_color2(freeze_pellet, ALT_FREEZE_PELLET_COLOR);
     coin_data_t *data = coin_data_init(amount, scene);
@@ -204,8 +169,7 @@ void change_count(body_t *ball, body_t *target, vector_t axis, coin_data_t *data
 //adds a coin to a screen, change_count is called when the player collides with the coin
 body_t *add_coin(scene_t *scene, double pos_x, double pos_y, double amount){
     vector_t center = {.x=pos_x, .y=pos_y};
-    list_t *circle = draw_circle(center, PELLET_SIZE);
-    body_t *coin = body_init_with_info(circle, MASS, COIN_COLOR, "coin", free);
+    body_t *coin = body_init_circle(center, PELLET_SIZE, CIRCLE_POINTS, MASS, COIN_COLOR, "coin", free);
     scene_add_body(scene, coin);
     body_set_color2(coin, ALT_COIN_COLOR);
     coin_data_t *data = coin_data_init(amount, scene);
@@ -249,15 +213,10 @@ void on_key(char key, key_event_type_t type, double held_time, void *scene) {
 
 //adds an impulse to the ball when it is hit
 void hit_ball(vector_t imp, scene_t *scene, char *type) {
-    if(vec_dot(imp,imp) > MAX_VEL){
-        imp = vec_multiply((MAX_VEL/vec_dot(imp, imp)), imp);
-    }
     for(size_t i = 0; i < scene_bodies(scene); i++){
         body_t *body = scene_get_body(scene, i);
         if(strcmp(body_get_info(body), type) == 0){
-            vector_t J_n = vec_multiply(LAUNCH_FACTOR * body_get_mass(body), imp);
-            J_n.x = -J_n.x;
-            body_add_impulse(body, J_n);
+            golf_hole_hit(body, imp);
             return;
         }
     }
@@ -305,41 +264,14 @@ void on_scroll(int x, int y, void *scene){
     for(size_t i = 0; i < scene_bodies(scene); i++){
         body_t *body = scene_get_body(scene, i);
         if(strcmp(body_get_info(body), "background") != 0){
-            body_set_centroid(body, vec_add(body_get_centroid(body), diff));
+            body_translate(body, diff);
         }
     }
 }
 
-//gives a rectangle body for the path dependent on two points
+//gives a wall body for the path between two points, with rounded ends so paths join without gaps
 body_t *add_path(vector_t point1, vector_t point2, char *type, rgb_color_t color, double thickness){
-    vector_t center = vec_multiply(0.5, vec_add(point1, point2));
-    vector_t p1_sub = vec_subtract(point1, center);
-    double EPS = 2;
-    point1 = vec_add(point1, vec_multiply(EPS / sqrt(vec_dot(p1_sub, p1_sub)), p1_sub));
-    vector_t p2_sub = vec_subtract(point2, center);
-    point2 = vec_add(point2, vec_multiply(EPS / sqrt(vec_dot(p2_sub, p2_sub)), p2_sub));
-    list_t *wall_points = list_init(10, (free_func_t) body_free_vec_list);
-    vector_t diff = vec_subtract(point1, point2);
-    vector_t unit_diff = vec_multiply(1/sqrt(vec_dot(diff, diff)), diff);
-    vector_t shift = vec_multiply(thickness/2, vec_rotate(unit_diff, M_PI/2));
-    vector_t *p1 = malloc(sizeof(vector_t));
-    p1->x = vec_add(point1, shift).x;
-    p1->y = vec_add(point1, shift).y;
-    list_add(wall_points, p1);
-    vector_t *p2 = malloc(sizeof(vector_t));
-    p2->x = vec_add(point1, vec_negate(shift)).x;
-    p2->y = vec_add(point1, vec_negate(shift)).y;
-    list_add(wall_points, p2);
-    vector_t *p3 = malloc(sizeof(vector_t));
-    p3->x = vec_add(point2, vec_negate(shift)).x;
-    p3->y = vec_add(point2, vec_negate(shift)).y;
-    list_add(wall_points, p3);
-    vector_t *p4 = malloc(sizeof(vector_t));
-    p4->x = vec_add(point2, shift).x;
-    p4->y = vec_add(point2, shift).y;
-    list_add(wall_points, p4);
-    body_t *wall = body_init_with_info(wall_points, INFINITY, color, type, free);
-    return wall;
+    return body_init_capsule(point1, point2, thickness / 2, INFINITY, color, type, free);
 }
 
 //returns the player whose turn it is
@@ -375,59 +307,76 @@ char *get_turn(void *scene){
     }
 }
 
-//Shows the hypothetical path of the ball when a player clicks and creates a stroke
+//remembers where the player is dragging, since the mouse can move several times a frame;
+//the path itself is worked out once a frame by update_hit_path()
 void display_hit_path(vector_t start_pos, vector_t end_pos, void *scene){
-    char* player = "golf_ball1";
-    if(strcmp(get_turn(scene), "player 2") == 0){
-        player = "golf_ball2";
-    }
-    body_t *ball = NULL;
+    ((game_state_t *) scene_get_state(scene))->aiming = true;
+    ((game_state_t *) scene_get_state(scene))->aim_start = start_pos;
+    ((game_state_t *) scene_get_state(scene))->aim_end = end_pos;
+}
+
+//removes the hit path, hiding it until the scene gets around to freeing it
+void remove_hit_path(scene_t *scene){
     for(size_t i = 0; i < scene_bodies(scene); i++){
         body_t *body = scene_get_body(scene, i);
-            if(strcmp(body_get_info(body), player) == 0){
-                ball = body;
-                start_pos = body_get_centroid(body);
-                break;
-            }
-    }
-    //only displays the path if the balls have no speed
-    if(ball != NULL && vec_dot(body_get_velocity(ball), body_get_velocity(ball)) < EPSILON && !((game_state_t *) scene_get_state(scene))->is_over){
-        vector_t sub = vec_subtract(end_pos, start_pos);
-        sub.y = -sub.y;
-        vector_t diff = vec_subtract(start_pos, sub);
-        body_t *hit_path = add_path(start_pos, diff, "launch_line", LINE_COLOR, 2);
-        body_set_color2(hit_path, ALT_LINE_COLOR);
-        scene_add_body(scene, hit_path);
+        if(!body_is_removed(body) && strcmp(body_get_info(body), "launch_line") == 0){
+            body_hide(body);
+            body_remove(body);
+        }
     }
 }
 
-//removes the hit path in conjunction with SDL when mouse button is released
+//stops showing the hit path in conjunction with SDL when mouse button is released
 void on_mouse_button_up(vector_t start_pos, vector_t end_pos, void *scene){
-    for(size_t i = 0; i < scene_bodies(scene); i++){
-        body_t *body = scene_get_body(scene, i);
-            if(strcmp(body_get_info(body), "launch_line") == 0){
-                body_remove(body);
-            }
-    }
+    ((game_state_t *) scene_get_state(scene))->aiming = false;
+    remove_hit_path(scene);
 }
 
-//removes hit path and allows the hit path to update
-void delete_hit_path(scene_t *scene){
-    int count = 0;
+//Shows the path the ball would take if the player let go of the mouse now,
+//by playing the stroke out on the preview of the hole
+void update_hit_path(scene_t *scene){
+    remove_hit_path(scene);
+    if(!((game_state_t *) scene_get_state(scene))->aiming || ((game_state_t *) scene_get_state(scene))->is_over){
+        return;
+    }
+    char* player = "golf_ball1";
+    size_t number = 1;
+    if(strcmp(get_turn(scene), "player 2") == 0){
+        player = "golf_ball2";
+        number = 2;
+    }
+    body_t *ball = NULL;
+    body_t *hole = NULL;
     for(size_t i = 0; i < scene_bodies(scene); i++){
         body_t *body = scene_get_body(scene, i);
-        if(strcmp(body_get_info(body), "launch_line") == 0){
-            count++;
+        if(strcmp(body_get_info(body), player) == 0){
+            ball = body;
+        }
+        if(strcmp(body_get_info(body), "hole") == 0){
+            hole = body;
         }
     }
-    if(count > 1){
-        for(size_t i = 0; i < scene_bodies(scene); i++){
-            body_t *body = scene_get_body(scene, i);
-            if(strcmp(body_get_info(body), "launch_line") == 0){
-                body_remove(body);
-                return;
-            }
+    //only displays the path if the balls have no speed
+    if(ball == NULL || hole == NULL || vec_dot(body_get_velocity(ball), body_get_velocity(ball)) >= EPSILON){
+        return;
+    }
+    vector_t drag = vec_subtract(((game_state_t *) scene_get_state(scene))->aim_end, ((game_state_t *) scene_get_state(scene))->aim_start);
+    size_t n;
+    const vector_t *path = golf_preview_predict(
+        ((game_state_t *) scene_get_state(scene))->preview,
+        number,
+        body_get_centroid(ball),
+        body_get_centroid(hole),
+        drag,
+        &n
+    );
+    for(size_t i = 1; i < n; i++){
+        body_t *hit_path = add_path(path[i - 1], path[i], "launch_line", LINE_COLOR, 2);
+        body_set_color2(hit_path, ALT_LINE_COLOR);
+        if(((game_state_t *) scene_get_state(scene))->night_mode){
+            body_swap_color(hit_path);
         }
+        scene_add_body(scene, hit_path);
     }
 }
 
@@ -457,7 +406,7 @@ void automatic_scroll(void *scene){
     for(size_t i = 0; i < scene_bodies(scene); i++){
         body_t *body = scene_get_body(scene, i);
         if(strcmp(body_get_info(body), "background") != 0){
-            body_set_centroid(body, vec_add(body_get_centroid(body), diff));
+            body_translate(body, diff);
         }
     }
 }
@@ -485,24 +434,24 @@ void play_sound(body_t *ball, body_t *target, vector_t axis, scene_t *scene){
 }
 
 //sorts the scores in ascending order since smaller scores are better
-void double_sort(list_t *doubles) {
-    for(size_t i = 0; i < list_size(doubles); i++){
+void double_sort(score_list_t *doubles) {
+    for(size_t i = 0; i < score_list_size(doubles); i++){
         size_t idx = i;
-        for(size_t j = i + 1; j < list_size(doubles); j++){
-            if(*((double *)list_get(doubles, idx)) > *((double *)list_get(doubles, j))){
+        for(size_t j = i + 1; j < score_list_size(doubles); j++){
+            if(score_list_get(doubles, idx) > score_list_get(doubles, j)){
                 idx = j;
             }
         }
-        double *temp = list_get(doubles, i);
-        list_set(doubles, i, list_get(doubles, idx));
-        list_set(doubles, idx, temp);
+        double temp = score_list_get(doubles, i);
+        score_list_set(doubles, i, score_list_get(doubles, idx));
+        score_list_set(doubles, idx, temp);
     }
 }
 
 //gets the leaderboard scores from the text file
-list_t *get_scores(){
+score_list_t *get_scores(){
     FILE *file = fopen("static/data/leaderboard.txt", "r");
-    list_t *scores = list_init(POINTS, (free_func_t)body_free_vec_list);
+    score_list_t *scores = score_list_init(POINTS);
     char *result = malloc(sizeof(char));
     char *word = malloc((sizeof(char)) * (MAX_NUM_WORDS + 1));
     int idx = 0;
@@ -514,9 +463,7 @@ list_t *get_scores(){
         //new line character signifies end of word
         if (result[0] == '\n') {
             word[idx-1] = '\0';
-            double *result = malloc(sizeof(double));
-            *result = strtod(word, &temp);
-            list_add(scores, result);
+            score_list_add(scores, strtod(word, &temp));
             idx = 0;
         }
     }
@@ -537,9 +484,55 @@ void record_scores(scene_t *scene){
     fclose(file);
 }
 
+//adds the background and the hole to the scene, with a sound whenever a ball hits something on it
+golf_hole_t *init_hole(scene_t *scene, size_t number, collision_handler_t in_hole){
+    ((game_state_t *) scene_get_state(scene))->night_mode = false;
+    list_t *background_points = list_init(POINTS, (free_func_t) body_free_vec_list);
+    vector_t *bp1 = malloc(sizeof(vector_t));
+    bp1->x = 0;
+    bp1->y = 0;
+    list_add(background_points, bp1);
+    vector_t *bp2 = malloc(sizeof(vector_t));
+    bp2->x = 0;
+    bp2->y = MAX_CANVAS_SIZE.y;
+    list_add(background_points, bp2);
+    vector_t *bp3 = malloc(sizeof(vector_t));
+    bp3->x = MAX_CANVAS_SIZE.x;
+    bp3->y = MAX_CANVAS_SIZE.y;
+    list_add(background_points, bp3);
+    vector_t *bp4 = malloc(sizeof(vector_t));
+    bp4->x = MAX_CANVAS_SIZE.x;
+    bp4->y = 0;
+    list_add(background_points, bp4);
+    body_t *background = body_init_with_info(background_points, INFINITY, BACKGROUND_COLOR, "background", free);
+    scene_add_body(scene, background);
+    body_set_color2(background, ALT_BACKGROUND_COLOR);
+
+    golf_hole_t *hole = golf_hole_init(scene, number);
+    if(((game_state_t *) scene_get_state(scene))->preview != NULL){
+        golf_preview_free(((game_state_t *) scene_get_state(scene))->preview);
+    }
+    ((game_state_t *) scene_get_state(scene))->preview = golf_preview_init(number);
+    for(size_t player = 1; player <= GOLF_HOLE_PLAYERS; player++){
+        body_t *ball = golf_hole_get_ball(hole, player);
+        create_collision(scene, ball, golf_hole_get_cup(hole), in_hole, scene, NULL);
+        for(size_t i = 0; i < golf_hole_obstacles(hole); i++){
+            create_collision(scene, ball, golf_hole_get_obstacle(hole, i), (collision_handler_t) play_sound, scene, NULL);
+        }
+    }
+    return hole;
+}
+
+//plays a sound when either ball hits a coin or pellet
+void add_pickup_sound(scene_t *scene, golf_hole_t *hole, body_t *pickup){
+    for(size_t player = 1; player <= GOLF_HOLE_PLAYERS; player++){
+        create_collision(scene, golf_hole_get_ball(hole, player), pickup, (collision_handler_t) play_sound, scene, NULL);
+    }
+}
+
 void ball_in_hole3(body_t *ball, body_t *target, vector_t axis, scene_t *scene){
-    //ball only "goes in the hole" if its velocity is below the max velocity
-    if(vec_dot(body_get_velocity(ball), body_get_velocity(ball)) < MAX_HOLE_VEL){
+    //ball only "goes in the hole" if it is slow enough
+    if(golf_hole_sinks(ball)){
         body_set_velocity(ball, VEC_ZERO);
         if(strcmp(body_get_info(ball), "golf_ball2") == 0){
             ((game_state_t *) scene_get_state(scene))->player2_done = true;
@@ -584,369 +577,20 @@ void ball_in_hole3(body_t *ball, body_t *target, vector_t axis, scene_t *scene){
 
 void init_course_3(scene_t *scene){
     Mix_PlayMusic(((game_state_t *)scene_get_state(scene))->hole3, -1);
-    ((game_state_t *) scene_get_state(scene))->night_mode = false;
-    list_t *background_points = list_init(POINTS, (free_func_t) body_free_vec_list);
-    vector_t *bp1 = malloc(sizeof(vector_t));
-    bp1->x = 0;
-    bp1->y = 0;
-    list_add(background_points, bp1);
-    vector_t *bp2 = malloc(sizeof(vector_t));
-    bp2->x = 0;
-    bp2->y = MAX_CANVAS_SIZE.y;
-    list_add(background_points, bp2);
-    vector_t *bp3 = malloc(sizeof(vector_t));
-    bp3->x = MAX_CANVAS_SIZE.x;
-    bp3->y = MAX_CANVAS_SIZE.y;
-    list_add(background_points, bp3);
-    vector_t *bp4 = malloc(sizeof(vector_t));
-    bp4->x = MAX_CANVAS_SIZE.x;
-    bp4->y = 0;
-    list_add(background_points, bp4);
-    body_t *background = body_init_with_info(background_points, INFINITY, BACKGROUND_COLOR, "background", free);
-    scene_add_body(scene, background);
-    body_set_color2(background, ALT_BACKGROUND_COLOR);
-
-    list_t *course_points = list_init(POINTS, (free_func_t) body_free_vec_list);
-    vector_t *p1 = malloc(sizeof(vector_t));
-    p1->x = 1 * SCALE;
-    p1->y = MAX_CANVAS_SIZE.y * 3/13 * SCALE;
-    list_add(course_points, p1);
-    vector_t *p2 = malloc(sizeof(vector_t));
-    p2->x = MAX_CANVAS_SIZE.x * 3/27 * SCALE;
-    p2->y = MAX_CANVAS_SIZE.y * 3/13 * SCALE;
-    list_add(course_points, p2);
-    vector_t *p3 = malloc(sizeof(vector_t));
-    p3->x = MAX_CANVAS_SIZE.x * 3/27 * SCALE;
-    p3->y = MAX_CANVAS_SIZE.y * 5/13 * SCALE;
-    list_add(course_points, p3);
-    vector_t *p4 = malloc(sizeof(vector_t));
-    p4->x = MAX_CANVAS_SIZE.x * 2/27 * SCALE;
-    p4->y = MAX_CANVAS_SIZE.y * 5/13 * SCALE;
-    list_add(course_points, p4);
-    vector_t *p5 = malloc(sizeof(vector_t));
-    p5->x = MAX_CANVAS_SIZE.x * 2/27 * SCALE;
-    p5->y = MAX_CANVAS_SIZE.y * 8/13 * SCALE;
-    list_add(course_points, p5);
-    vector_t *p6 = malloc(sizeof(vector_t));
-    p6->x = MAX_CANVAS_SIZE.x * 5/27 * SCALE;
-    p6->y = MAX_CANVAS_SIZE.y * 8/13 * SCALE;
-    list_add(course_points, p6);
-    vector_t *p7 = malloc(sizeof(vector_t));
-    p7->x = MAX_CANVAS_SIZE.x * 5/27 * SCALE;
-    p7->y = MAX_CANVAS_SIZE.y * 10/13 * SCALE;
-    list_add(course_points, p7);
-    vector_t *p8 = malloc(sizeof(vector_t));
-    p8->x = MAX_CANVAS_SIZE.x * 7/27 * SCALE;
-    p8->y = MAX_CANVAS_SIZE.y * 10/13 * SCALE;
-    list_add(course_points, p8);
-    vector_t *p9 = malloc(sizeof(vector_t));
-    p9->x = MAX_CANVAS_SIZE.x * 7/27 * SCALE;
-    p9->y = MAX_CANVAS_SIZE.y * 7/13 * SCALE;
-    list_add(course_points, p9);
-    vector_t *p10 = malloc(sizeof(vector_t));
-    p10->x = MAX_CANVAS_SIZE.x * 5/27 * SCALE;
-    p10->y = MAX_CANVAS_SIZE.y * 7/13 * SCALE;
-    list_add(course_points, p10);
-    vector_t *p11 = malloc(sizeof(vector_t));
-    p11->x = MAX_CANVAS_SIZE.x * 5/27 * SCALE;
-    p11->y = 1;
-    list_add(course_points, p11);
-    vector_t *p12 = malloc(sizeof(vector_t));
-    p12->x = MAX_CANVAS_SIZE.x * 16/27 * SCALE;
-    p12->y = 1;
-    list_add(course_points, p12);
-    vector_t *p13 = malloc(sizeof(vector_t));
-    p13->x = MAX_CANVAS_SIZE.x * 16/27 * SCALE;
-    p13->y = MAX_CANVAS_SIZE.y * 5/13 * SCALE;
-    list_add(course_points, p13);
-    vector_t *p14 = malloc(sizeof(vector_t));
-    p14->x = MAX_CANVAS_SIZE.x * 21/27 * SCALE;
-    p14->y = MAX_CANVAS_SIZE.y * 5/13 * SCALE;
-    list_add(course_points, p14);
-    vector_t *p15 = malloc(sizeof(vector_t));
-    p15->x = MAX_CANVAS_SIZE.x * 21/27 * SCALE;
-    p15->y = MAX_CANVAS_SIZE.y * 7/13 * SCALE;
-    list_add(course_points, p15);
-    vector_t *p16 = malloc(sizeof(vector_t));
-    p16->x = MAX_CANVAS_SIZE.x * SCALE;
-    p16->y = MAX_CANVAS_SIZE.y * 7/13 * SCALE;
-    list_add(course_points, p16);
-    vector_t *p17 = malloc(sizeof(vector_t));
-    p17->x = MAX_CANVAS_SIZE.x * SCALE;
-    p17->y = MAX_CANVAS_SIZE.y * 9/13 * SCALE;
-    list_add(course_points, p17);
-    vector_t *p18 = malloc(sizeof(vector_t));
-    p18->x = MAX_CANVAS_SIZE.x * 25/27 * SCALE;
-    p18->y = MAX_CANVAS_SIZE.y * 9/13 * SCALE;
-    list_add(course_points, p18);
-    vector_t *p19 = malloc(sizeof(vector_t));
-    p19->x = MAX_CANVAS_SIZE.x * 25/27 * SCALE;
-    p19->y = MAX_CANVAS_SIZE.y * 10/13 * SCALE;
-    list_add(course_points, p19);
-    vector_t *p20 = malloc(sizeof(vector_t));
-    p20->x = MAX_CANVAS_SIZE.x * 26/27 * SCALE;
-    p20->y = MAX_CANVAS_SIZE.y * 10/13 * SCALE;
-    list_add(course_points, p20);
-    vector_t *p21 = malloc(sizeof(vector_t));
-    p21->x = MAX_CANVAS_SIZE.x * 26/27 * SCALE;
-    p21->y = MAX_CANVAS_SIZE.y * 11/13 * SCALE;
-    list_add(course_points, p21);
-    vector_t *p22 = malloc(sizeof(vector_t));
-    p22->x = MAX_CANVAS_SIZE.x * 25/27 * SCALE;
-    p22->y = MAX_CANVAS_SIZE.y * 11/13 * SCALE;
-    list_add(course_points, p22);
-    vector_t *p23 = malloc(sizeof(vector_t));
-    p23->x = MAX_CANVAS_SIZE.x * 25/27 * SCALE;
-    p23->y = MAX_CANVAS_SIZE.y * 12/13 * SCALE;
-    list_add(course_points, p23);
-    vector_t *p24 = malloc(sizeof(vector_t));
-    p24->x = MAX_CANVAS_SIZE.x * 26/27 * SCALE;
-    p24->y = MAX_CANVAS_SIZE.y * 12/13 * SCALE;
-    list_add(course_points, p24);
-    vector_t *p25 = malloc(sizeof(vector_t));
-    p25->x = MAX_CANVAS_SIZE.x * 26/27 * SCALE;
-    p25->y = MAX_CANVAS_SIZE.y * SCALE;
-    list_add(course_points, p25);
-    vector_t *p26 = malloc(sizeof(vector_t));
-    p26->x = MAX_CANVAS_SIZE.x * 24/27 * SCALE;
-    p26->y = MAX_CANVAS_SIZE.y * SCALE;
-    list_add(course_points, p26);
-    vector_t *p27 = malloc(sizeof(vector_t));
-    p27->x = MAX_CANVAS_SIZE.x * 24/27 * SCALE;
-    p27->y = MAX_CANVAS_SIZE.y * 9/13 * SCALE;
-    list_add(course_points, p27);
-    vector_t *p28 = malloc(sizeof(vector_t));
-    p28->x = MAX_CANVAS_SIZE.x * 22/27 * SCALE;
-    p28->y = MAX_CANVAS_SIZE.y * 9/13 * SCALE;
-    list_add(course_points, p28);
-    vector_t *p29 = malloc(sizeof(vector_t));
-    p29->x = MAX_CANVAS_SIZE.x * 22/27 * SCALE;
-    p29->y = MAX_CANVAS_SIZE.y * 10/13 * SCALE;
-    list_add(course_points, p29);
-    vector_t *p30 = malloc(sizeof(vector_t));
-    p30->x = MAX_CANVAS_SIZE.x * 23/27 * SCALE;
-    p30->y = MAX_CANVAS_SIZE.y * 10/13 * SCALE;
-    list_add(course_points, p30);
-    vector_t *p31 = malloc(sizeof(vector_t));
-    p31->x = MAX_CANVAS_SIZE.x * 23/27 * SCALE;
-    p31->y = MAX_CANVAS_SIZE.y * 11/13 * SCALE;
-    list_add(course_points, p31);
-    vector_t *p32 = malloc(sizeof(vector_t));
-    p32->x = MAX_CANVAS_SIZE.x * 22/27 * SCALE;
-    p32->y = MAX_CANVAS_SIZE.y * 11/13 * SCALE;
-    list_add(course_points, p32);
-    vector_t *p33 = malloc(sizeof(vector_t));
-    p33->x = MAX_CANVAS_SIZE.x * 22/27 * SCALE;
-    p33->y = MAX_CANVAS_SIZE.y * 12/13 * SCALE;
-    list_add(course_points, p33);
-    vector_t *p34 = malloc(sizeof(vector_t));
-    p34->x = MAX_CANVAS_SIZE.x * 23/27 * SCALE;
-    p34->y = MAX_CANVAS_SIZE.y * 12/13 * SCALE;
-    list_add(course_points, p34);
-    vector_t *p35 = malloc(sizeof(vector_t));
-    p35->x = MAX_CANVAS_SIZE.x * 23/27 * SCALE;
-    p35->y = MAX_CANVAS_SIZE.y * SCALE;
-    list_add(course_points, p35);
-    vector_t *p36 = malloc(sizeof(vector_t));
-    p36->x = MAX_CANVAS_SIZE.x * 21/27 * SCALE;
-    p36->y = MAX_CANVAS_SIZE.y * 1 * SCALE;
-    list_add(course_points, p36);
-    vector_t *p37 = malloc(sizeof(vector_t));
-    p37->x = MAX_CANVAS_SIZE.x * 21/27 * SCALE;
-    p37->y = MAX_CANVAS_SIZE.y * 9/13 * SCALE;
-    list_add(course_points, p37);
-    vector_t *p38 = malloc(sizeof(vector_t));
-    p38->x = MAX_CANVAS_SIZE.x * 18/27 * SCALE;
-    p38->y = MAX_CANVAS_SIZE.y * 9/13 * SCALE;
-    list_add(course_points, p38);
-    vector_t *p39 = malloc(sizeof(vector_t));
-    p39->x = MAX_CANVAS_SIZE.x * 18/27 * SCALE;
-    p39->y = MAX_CANVAS_SIZE.y * 7/13 * SCALE;
-    list_add(course_points, p39);
-    vector_t *p40 = malloc(sizeof(vector_t));
-    p40->x = MAX_CANVAS_SIZE.x * 14/27 * SCALE;
-    p40->y = MAX_CANVAS_SIZE.y * 7/13 * SCALE;
-    list_add(course_points, p40);
-    vector_t *p41 = malloc(sizeof(vector_t));
-    p41->x = MAX_CANVAS_SIZE.x * 14/27 * SCALE;
-    p41->y = MAX_CANVAS_SIZE.y * 5/13 * SCALE;
-    list_add(course_points, p41);
-    vector_t *p42 = malloc(sizeof(vector_t));
-    p42->x = MAX_CANVAS_SIZE.x * 7/27 * SCALE;
-    p42->y = MAX_CANVAS_SIZE.y * 5/13 * SCALE;
-    list_add(course_points, p42);
-    vector_t *p43 = malloc(sizeof(vector_t));
-    p43->x = MAX_CANVAS_SIZE.x * 7/27 * SCALE;
-    p43->y = MAX_CANVAS_SIZE.y * 6/13 * SCALE;
-    list_add(course_points, p43);
-    vector_t *p44 = malloc(sizeof(vector_t));
-    p44->x = MAX_CANVAS_SIZE.x * 8/27 * SCALE;
-    p44->y = MAX_CANVAS_SIZE.y * 6/13 * SCALE;
-    list_add(course_points, p44);
-    vector_t *p45 = malloc(sizeof(vector_t));
-    p45->x = MAX_CANVAS_SIZE.x * 8/27 * SCALE;
-    p45->y = MAX_CANVAS_SIZE.y * 11/13 * SCALE;
-    list_add(course_points, p45);
-    vector_t *p46 = malloc(sizeof(vector_t));
-    p46->x = MAX_CANVAS_SIZE.x * 4/27 * SCALE;
-    p46->y = MAX_CANVAS_SIZE.y * 11/13 * SCALE;
-    list_add(course_points, p46);
-    vector_t *p47 = malloc(sizeof(vector_t));
-    p47->x = MAX_CANVAS_SIZE.x * 4/27 * SCALE;
-    p47->y = MAX_CANVAS_SIZE.y * 9/13 * SCALE;
-    list_add(course_points, p47);
-    vector_t *p48 = malloc(sizeof(vector_t));
-    p48->x = MAX_CANVAS_SIZE.x * 1/27 * SCALE;
-    p48->y = MAX_CANVAS_SIZE.y * 9/13 * SCALE;
-    list_add(course_points, p48);
-    vector_t *p49 = malloc(sizeof(vector_t));
-    p49->x = MAX_CANVAS_SIZE.x * 1/27 * SCALE;
-    p49->y = MAX_CANVAS_SIZE.y * 5/13 * SCALE;
-    list_add(course_points, p49);
-    vector_t *p50 = malloc(sizeof(vector_t));
-    p50->x = 1;
-    p50->y = MAX_CANVAS_SIZE.y * 5/13 * SCALE;
-    list_add(course_points, p50);
-
-    body_t *course = body_init_with_info(course_points, INFINITY, COURSE_COLOR, "course", free);
-    scene_add_body(scene, course);
-    body_set_color2(course, ALT_COURSE_COLOR);
-
-    list_t *patch1_points = list_init(POINTS, (free_func_t) body_free_vec_list);
-    vector_t *patch11 = malloc(sizeof(vector_t));
-    patch11->x = MAX_CANVAS_SIZE.x * 6/27 * SCALE;
-    patch11->y = MAX_CANVAS_SIZE.y * 1/13 * SCALE;
-    list_add(patch1_points, patch11);
-    vector_t *patch12 = malloc(sizeof(vector_t));
-    patch12->x = MAX_CANVAS_SIZE.x * 6/27 * SCALE;
-    patch12->y = MAX_CANVAS_SIZE.y * 2/13 * SCALE;
-    list_add(patch1_points, patch12);
-    vector_t *patch13 = malloc(sizeof(vector_t));
-    patch13->x = MAX_CANVAS_SIZE.x * 8/27 * SCALE;
-    patch13->y = MAX_CANVAS_SIZE.y * 2/13 * SCALE;
-    list_add(patch1_points, patch13);
-    vector_t *patch14 = malloc(sizeof(vector_t));
-    patch14->x = MAX_CANVAS_SIZE.x * 8/27 * SCALE;
-    patch14->y = MAX_CANVAS_SIZE.y * 1/13 * SCALE;
-    list_add(patch1_points, patch14);
-    body_t *patch1 = body_init_with_info(patch1_points, INFINITY, PATCH_COLOR, "patch", free);
-    scene_add_body(scene, patch1);
-    body_set_color2(patch1, ALT_PATCH_COLOR);
+    golf_hole_t *hole = init_hole(scene, 3, (collision_handler_t) ball_in_hole3);
 
-    list_t *patch2_points = list_init(POINTS, (free_func_t) body_free_vec_list);
-    vector_t *patch21 = malloc(sizeof(vector_t));
-    patch21->x = MAX_CANVAS_SIZE.x * 12/27 * SCALE;
-    patch21->y = MAX_CANVAS_SIZE.y * 3/13 * SCALE;
-    list_add(patch2_points, patch21);
-    vector_t *patch22 = malloc(sizeof(vector_t));
-    patch22->x = MAX_CANVAS_SIZE.x * 12/27 * SCALE;
-    patch22->y = MAX_CANVAS_SIZE.y * 4/13 * SCALE;
-    list_add(patch2_points, patch22);
-    vector_t *patch23 = malloc(sizeof(vector_t));
-    patch23->x = MAX_CANVAS_SIZE.x * 13/27 * SCALE;
-    patch23->y = MAX_CANVAS_SIZE.y * 4/13 * SCALE;
-    list_add(patch2_points, patch23);
-    vector_t *patch24 = malloc(sizeof(vector_t));
-    patch24->x = MAX_CANVAS_SIZE.x * 13/27 * SCALE;
-    patch24->y = MAX_CANVAS_SIZE.y * 3/13 * SCALE;
-    list_add(patch2_points, patch24);
-    body_t *patch2 = body_init_with_info(patch2_points, INFINITY, PATCH_COLOR, "patch", free);
-    scene_add_body(scene, patch2);
-    body_set_color2(patch2, ALT_PATCH_COLOR);
-
-    list_t *patch3_points = list_init(POINTS, (free_func_t) body_free_vec_list);
-    vector_t *patch31 = malloc(sizeof(vector_t));
-    patch31->x = MAX_CANVAS_SIZE.x * 19/27 * SCALE;
-    patch31->y = MAX_CANVAS_SIZE.y * 5/13 * SCALE;
-    list_add(patch3_points, patch31);
-    vector_t *patch32 = malloc(sizeof(vector_t));
-    patch32->x = MAX_CANVAS_SIZE.x * 19/27 * SCALE;
-    patch32->y = MAX_CANVAS_SIZE.y * 7/13 * SCALE;
-    list_add(patch3_points, patch32);
-    vector_t *patch33 = malloc(sizeof(vector_t));
-    patch33->x = MAX_CANVAS_SIZE.x * 21/27 * SCALE;
-    patch33->y = MAX_CANVAS_SIZE.y * 7/13 * SCALE;
-    list_add(patch3_points, patch33);
-    vector_t *patch34 = malloc(sizeof(vector_t));
-    patch34->x = MAX_CANVAS_SIZE.x * 21/27 * SCALE;
-    patch34->y = MAX_CANVAS_SIZE.y * 5/13 * SCALE;
-    list_add(patch3_points, patch34);
-    body_t *patch3 = body_init_with_info(patch3_points, INFINITY, PATCH_COLOR, "patch", free);
-    scene_add_body(scene, patch3);
-    body_set_color2(patch3, ALT_PATCH_COLOR);
-
-    double hole_pos_x = MAX_CANVAS_SIZE.x * 25.5/27 * SCALE;
-    double hole_pos_y = MAX_CANVAS_SIZE.y * 10.5/13 * SCALE;
-
-    vector_t center = {.x=hole_pos_x, .y=hole_pos_y};
-    list_t *circle = draw_circle(center, HOLE_SIZE * SCALE);
-    body_t *hole = body_init_with_info(circle, INFINITY, HOLE_COLOR, "hole", free);
-    scene_add_body(scene, hole);
-    body_set_color2(hole, ALT_HOLE_COLOR);
-
-    list_t *circle_big = draw_circle(center, HOLE_SIZE * 2 * SCALE);
-    body_t *hole_real = body_init_with_info(circle_big, INFINITY, HOLE_COLOR, "hole_real", free);
-    scene_add_body(scene, hole_real);
-    body_set_color2(hole_real, ALT_HOLE_COLOR);
-
-    vector_t start_pos_ball1 = {.x=MAX_CANVAS_SIZE.x * 1/27 * SCALE, .y=MAX_CANVAS_SIZE.y * 3.5/13 * SCALE};
-    list_t *circle1 = draw_circle(start_pos_ball1, HOLE_SIZE * SCALE);
-    body_t *ball1 = body_init_with_info(circle1, MASS, BALL1_COLOR, "golf_ball1", free);
-    create_collision(scene, ball1, hole, (collision_handler_t) ball_in_hole3, scene, NULL);
-
-    vector_t start_pos_ball2 = {.x=MAX_CANVAS_SIZE.x * 2/27 * SCALE, .y=MAX_CANVAS_SIZE.y * 3.5/13 * SCALE};
-    list_t *circle2 = draw_circle(start_pos_ball2, HOLE_SIZE * SCALE);
-    body_t *ball2 = body_init_with_info(circle2, MASS, BALL2_COLOR, "golf_ball2", free);
-    create_collision(scene, ball2, hole, (collision_handler_t) ball_in_hole3, scene, NULL);
-    
     body_t *coin1 = add_coin(scene, MAX_CANVAS_SIZE.x * 22.5/27 * SCALE, MAX_CANVAS_SIZE.y * 10.5/13 * SCALE, -0.4);
-    create_collision(scene, ball1, coin1, (collision_handler_t) play_sound, scene, NULL);
-    create_collision(scene, ball2, coin1, (collision_handler_t) play_sound, scene, NULL);
-
     body_t *coin2 = add_coin(scene, MAX_CANVAS_SIZE.x * 22.5/27 * SCALE, MAX_CANVAS_SIZE.y * 12.5/13 * SCALE, 0.3);
-    create_collision(scene, ball1, coin2, (collision_handler_t) play_sound, scene, NULL);
-    create_collision(scene, ball2, coin2, (collision_handler_t) play_sound, scene, NULL);
-
     body_t *freeze_pellet_1 = add_freeze_pellet(scene, MAX_CANVAS_SIZE.x * 4/7 * SCALE, MAX_CANVAS_SIZE.y * 0.2/5 * SCALE, 20);
-    create_collision(scene, ball1, freeze_pellet_1, (collision_handler_t) play_sound, scene, NULL);
-    create_collision(scene, ball2, freeze_pellet_1, (collision_handler_t) play_sound, scene, NULL);
-    
-    golf_course_t *golf_course = golf_course_init(course, hole, start_pos_ball1, start_pos_ball2, WALL_COLOR);
-    golf_course_add_walls(golf_course);
-    for(size_t i = 0; i < list_size(golf_course_get_walls(golf_course)); i++){
-        body_t *wall = list_get(golf_course_get_walls(golf_course), i);
-        scene_add_body(scene, wall);
-        body_set_color2(wall, ALT_WALL_COLOR);
-        create_physics_collision(scene, 0.3, ball1, wall);
-        create_physics_collision(scene, 0.3, ball2, wall);
-        create_collision(scene, ball1, wall, (collision_handler_t) play_sound, scene, NULL);
-        create_collision(scene, ball2, wall, (collision_handler_t) play_sound, scene, NULL);
-    }
-    create_friction(scene, 100, ball1, course);
-    create_friction(scene, 100, ball2, course);
-    create_friction(scene, 300, ball1, patch1);
-    create_friction(scene, 300, ball2, patch1);
-    create_friction(scene, 250, ball1, patch2);
-    create_friction(scene, 250, ball2, patch2);
-    create_friction(scene, 180, ball1, patch3);
-    create_friction(scene, 180, ball2, patch3);
-    scene_add_body(scene, ball1);
-    scene_add_body(scene, ball2);
-
-    create_collision(scene, ball1, hole, (collision_handler_t) play_sound, scene, NULL);
-    create_collision(scene, ball2, hole, (collision_handler_t) play_sound, scene, NULL);
-
-    create_collision(scene, ball1, patch1, (collision_handler_t) play_sound, scene, NULL);
-    create_collision(scene, ball2, patch1, (collision_handler_t) play_sound, scene, NULL);
-    create_collision(scene, ball1, patch2, (collision_handler_t) play_sound, scene, NULL);
-    create_collision(scene, ball2, patch2, (collision_handler_t) play_sound, scene, NULL);
-    create_collision(scene, ball1, patch3, (collision_handler_t) play_sound, scene, NULL);
-    create_collision(scene, ball2, patch3, (collision_handler_t) play_sound, scene, NULL);
+    add_pickup_sound(scene, hole, coin1);
+    add_pickup_sound(scene, hole, coin2);
+    add_pickup_sound(scene, hole, freeze_pellet_1);
+    golf_hole_free(hole);
 }
 
 void ball_in_hole2(body_t *ball, body_t *target, vector_t axis, scene_t *scene){
-    //ball only "goes in the hole" if its velocity is below the max velocity
-    if(vec_dot(body_get_velocity(ball), body_get_velocity(ball)) < MAX_HOLE_VEL){
+    //ball only "goes in the hole" if it is slow enough
+    if(golf_hole_sinks(ball)){
         body_set_velocity(ball, VEC_ZERO);
         if(strcmp(body_get_info(ball), "golf_ball2") == 0){
             ((game_state_t *) scene_get_state(scene))->player2_done = true;
@@ -968,192 +612,20 @@ void ball_in_hole2(body_t *ball, body_t *target, vector_t axis, scene_t *scene){
 
 void init_course_2(scene_t *scene){
     Mix_PlayMusic(((game_state_t *)scene_get_state(scene))->hole2, -1);
-    ((game_state_t *) scene_get_state(scene))->night_mode = false;
-    list_t *background_points = list_init(POINTS, (free_func_t) body_free_vec_list);
-    vector_t *bp1 = malloc(sizeof(vector_t));
-    bp1->x = 0;
-    bp1->y = 0;
-    list_add(background_points, bp1);
-    vector_t *bp2 = malloc(sizeof(vector_t));
-    bp2->x = 0;
-    bp2->y = MAX_CANVAS_SIZE.y;
-    list_add(background_points, bp2);
-    vector_t *bp3 = malloc(sizeof(vector_t));
-    bp3->x = MAX_CANVAS_SIZE.x;
-    bp3->y = MAX_CANVAS_SIZE.y;
-    list_add(background_points, bp3);
-    vector_t *bp4 = malloc(sizeof(vector_t));
-    bp4->x = MAX_CANVAS_SIZE.x;
-    bp4->y = 0;
-    list_add(background_points, bp4);
-    body_t *background = body_init_with_info(background_points, INFINITY, BACKGROUND_COLOR, "background", free);
-    scene_add_body(scene, background);
-    body_set_color2(background, ALT_BACKGROUND_COLOR);
-
-    list_t *course_points = list_init(POINTS, (free_func_t) body_free_vec_list);
-    vector_t *p1 = malloc(sizeof(vector_t));
-    p1->x = 1 * SCALE;
-    p1->y = 1 * SCALE;
-    list_add(course_points, p1);
-    vector_t *p2 = malloc(sizeof(vector_t));
-    p2->x = 1 * SCALE;
-    p2->y = MAX_CANVAS_SIZE.y * 2/5 * SCALE;
-    list_add(course_points, p2);
-    vector_t *p3 = malloc(sizeof(vector_t));
-    p3->x = MAX_CANVAS_SIZE.x * 2/7 * SCALE;
-    p3->y = MAX_CANVAS_SIZE.y * 2/5 * SCALE;
-    list_add(course_points, p3);
-    vector_t *p4 = malloc(sizeof(vector_t));
-    p4->x = MAX_CANVAS_SIZE.x * 2/7 * SCALE;
-    p4->y = MAX_CANVAS_SIZE.y* 1 * SCALE;
-    list_add(course_points, p4);
-    vector_t *p5 = malloc(sizeof(vector_t));
-    p5->x = MAX_CANVAS_SIZE.x * 5/7 * SCALE;
-    p5->y = MAX_CANVAS_SIZE.y * 1 * SCALE;
-    list_add(course_points, p5);
-    vector_t *p6 = malloc(sizeof(vector_t));
-    p6->x = MAX_CANVAS_SIZE.x * 5/7 * SCALE;
-    p6->y = MAX_CANVAS_SIZE.y * 3/6 * SCALE;
-    list_add(course_points, p6);
-    vector_t *p7 = malloc(sizeof(vector_t));
-    p7->x = MAX_CANVAS_SIZE.x * 6/7 * SCALE;
-    p7->y = MAX_CANVAS_SIZE.y * 3/6 * SCALE;
-    list_add(course_points, p7);
-    vector_t *p8 = malloc(sizeof(vector_t));
-    p8->x = MAX_CANVAS_SIZE.x * 6/7 * SCALE;
-    p8->y = MAX_CANVAS_SIZE.y * 1 * SCALE;
-    list_add(course_points, p8);
-    vector_t *p9 = malloc(sizeof(vector_t));
-    p9->x = MAX_CANVAS_SIZE.x * 1 * SCALE;
-    p9->y = MAX_CANVAS_SIZE.y * 1 * SCALE;
-    list_add(course_points, p9);
-    vector_t *p10 = malloc(sizeof(vector_t));
-    p10->x = MAX_CANVAS_SIZE.x * 1 * SCALE;
-    p10->y = 1;
-    list_add(course_points, p10);
-    vector_t *p11 = malloc(sizeof(vector_t));
-    p11->x = MAX_CANVAS_SIZE.x * 4/7 * SCALE;
-    p11->y = 1;
-    list_add(course_points, p11);
-    vector_t *p12 = malloc(sizeof(vector_t));
-    p12->x = MAX_CANVAS_SIZE.x * 4/7 * SCALE;
-    p12->y = MAX_CANVAS_SIZE.y * 2/6 * SCALE;
-    list_add(course_points, p12);
-    vector_t *p13 = malloc(sizeof(vector_t));
-    p13->x = MAX_CANVAS_SIZE.x * 3/7 * SCALE;
-    p13->y = MAX_CANVAS_SIZE.y * 2/6 * SCALE;
-    list_add(course_points, p13);
-    vector_t *p14 = malloc(sizeof(vector_t));
-    p14->x = MAX_CANVAS_SIZE.x * 3/7 * SCALE;
-    p14->y = MAX_CANVAS_SIZE.y * 1/6 * SCALE;
-    list_add(course_points, p14);
-    vector_t *p15 = malloc(sizeof(vector_t));
-    p15->x = MAX_CANVAS_SIZE.x * 1/7 * SCALE;
-    p15->y = MAX_CANVAS_SIZE.y * 1/6 * SCALE;
-    list_add(course_points, p15);
-    vector_t *p16 = malloc(sizeof(vector_t));
-    p16->x = MAX_CANVAS_SIZE.x * 1/7 * SCALE;
-    p16->y = 1;
-    list_add(course_points, p16);
-    body_t *course = body_init_with_info(course_points, INFINITY, COURSE_COLOR, "course", free);
-    scene_add_body(scene, course);
-    body_set_color2(course, ALT_COURSE_COLOR);
-    
-    list_t *slope_points = list_init(POINTS, (free_func_t) body_free_vec_list);
-    vector_t *slope11 = malloc(sizeof(vector_t));
-    slope11->x = MAX_CANVAS_SIZE.x * 4/7 * SCALE;
-    slope11->y = MAX_CANVAS_SIZE.y * 0 * SCALE;
-    list_add(slope_points, slope11);
-    vector_t *slope12 = malloc(sizeof(vector_t));
-    slope12->x = MAX_CANVAS_SIZE.x * 1 * SCALE;
-    slope12->y = MAX_CANVAS_SIZE.y * 0 * SCALE;
-    list_add(slope_points, slope12);
-    vector_t *slope13 = malloc(sizeof(vector_t));
-    slope13->x = MAX_CANVAS_SIZE.x * 1 * SCALE;
-    slope13->y = MAX_CANVAS_SIZE.y * 2/6 * SCALE;
-    list_add(slope_points, slope13);
-    vector_t *slope14 = malloc(sizeof(vector_t));
-    slope14->x = MAX_CANVAS_SIZE.x * 4/7 * SCALE;
-    slope14->y = MAX_CANVAS_SIZE.y * 2/6 * SCALE;
-    list_add(slope_points, slope14);
-    body_t *slope1 = body_init_with_info(slope_points, INFINITY, SLOPE_COLOR, "slope", free);
-    scene_add_body(scene, slope1);
-    body_set_color2(slope1, ALT_SLOPE_COLOR);
+    golf_hole_t *hole = init_hole(scene, 2, (collision_handler_t) ball_in_hole2);
 
-    double hole_pos_x = MAX_CANVAS_SIZE.x * 13/14 * SCALE;
-    double hole_pos_y = MAX_CANVAS_SIZE.y * 11/12 * SCALE;
-    vector_t center = {.x=hole_pos_x, .y=hole_pos_y};
-    list_t *circle = draw_circle(center, HOLE_SIZE * SCALE);
-    body_t *hole = body_init_with_info(circle, INFINITY, HOLE_COLOR, "hole", free);
-    scene_add_body(scene, hole);
-    body_set_color2(hole, ALT_HOLE_COLOR);
-
-    list_t *circle_big = draw_circle(center, HOLE_SIZE * 2 * SCALE);
-    body_t *hole_real = body_init_with_info(circle_big, INFINITY, HOLE_COLOR, "hole_real", free);
-    scene_add_body(scene, hole_real);
-    body_set_color2(hole_real, ALT_HOLE_COLOR);
-
-    vector_t start_pos_ball1 = {.x=MAX_CANVAS_SIZE.x * 1/30 * SCALE, .y=MAX_CANVAS_SIZE.y * 1/20 * SCALE};
-    list_t *circle1 = draw_circle(start_pos_ball1, HOLE_SIZE * SCALE);
-    body_t *ball1 = body_init_with_info(circle1, MASS, BALL1_COLOR, "golf_ball1", free);
-    create_collision(scene, ball1, hole, (collision_handler_t) ball_in_hole2, scene, NULL);
-
-    vector_t start_pos_ball2 = {.x=MAX_CANVAS_SIZE.x * 1/15 * SCALE, .y=MAX_CANVAS_SIZE.y * 1/20 * SCALE};
-    list_t *circle2 = draw_circle(start_pos_ball2, HOLE_SIZE * SCALE);
-    body_t *ball2 = body_init_with_info(circle2, MASS, BALL2_COLOR, "golf_ball2", free);
-    create_collision(scene, ball2, hole, (collision_handler_t) ball_in_hole2, scene, NULL);
-
-    vector_t slope_direction = {.x = 0, .y = 1};
-    create_frictional_and_slope_force(scene, 0.3, 40, slope_direction, 2000, ball1, slope1);
-    create_frictional_and_slope_force(scene, 0.3, 40, slope_direction, 2000, ball2, slope1);
-    
-    vector_t center_bouncy = {.x = MAX_CANVAS_SIZE.x * 3.5/7 * SCALE, .y = MAX_CANVAS_SIZE.y * 3.5/5 * SCALE};
-    list_t *bouncy_ball_points = draw_star(center_bouncy, 100);
-    body_t *bouncy_ball1 = body_init_with_info(bouncy_ball_points, INFINITY, BOUNCY_COLOR, "bouncy_ball", free);
-    body_set_color2(bouncy_ball1, ALT_BOUNCY_COLOR);
-    create_physics_collision(scene, 1.5, ball1, bouncy_ball1);
-    create_physics_collision(scene, 1.5, ball2, bouncy_ball1);
-    create_collision(scene, ball1, bouncy_ball1, (collision_handler_t) play_sound, scene, NULL);
-    create_collision(scene, ball2, bouncy_ball1, (collision_handler_t) play_sound, scene, NULL);
-    scene_add_body(scene, bouncy_ball1);
-
-    golf_course_t *golf_course = golf_course_init(course, hole, start_pos_ball1, start_pos_ball2, WALL_COLOR);
-    golf_course_add_walls(golf_course);
-    for(size_t i = 0; i < list_size(golf_course_get_walls(golf_course)); i++){
-        body_t *wall = list_get(golf_course_get_walls(golf_course), i);
-        scene_add_body(scene, wall);
-        body_set_color2(wall, ALT_WALL_COLOR);
-        create_physics_collision(scene, 0.3, ball1, wall);
-        create_physics_collision(scene, 0.3, ball2, wall);
-        create_collision(scene, ball1, wall, (collision_handler_t) play_sound, scene, NULL);
-        create_collision(scene, ball2, wall, (collision_handler_t) play_sound, scene, NULL);
-    }
-    create_friction(scene, 100, ball1, course);
-    create_friction(scene, 100, ball2, course);
-
-    scene_add_body(scene, ball1);
-    scene_add_body(scene, ball2);
-
-    create_collision(scene, ball1, hole, (collision_handler_t) play_sound, scene, NULL);
-    create_collision(scene, ball2, hole, (collision_handler_t) play_sound, scene, NULL);
-    
     body_t *coin1 = add_coin(scene, MAX_CANVAS_SIZE.x * 5/7 * SCALE, MAX_CANVAS_SIZE.y * 1/7 * SCALE, -0.2);
     body_t *coin2 = add_coin(scene, MAX_CANVAS_SIZE.x * 6/7 * SCALE, MAX_CANVAS_SIZE.y * 1/7 * SCALE, 0.4);
     body_t *freeze_pellet_1 = add_freeze_pellet(scene, MAX_CANVAS_SIZE.x * 2.5/7 * SCALE, MAX_CANVAS_SIZE.y * 3/5 * SCALE, 10);
-
-    create_collision(scene, ball1, coin1, (collision_handler_t) play_sound, scene, NULL);
-    create_collision(scene, ball2, coin1, (collision_handler_t) play_sound, scene, NULL);
-
-    create_collision(scene, ball1, coin2, (collision_handler_t) play_sound, scene, NULL);
-    create_collision(scene, ball2, coin2, (collision_handler_t) play_sound, scene, NULL);
-
-    create_collision(scene, ball1, freeze_pellet_1, (collision_handler_t) play_sound, scene, NULL);
-    create_collision(scene, ball2, freeze_pellet_1, (collision_handler_t) play_sound, scene, NULL);
+    add_pickup_sound(scene, hole, coin1);
+    add_pickup_sound(scene, hole, coin2);
+    add_pickup_sound(scene, hole, freeze_pellet_1);
+    golf_hole_free(hole);
 }
 
 void ball_in_hole1(body_t *ball, body_t *target, vector_t axis, scene_t *scene){
-    //ball only "goes in the hole" if its velocity is below the max velocity
-    if(vec_dot(body_get_velocity(ball), body_get_velocity(ball)) < MAX_HOLE_VEL){
+    //ball only "goes in the hole" if it is slow enough
+    if(golf_hole_sinks(ball)){
         body_set_velocity(ball, VEC_ZERO);
         if(strcmp(body_get_info(ball), "golf_ball2") == 0){
             ((game_state_t *) scene_get_state(scene))->player2_done = true;
@@ -1175,216 +647,25 @@ void ball_in_hole1(body_t *ball, body_t *target, vector_t axis, scene_t *scene){
 
 void init_course_1(scene_t *scene){
     Mix_PlayMusic(((game_state_t *)scene_get_state(scene))->hole1, -1);
-    ((game_state_t *) scene_get_state(scene))->night_mode = false;
-    list_t *background_points = list_init(POINTS, (free_func_t) body_free_vec_list);
-    vector_t *bp1 = malloc(sizeof(vector_t));
-    bp1->x = 0;
-    bp1->y = 0;
-    list_add(background_points, bp1);
-    vector_t *bp2 = malloc(sizeof(vector_t));
-    bp2->x = 0;
-    bp2->y = MAX_CANVAS_SIZE.y;
-    list_add(background_points, bp2);
-    vector_t *bp3 = malloc(sizeof(vector_t));
-    bp3->x = MAX_CANVAS_SIZE.x;
-    bp3->y = MAX_CANVAS_SIZE.y;
-    list_add(background_points, bp3);
-    vector_t *bp4 = malloc(sizeof(vector_t));
-    bp4->x = MAX_CANVAS_SIZE.x;
-    bp4->y = 0;
-    list_add(background_points, bp4);
-    body_t *background = body_init_with_info(background_points, INFINITY, BACKGROUND_COLOR, "background", free);
-    scene_add_body(scene, background);
-    body_set_color2(background, ALT_BACKGROUND_COLOR);
-
-    list_t *course_points = list_init(POINTS, (free_func_t) body_free_vec_list);
-    vector_t *p1 = malloc(sizeof(vector_t));
-    p1->x = 1 * SCALE;
-    p1->y = 1 * SCALE;
-    list_add(course_points, p1);
-    vector_t *p2 = malloc(sizeof(vector_t));
-    p2->x = 1 * SCALE;
-    p2->y = MAX_CANVAS_SIZE.y * SCALE;
-    list_add(course_points, p2);
-    vector_t *p3 = malloc(sizeof(vector_t));
-    p3->x = MAX_CANVAS_SIZE.x * SCALE;
-    p3->y = MAX_CANVAS_SIZE.y * SCALE;
-    list_add(course_points, p3);
-    vector_t *p4 = malloc(sizeof(vector_t));
-    p4->x = MAX_CANVAS_SIZE.x * SCALE;
-    p4->y = 1 * SCALE;
-    list_add(course_points, p4);
-    vector_t *p5 = malloc(sizeof(vector_t));
-    p5->x = MAX_CANVAS_SIZE.x * 4/5 * SCALE;
-    p5->y = 1 * SCALE;
-    list_add(course_points, p5);
-    vector_t *p6 = malloc(sizeof(vector_t));
-    p6->x = MAX_CANVAS_SIZE.x * 4/5 * SCALE;
-    p6->y = MAX_CANVAS_SIZE.y * 3/5 * SCALE;
-    list_add(course_points, p6);
-    vector_t *p7 = malloc(sizeof(vector_t));
-    p7->x = MAX_CANVAS_SIZE.x * 1/5 * SCALE;
-    p7->y = MAX_CANVAS_SIZE.y * 3/5 * SCALE;
-    list_add(course_points, p7);
-    vector_t *p8 = malloc(sizeof(vector_t));
-    p8->x = MAX_CANVAS_SIZE.x * 1/5 * SCALE;
-    p8->y = 1 * SCALE;
-    list_add(course_points, p8);
-    
-    body_t *course = body_init_with_info(course_points, INFINITY, COURSE_COLOR, "course", free);
-    scene_add_body(scene, course);
-    body_set_color2(course, ALT_COURSE_COLOR);
-    
-    list_t *patch1_points = list_init(POINTS, (free_func_t) body_free_vec_list);
-    vector_t *patch11 = malloc(sizeof(vector_t));
-    patch11->x = MAX_CANVAS_SIZE.x * 3.7/5 * SCALE;
-    patch11->y = MAX_CANVAS_SIZE.y * 3.5/5 * SCALE;
-    list_add(patch1_points, patch11);
-    vector_t *patch12 = malloc(sizeof(vector_t));
-    patch12->x = MAX_CANVAS_SIZE.x * 3.7/5 * SCALE;
-    patch12->y = MAX_CANVAS_SIZE.y * 4.2/5 * SCALE;
-    list_add(patch1_points, patch12);
-    vector_t *patch13 = malloc(sizeof(vector_t));
-    patch13->x = MAX_CANVAS_SIZE.x * 4.2/5 * SCALE;
-    patch13->y = MAX_CANVAS_SIZE.y * 4.2/5 * SCALE;
-    list_add(patch1_points, patch13);
-    vector_t *patch14 = malloc(sizeof(vector_t));
-    patch14->x = MAX_CANVAS_SIZE.x * 4.2/5 * SCALE;
-    patch14->y = MAX_CANVAS_SIZE.y * 3.5/5 * SCALE;
-    list_add(patch1_points, patch14);
-    body_t *patch1 = body_init_with_info(patch1_points, INFINITY, PATCH_COLOR, "patch", free);
-    scene_add_body(scene, patch1);
-    body_set_color2(patch1, ALT_PATCH_COLOR);
-    
-    list_t *slope_points = list_init(POINTS, (free_func_t) body_free_vec_list);
-    vector_t *slope11 = malloc(sizeof(vector_t));
-    slope11->x = MAX_CANVAS_SIZE.x * 2/5 * SCALE;
-    slope11->y = MAX_CANVAS_SIZE.y * 3/5 * SCALE;
-    list_add(slope_points, slope11);
-    vector_t *slope12 = malloc(sizeof(vector_t));
-    slope12->x = MAX_CANVAS_SIZE.x * 2/5 * SCALE;
-    slope12->y = MAX_CANVAS_SIZE.y * SCALE;
-    list_add(slope_points, slope12);
-    vector_t *slope13 = malloc(sizeof(vector_t));
-    slope13->x = MAX_CANVAS_SIZE.x * 3/5 * SCALE;
-    slope13->y = MAX_CANVAS_SIZE.y * SCALE;
-    list_add(slope_points, slope13);
-    vector_t *slope14 = malloc(sizeof(vector_t));
-    slope14->x = MAX_CANVAS_SIZE.x * 3/5 * SCALE;
-    slope14->y = MAX_CANVAS_SIZE.y * 3/5 * SCALE;
-    list_add(slope_points, slope14);
-    body_t *slope1 = body_init_with_info(slope_points, INFINITY, SLOPE_COLOR, "slope", free);
-    scene_add_body(scene, slope1);
-    body_set_color2(slope1, ALT_SLOPE_COLOR);
+    golf_hole_t *hole = init_hole(scene, 1, (collision_handler_t) ball_in_hole1);
 
-    //A force surface is a patch that applies a force on the ball
-    list_t *force_surface_points = list_init(POINTS, (free_func_t) body_free_vec_list);
-    vector_t *force_surface11 = malloc(sizeof(vector_t));
-    force_surface11->x = MAX_CANVAS_SIZE.x * 0.5/5 * SCALE;
-    force_surface11->y = MAX_CANVAS_SIZE.y * 3.8/5 * SCALE;
-    list_add(force_surface_points, force_surface11);
-    vector_t *force_surface12 = malloc(sizeof(vector_t));
-    force_surface12->x = MAX_CANVAS_SIZE.x * 0.5/5 * SCALE;
-    force_surface12->y = MAX_CANVAS_SIZE.y * 9/10 * SCALE;
-    list_add(force_surface_points, force_surface12);
-    vector_t *force_surface13 = malloc(sizeof(vector_t));
-    force_surface13->x = MAX_CANVAS_SIZE.x * 1.25/5 * SCALE;
-    force_surface13->y = MAX_CANVAS_SIZE.y * 8.5/10 * SCALE;
-    list_add(force_surface_points, force_surface13);
-    vector_t *force_surface14 = malloc(sizeof(vector_t));
-    force_surface14->x = MAX_CANVAS_SIZE.x * 1.25/5 * SCALE;
-    force_surface14->y = MAX_CANVAS_SIZE.y * 3.3/5 * SCALE;
-    list_add(force_surface_points, force_surface14);
-    body_t *force_surface1 = body_init_with_info(force_surface_points, INFINITY, FORCE_COLOR, "force_surface", free);
-    scene_add_body(scene, force_surface1);
-    body_set_color2(force_surface1, ALT_FORCE_COLOR);
-    
-    double hole_pos_x = MAX_CANVAS_SIZE.x * 9/10 * SCALE;
-    double hole_pos_y = MAX_CANVAS_SIZE.y * 1/10 * SCALE;
-
-    vector_t center = {.x=hole_pos_x, .y=hole_pos_y};
-    list_t *circle = draw_circle(center, HOLE_SIZE * SCALE);
-    body_t *hole = body_init_with_info(circle, INFINITY, HOLE_COLOR, "hole", free);
-    scene_add_body(scene, hole);
-    body_set_color2(hole, ALT_HOLE_COLOR);
-
-    list_t *circle_big = draw_circle(center, HOLE_SIZE * 2 * SCALE);
-    body_t *hole_real = body_init_with_info(circle_big, INFINITY, HOLE_COLOR, "hole_real", free);
-    scene_add_body(scene, hole_real);
-    body_set_color2(hole_real, ALT_HOLE_COLOR);
-
-    vector_t start_pos_ball1 = {.x=MAX_CANVAS_SIZE.x * 1/30 * SCALE, .y=MAX_CANVAS_SIZE.y * 1/20 * SCALE};
-    list_t *circle1 = draw_circle(start_pos_ball1, HOLE_SIZE * SCALE);
-    body_t *ball1 = body_init_with_info(circle1, MASS, BALL1_COLOR, "golf_ball1", free);
-    create_collision(scene, ball1, hole, (collision_handler_t) ball_in_hole1, scene, NULL);
-
-    vector_t start_pos_ball2 = {.x=MAX_CANVAS_SIZE.x * 2/15 * SCALE, .y=MAX_CANVAS_SIZE.y * 1/20 * SCALE};
-    list_t *circle2 = draw_circle(start_pos_ball2, HOLE_SIZE * SCALE);
-    body_t *ball2 = body_init_with_info(circle2, MASS, BALL2_COLOR, "golf_ball2", free);
-    create_collision(scene, ball2, hole, (collision_handler_t) ball_in_hole1, scene, NULL);
-    
-    vector_t slope_direction = {.x = -1, .y = 0};
-    create_frictional_and_slope_force(scene, 0.3, 40, slope_direction, 5000, ball1, slope1);
-    create_frictional_and_slope_force(scene, 0.3, 40, slope_direction, 5000, ball2, slope1);
-
-    vector_t force_direction = {.x = 1, .y = 0.5};
-    create_force_collision(scene, force_direction, ball1, force_surface1);
-    create_force_collision(scene, force_direction, ball2, force_surface1);
-
-    vector_t center_bouncy = {.x = MAX_CANVAS_SIZE.x * 0.7/7 * SCALE, .y = MAX_CANVAS_SIZE.y * 3/5 * SCALE};
-    list_t *bouncy_ball_points = draw_circle(center_bouncy, 50);
-    body_t *bouncy_ball1 = body_init_with_info(bouncy_ball_points, INFINITY, BOUNCY_COLOR, "bouncy_ball", free);
-    body_set_color2(bouncy_ball1, ALT_BOUNCY_COLOR);
-    create_physics_collision(scene, 1.5, ball1, bouncy_ball1);
-    create_physics_collision(scene, 1.5, ball2, bouncy_ball1);
-    create_collision(scene, ball1, bouncy_ball1, (collision_handler_t) play_sound, scene, NULL);
-    create_collision(scene, ball2, bouncy_ball1, (collision_handler_t) play_sound, scene, NULL);
-    scene_add_body(scene, bouncy_ball1);
-    
-    golf_course_t *golf_course = golf_course_init(course, hole, start_pos_ball1, start_pos_ball2, WALL_COLOR);
-    golf_course_add_walls(golf_course);
-    for(size_t i = 0; i < list_size(golf_course_get_walls(golf_course)); i++){
-        body_t *wall = list_get(golf_course_get_walls(golf_course), i);
-        scene_add_body(scene, wall);
-        body_set_color2(wall, ALT_WALL_COLOR);
-        create_physics_collision(scene, 0.3, ball1, wall);
-        create_physics_collision(scene, 0.3, ball2, wall);
-        create_collision(scene, ball1, wall, (collision_handler_t) play_sound, scene, NULL);
-        create_collision(scene, ball2, wall, (collision_handler_t) play_sound, scene, NULL);
-    }
-    create_friction(scene, 100, ball1, course);
-    create_friction(scene, 100, ball2, course);
-    create_friction(scene, 250, ball1, patch1);
-    create_friction(scene, 250, ball2, patch1);
-    
-    scene_add_body(scene, ball1);
-    scene_add_body(scene, ball2);
-    
-    create_collision(scene, ball1, hole, (collision_handler_t) play_sound, scene, NULL);
-    create_collision(scene, ball2, hole, (collision_handler_t) play_sound, scene, NULL);
-
-    create_collision(scene, ball1, patch1, (collision_handler_t) play_sound, scene, NULL);
-    create_collision(scene, ball2, patch1, (collision_handler_t) play_sound, scene, NULL);
-    
-    
     body_t *coin1 = add_coin(scene, MAX_CANVAS_SIZE.x * 1/6 * SCALE, MAX_CANVAS_SIZE.y * 1/5 * SCALE, 0.6);
     body_t *freeze_pellet_1 = add_freeze_pellet(scene, MAX_CANVAS_SIZE.x * 1/7 * SCALE, MAX_CANVAS_SIZE.y * 1/5 * SCALE, 30);
-
-    create_collision(scene, ball1, coin1, (collision_handler_t) play_sound, scene, NULL);
-    create_collision(scene, ball2, coin1, (collision_handler_t) play_sound, scene, NULL);
-
-    create_collision(scene, ball1, freeze_pellet_1, (collision_handler_t) play_sound, scene, NULL);
-    create_collision(scene, ball2, freeze_pellet_1, (collision_handler_t) play_sound, scene, NULL);
+    add_pickup_sound(scene, hole, coin1);
+    add_pickup_sound(scene, hole, freeze_pellet_1);
+    golf_hole_free(hole);
 }
 
 //adds all of the text for the game
 void draw_text(scene_t *scene, TTF_Font *font, double dt){
-    char *points = malloc(sizeof(char) * 1000);
-    char *turn = malloc(sizeof(char) * 1000);
-    char *freeze1 = malloc(sizeof(char) * 1000);
-    char *freeze2 = malloc(sizeof(char) * 1000);
-    char *player_win = malloc(sizeof(char) * 1000);
-    char *leaderboard = malloc(sizeof(char) * 1000);
+    //the strings only live until the next tick, so they come from the scene's arena
+    arena_t *arena = scene_get_arena(scene);
+    char *points = arena_alloc(arena, sizeof(char) * 1000);
+    char *turn = arena_alloc(arena, sizeof(char) * 1000);
+    char *freeze1 = arena_alloc(arena, sizeof(char) * 1000);
+    char *freeze2 = arena_alloc(arena, sizeof(char) * 1000);
+    char *player_win = arena_alloc(arena, sizeof(char) * 1000);
+    char *leaderboard = arena_alloc(arena, sizeof(char) * 1000);
 
     SDL_Color color = ((game_state_t *) scene_get_state(scene))->text_color_day;
     if(((game_state_t *) scene_get_state(scene))->night_mode){
@@ -1439,25 +720,17 @@ void draw_text(scene_t *scene, TTF_Font *font, double dt){
         SDL_Surface *surface4 = TTF_RenderText_Solid(font, leaderboard, color);
         sdl_draw_text(surface4, 350, 60, 300, 30);
         
-        list_t *scores = get_scores();
+        score_list_t *scores = get_scores();
         int num_scores = 10;
-        if(list_size(scores) < 10) num_scores = list_size(scores);
-        char *score = malloc(sizeof(char) * 1000);
+        if(score_list_size(scores) < 10) num_scores = score_list_size(scores);
+        char *score = arena_alloc(arena, sizeof(char) * 1000);
         for(size_t i = 0; i < num_scores; i++){
-            double *str = list_get(scores, i);
-            sprintf(score, "%zu: %f", i + 1, *str);
+            sprintf(score, "%zu: %f", i + 1, score_list_get(scores, i));
             SDL_Surface *surface4 = TTF_RenderText_Solid(font, score, color);
             sdl_draw_text(surface4, 445, 90 + (30 * i), 100, 30);
         }
-        free(score);
-        list_free(scores);
+        score_list_free(scores);
     }
-    free(points);
-    free(turn);
-    free(freeze1);
-    free(freeze2);
-    free(player_win);
-    free(leaderboard);
 }
 
 bool inited = false;
@@ -1468,6 +741,7 @@ void init() {
     game_state_t *game = game_state_init();
     sdl_init(VEC_ZERO, MAX_CANVAS_SIZE);
     scene = scene_init();
+    scene_enable_sleeping(scene, SLEEP_SPEED, SLEEP_TICKS);
     scene_set_state(scene, game);
     sdl_on_key(on_key);
     sdl_on_click(on_click);
@@ -1503,13 +777,12 @@ void c_main(){
     }
     double dt = time_since_last_tick();
     automatic_scroll(scene);
-    scene_tick(scene, dt);
+    scene_step_fixed(scene, dt, PHYSICS_STEP, MAX_SUBSTEPS);
+    update_hit_path(scene);
 
     draw_text(scene, font, dt);
     sdl_render_scene(scene);
 
-    delete_hit_path(scene);
-
     if (sdl_is_done(scene)) {
         #ifdef __EMSCRIPTEN__
         emscripten_cancel_main_loop();
@@ -0,0 +1,269 @@
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+#include <unistd.h>
+#include "body.h"
+#include "scene.h"
+#include "forces.h"
+#include "golf_hole.h"
+#include "job_system.h"
+#include "typed_vec.h"
+
+// Plays batches of golf shots without a window, e.g. to tune a hole.
+//
+// Usage: bin/golfsim HOLE [THREADS] < shots
+//
+// Each line of input is one shot to try: one or more strokes, each written as the drag
+// "dx dy" that hit_ball() in demo/golf.c gets from the mouse. The strokes are played
+// from the tee, each once the ball has come to rest, until the ball drops in.
+// Lines that are blank or start with '#' are skipped.
+// Prints where each shot left player 1's ball and how many strokes it took to sink it,
+// then how quickly the shots were played on all the threads, and how many each job played.
+// The hole is built once; each job plays its shots on a copy of it made by scene_clone().
+
+// the same tick and rest detection as demo/golf.c
+const double PHYSICS_STEP = 1.0 / 240;
+const double SLEEP_SPEED = 2;
+const size_t SLEEP_TICKS = 60;
+// a stroke that is still rolling after a minute gives up
+const size_t MAX_STROKE_TICKS = 240 * 60;
+const size_t LINE_SIZE = 4096;
+const size_t INITIAL_SHOTS = 256;
+
+typedef struct{
+    // the shot's strokes, in the batch's list of drags
+    size_t first_drag;
+    size_t num_drags;
+    // where the ball ended up, and after how many strokes it dropped in (0 if it did not)
+    vector_t position;
+    size_t strokes;
+    size_t ticks;
+} shot_t;
+
+DECLARE_VEC(drag_list, vector_t)
+DECLARE_VEC(shot_list, shot_t)
+
+// the hole as it is before any stroke, copied for each job
+typedef struct{
+    scene_t *scene;
+    body_t *ball;
+    body_t *cup;
+} course_t;
+
+// a copy of the hole for one job to play shots on
+typedef struct{
+    scene_t *scene;
+    body_t *ball;
+    // the hole before any stroke, restored before each shot
+    void *tee;
+    bool sunk;
+} green_t;
+
+typedef struct{
+    // one copy of the hole per job
+    green_t **greens;
+    drag_list_t *drags;
+    shot_list_t *shots;
+    // the next shot a job should play
+    atomic_size_t next;
+    // how many shots each job played; jobs are not tied to threads, so these are not per thread
+    size_t *played;
+} batch_t;
+
+double wall_seconds(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+void drop_in(body_t *ball, body_t *cup, vector_t axis, green_t *green){
+    (void) cup;
+    (void) axis;
+    if(golf_hole_sinks(ball)) green->sunk = true;
+}
+
+course_t *course_init(size_t number){
+    course_t *course = malloc(sizeof(course_t));
+    assert(course);
+    course->scene = scene_init();
+    scene_enable_sleeping(course->scene, SLEEP_SPEED, SLEEP_TICKS);
+    golf_hole_t *hole = golf_hole_init(course->scene, number);
+    course->ball = golf_hole_get_ball(hole, 1);
+    course->cup = golf_hole_get_cup(hole);
+    golf_hole_free(hole);
+    // lets the course fall asleep first, so each shot only wakes up what the ball touches
+    for(size_t i = 0; i <= SLEEP_TICKS && scene_awake_bodies(course->scene) > 0; i++){
+        scene_tick(course->scene, PHYSICS_STEP);
+    }
+    return course;
+}
+
+void course_free(course_t *course){
+    scene_free(course->scene);
+    free(course);
+}
+
+green_t *green_init(course_t *course){
+    green_t *green = malloc(sizeof(green_t));
+    assert(green);
+    green->scene = scene_clone(course->scene);
+    assert(green->scene != NULL);
+    green->ball = scene_get_clone(green->scene, course->ball);
+    // added to the copy, since its aux is this green
+    create_collision(
+        green->scene, green->ball, scene_get_clone(green->scene, course->cup), (collision_handler_t) drop_in, green, NULL
+    );
+    green->tee = malloc(scene_snapshot(green->scene, NULL));
+    assert(green->tee);
+    scene_snapshot(green->scene, green->tee);
+    green->sunk = false;
+    return green;
+}
+
+void green_free(green_t *green){
+    scene_free(green->scene);
+    free(green->tee);
+    free(green);
+}
+
+void play_shot(green_t *green, shot_t *shot, drag_list_t *drags){
+    scene_restore(green->scene, green->tee);
+    green->sunk = false;
+    shot->strokes = 0;
+    shot->ticks = 0;
+    for(size_t i = 0; i < shot->num_drags && !green->sunk; i++){
+        golf_hole_hit(green->ball, drag_list_get(drags, shot->first_drag + i));
+        size_t ticks = 0;
+        do{
+            scene_tick(green->scene, PHYSICS_STEP);
+            ticks++;
+        } while(!green->sunk && !body_is_asleep(green->ball) && ticks < MAX_STROKE_TICKS);
+        shot->ticks += ticks;
+        if(green->sunk) shot->strokes = i + 1;
+    }
+    shot->position = body_get_centroid(green->ball);
+}
+
+// run by each job: plays shots on its copy of the hole until there are none left
+void play_shots(batch_t *batch, size_t job){
+    green_t *green = batch->greens[job];
+    while(true){
+        size_t index = atomic_fetch_add(&batch->next, 1);
+        if(index >= shot_list_size(batch->shots)) break;
+        play_shot(green, &shot_list_data(batch->shots)[index], batch->drags);
+        batch->played[job]++;
+    }
+}
+
+// reads one shot per line; returns false if a line is not a list of "dx dy" pairs
+bool read_shots(FILE *input, batch_t *batch){
+    char *line = malloc(LINE_SIZE);
+    assert(line);
+    bool valid = true;
+    while(valid && fgets(line, LINE_SIZE, input) != NULL){
+        shot_t shot = {.first_drag = drag_list_size(batch->drags), .num_drags = 0};
+        char *start = line;
+        while(true){
+            char *end;
+            double dx = strtod(start, &end);
+            if(end == start) break;
+            start = end;
+            double dy = strtod(start, &end);
+            if(end == start){
+                valid = false;
+                break;
+            }
+            start = end;
+            drag_list_add(batch->drags, (vector_t){dx, dy});
+            shot.num_drags++;
+        }
+        while(*start == ' ' || *start == '\t' || *start == '\r' || *start == '\n') start++;
+        if(*start != '\0' && *start != '#') valid = false;
+        if(!valid) fprintf(stderr, "golfsim: expected \"dx dy\" pairs, got: %s", line);
+        if(shot.num_drags > 0) shot_list_add(batch->shots, shot);
+    }
+    free(line);
+    return valid;
+}
+
+int main(int argc, char *argv[]){
+    size_t hole = argc > 1 ? strtoul(argv[1], NULL, 10) : 0;
+    if(hole < 1 || hole > GOLF_HOLE_COUNT){
+        fprintf(stderr, "usage: %s HOLE [THREADS] < shots\n", argv[0]);
+        fprintf(stderr, "HOLE is from 1 to %zu; each line of shots is one or more \"dx dy\" drags\n", GOLF_HOLE_COUNT);
+        return 1;
+    }
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t threads = argc > 2 ? strtoul(argv[2], NULL, 10) : (cores > 1 ? (size_t) cores : 1);
+    if(threads < 1) threads = 1;
+
+    batch_t batch = {.drags = drag_list_init(INITIAL_SHOTS), .shots = shot_list_init(INITIAL_SHOTS)};
+    atomic_init(&batch.next, 0);
+    batch.played = calloc(threads, sizeof(size_t));
+    assert(batch.played);
+    if(!read_shots(stdin, &batch)) return 1;
+
+    // the copies are made here, since copying a scene is not safe from several threads at once
+    course_t *course = course_init(hole);
+    batch.greens = malloc(threads * sizeof(green_t *));
+    assert(batch.greens);
+    for(size_t i = 0; i < threads; i++){
+        batch.greens[i] = green_init(course);
+    }
+    course_free(course);
+    job_system_t *jobs = job_system_init(threads);
+    double start = wall_seconds();
+    // one job per thread, though a thread that finishes its job early may run another's
+    job_system_parallel_for(jobs, threads, 1, (job_func_t) play_shots, &batch);
+    double seconds = wall_seconds() - start;
+    job_system_free(jobs);
+    for(size_t i = 0; i < threads; i++){
+        green_free(batch.greens[i]);
+    }
+    free(batch.greens);
+
+    printf("%8s %10s %10s %8s %8s\n", "shot", "x", "y", "strokes", "ticks");
+    size_t total_ticks = 0;
+    size_t holed = 0;
+    VEC_FOR_EACH(shot_t, shot, batch.shots){
+        char strokes[32] = "-";
+        if(shot->strokes > 0){
+            snprintf(strokes, sizeof(strokes), "%zu", shot->strokes);
+            holed++;
+        }
+        printf(
+            "%8zu %10.2f %10.2f %8s %8zu\n",
+            (size_t) (shot - shot_list_data(batch.shots)) + 1,
+            shot->position.x,
+            shot->position.y,
+            strokes,
+            shot->ticks
+        );
+        total_ticks += shot->ticks;
+    }
+    size_t num_shots = shot_list_size(batch.shots);
+    printf(
+        "\n%zu shots on hole %zu, %zu holed, in %.3f s on %zu threads: %.0f shots/s, %.0f ticks/s\n",
+        num_shots,
+        hole,
+        holed,
+        seconds,
+        threads,
+        num_shots / seconds,
+        total_ticks / seconds
+    );
+    // an uneven split means a few long shots kept some jobs busy after the rest ran out
+    printf("shots per job:");
+    for(size_t i = 0; i < threads; i++){
+        printf(" %zu", batch.played[i]);
+    }
+    printf("\n");
+    free(batch.played);
+    drag_list_free(batch.drags);
+    shot_list_free(batch.shots);
+    return 0;
+}
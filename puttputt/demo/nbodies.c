@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <assert.h>
+#include <unistd.h>
 #include "sdl_wrapper.h"
 #include "polygon.h"
 #include "scene.h"
@@ -9,8 +10,11 @@
 #include "body.h"
 #include "list.h"
 #include "vector.h"
+#include "job_system.h"
 
 const vector_t MAX_CANVAS_SIZE = {.x=1000, .y=500};
+const double PHYSICS_STEP = 1.0 / 240;
+const size_t MAX_SUBSTEPS = 16;
 const int NUM_POINTS = 4;
 const int NUM_STARS = 50;
 const double OUTER_INNER_RATIO_STAR = 2.5;
@@ -19,6 +23,8 @@ const int SIZE_RANGE = 30;
 const int MIN_SIZE = 20;
 const double G = 500;
 const int MASS_SCALE = 10;
+// 0 computes gravity exactly between every pair of stars
+const double THETA = 0.5;
 
 rgb_color_t random_color(){
     double red = (double) (rand() % COLOR_MAX) / COLOR_MAX;
@@ -57,25 +63,30 @@ void add_star(scene_t *scene, size_t points) {
 int main(int argc, char *argv[]) {
     sdl_init(VEC_ZERO, MAX_CANVAS_SIZE);
     scene_t *scene = scene_init();
+    //spreads the gravity field and the stars' motion over every core
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    job_system_t *jobs = job_system_init(cores > 1 ? (size_t) cores : 1);
+    scene_set_job_system(scene, jobs);
     
     //initializes the stars
     for(size_t i = 0; i < NUM_STARS; i++){
         add_star(scene, NUM_POINTS);
     }
 
-    //adds a gravity force between all of the stars
+    //adds one gravity field pulling all of the stars together
+    list_t *stars = list_init(scene_bodies(scene), (free_func_t) free);
     for(size_t i = 0; i < scene_bodies(scene); i++){
-        for(size_t j = i + 1; j < scene_bodies(scene); j++) {
-            create_newtonian_gravity(scene, G, scene_get_body(scene, i), scene_get_body(scene, j));
-        }
+        list_add(stars, scene_get_body(scene, i));
     }
+    create_gravity_field(scene, G, THETA, stars);
     
     //runs untill the window closes
     while (!sdl_is_done(scene)) {
         double dt = time_since_last_tick();
-        scene_tick(scene, dt);
+        scene_step_fixed(scene, dt, PHYSICS_STEP, MAX_SUBSTEPS);
         sdl_render_scene(scene);
     }
     scene_free(scene);
+    job_system_free(jobs);
     return 0;
 }
\ No newline at end of file
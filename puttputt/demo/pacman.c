@@ -10,6 +10,8 @@
 #include "vector.h"
 
 const vector_t MAX_CANVAS_SIZE = {.x=1000, .y=500};
+const double PHYSICS_STEP = 1.0 / 240;
+const size_t MAX_SUBSTEPS = 16;
 const double PELLET_SIZE = 7;
 const double PACMAN_SIZE = 50;
 const double PELLET_TIME = 0.5;
@@ -214,7 +216,7 @@ int main(int argc, char *argv[]) {
         eat_pellet(scene);
         offscreen(scene);
 
-        scene_tick(scene, dt);
+        scene_step_fixed(scene, dt, PHYSICS_STEP, MAX_SUBSTEPS);
 
         sdl_render_scene(scene);
     }
@@ -2,10 +2,12 @@
 #include <stdio.h>
 #include <math.h>
 #include <time.h>
+#include <unistd.h>
 #include "forces.h"
 #include "polygon.h"
 #include "scene.h"
 #include "sdl_wrapper.h"
+#include "job_system.h"
 
 #define CIRCLE_POINTS 40
 
@@ -28,6 +30,10 @@
 #define START_VELOCITY ((vector_t) {.x = 0.0, .y = -8.0})
 
 #define BALL_MASS 2.0
+#define CONTACT_SLOP 0.01 // m
+#define BOUNCE_SPEED 0.5 // m / s
+#define PHYSICS_STEP (1.0 / 240) // s
+#define MAX_SUBSTEPS 16
 
 #define BALL_COLOR ((rgb_color_t) {1, 0, 0})
 #define PEG_COLOR ((rgb_color_t) {0, 1, 0})
@@ -80,20 +86,6 @@ list_t *rect_init(double width, double height) {
     return rect;
 }
 
-/** Constructs a circles with the given radius centered at (0, 0) */
-list_t *circle_init(double radius) {
-    list_t *circle = list_init(CIRCLE_POINTS, free);
-    double arc_angle = 2 * M_PI / CIRCLE_POINTS;
-    vector_t point = {.x = radius, .y = 0.0};
-    for (size_t i = 0; i < CIRCLE_POINTS; i++) {
-        vector_t *v = malloc(sizeof(*v));
-        *v = point;
-        list_add(circle, v);
-        point = vec_rotate(point, arc_angle);
-    }
-    return circle;
-}
-
 /** Computes the center of the peg in the given row and column */
 vector_t get_peg_center(size_t row, size_t col) {
     vector_t center = {
@@ -123,16 +115,15 @@ void add_gravity_body(scene_t *scene) {
 
 /** Creates a ball with the given starting position and velocity */
 body_t *get_ball(vector_t center, vector_t velocity) {
-    list_t *shape = circle_init(BALL_RADIUS);
-    body_t *ball = body_init_with_info(
-        shape,
+    body_t *ball = body_init_circle(
+        center,
+        BALL_RADIUS,
+        CIRCLE_POINTS,
         BALL_MASS,
         BALL_COLOR,
         make_type_info(BALL),
         free
     );
-
-    body_set_centroid(ball, center);
     body_set_velocity(ball, velocity);
 
     return ball;
@@ -199,15 +190,15 @@ void add_pegs(scene_t *scene) {
     // Add N_ROWS and N_COLS of pegs.
     for (size_t i = 1; i <= N_ROWS; i++) {
         for (size_t j = 0; j <= i; j++) {
-            list_t *polygon = circle_init(PEG_RADIUS);
-            body_t *body = body_init_with_info(
-                polygon,
+            body_t *body = body_init_circle(
+                get_peg_center(i, j),
+                PEG_RADIUS,
+                CIRCLE_POINTS,
                 INFINITY,
                 PEG_COLOR,
                 make_type_info(WALL),
                 free
             );
-            body_set_centroid(body, get_peg_center(i, j));
             scene_add_body(scene, body);
         }
     }
@@ -248,6 +239,11 @@ int main(void) {
     // Initialize scene
     sdl_init(VEC_ZERO, MAX);
     scene_t *scene = scene_init();
+    contact_solver_set_tolerances(scene_get_contact_solver(scene), CONTACT_SLOP, BOUNCE_SPEED);
+    // Spread the gravity on the balls and their motion over every core
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    job_system_t *jobs = job_system_init(cores > 1 ? (size_t) cores : 1);
+    scene_set_job_system(scene, jobs);
 
     // Add elements to the scene
     add_gravity_body(scene);
@@ -266,10 +262,11 @@ int main(void) {
             time_since_drop = 0.0;
         }
 
-        scene_tick(scene, dt);
+        scene_step_fixed(scene, dt, PHYSICS_STEP, MAX_SUBSTEPS);
         sdl_render_scene(scene);
     }
 
     // Clean up scene
     scene_free(scene);
+    job_system_free(jobs);
 }
\ No newline at end of file
@@ -12,6 +12,8 @@
 #include "vector.h"
 
 const vector_t MAX_CANVAS_SIZE = {.x=800, .y=800};
+const double PHYSICS_STEP = 1.0 / 240;
+const size_t MAX_SUBSTEPS = 16;
 const double BULLET_SIZE = 7;
 const double INVADER_SIZE = 30;
 const double PLAYER_SIZE = 20;
@@ -254,7 +256,7 @@ int main(int argc, char *argv[]) {
             out_bounds(scene_get_body(scene, i));
         }
 
-        scene_tick(scene, dt);
+        scene_step_fixed(scene, dt, PHYSICS_STEP, MAX_SUBSTEPS);
         sdl_render_scene(scene);
     }
     scene_free(scene);
@@ -0,0 +1,75 @@
+#ifndef __AABB_H__
+#define __AABB_H__
+
+#include <stdbool.h>
+#include "vector.h"
+
+/**
+ * An axis-aligned bounding box.
+ * aabb_t is defined here because it is passed *by value*, like vector_t.
+ */
+typedef struct {
+    /** The bottom left corner of the box */
+    vector_t min;
+    /** The top right corner of the box */
+    vector_t max;
+} aabb_t;
+
+/**
+ * Returns whether two boxes overlap.
+ * Boxes that only touch along an edge count as overlapping,
+ * matching how find_collision() treats touching shapes.
+ *
+ * @param box1 the first box
+ * @param box2 the second box
+ * @return whether the boxes share at least one point
+ */
+bool aabb_overlap(aabb_t box1, aabb_t box2);
+
+/**
+ * Computes the smallest box containing both boxes.
+ *
+ * @param box1 the first box
+ * @param box2 the second box
+ * @return the union of the boxes
+ */
+aabb_t aabb_union(aabb_t box1, aabb_t box2);
+
+/**
+ * Returns whether the outer box completely contains the inner box.
+ *
+ * @param outer the containing box
+ * @param inner the contained box
+ * @return whether inner lies inside outer
+ */
+bool aabb_contains(aabb_t outer, aabb_t inner);
+
+/**
+ * Grows a box by the given margin in every direction.
+ *
+ * @param box the box to grow
+ * @param margin the distance to move each side outwards
+ * @return the grown box
+ */
+aabb_t aabb_expand(aabb_t box, double margin);
+
+/**
+ * Computes the perimeter of a box.
+ * Used to estimate how costly a box is to search in a bounding volume tree.
+ *
+ * @param box the box to measure
+ * @return twice the sum of the box's width and height
+ */
+double aabb_perimeter(aabb_t box);
+
+/**
+ * A function called once for each pair of overlapping boxes
+ * found by a broadphase.
+ *
+ * @param item1 the item inserted with the first box
+ * @param item2 the item inserted with the second box
+ * @param aux an auxiliary value passed to the search
+ */
+typedef void (*pair_handler_t)(void *item1, void *item2, void *aux);
+
+#endif // #ifndef __AABB_H__
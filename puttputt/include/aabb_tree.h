@@ -0,0 +1,181 @@
+#ifndef __AABB_TREE_H__
+#define __AABB_TREE_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "aabb.h"
+
+/**
+ * A dynamic bounding volume hierarchy: a balanced binary tree of boxes
+ * where every internal node's box contains the boxes of its children.
+ * Each leaf stores an item (e.g. a body) with a "fat" copy of its box,
+ * grown by a margin, so that small movements do not change the tree.
+ */
+typedef struct aabb_tree aabb_tree_t;
+
+/**
+ * A function called for each item whose box overlaps a query box.
+ *
+ * @param item the item inserted with the overlapping box
+ * @param aux the auxiliary value passed to aabb_tree_query()
+ * @return whether the query should keep looking for more items
+ */
+typedef bool (*aabb_query_handler_t)(void *item, void *aux);
+
+/**
+ * Allocates memory for an empty tree.
+ * Asserts that the required memory was allocated.
+ *
+ * @param margin how far the fat box of each leaf extends past its real box
+ * @return a pointer to the newly allocated tree
+ */
+aabb_tree_t *aabb_tree_init(double margin);
+
+/**
+ * Releases the memory allocated for a tree.
+ * Does not free the items stored in it.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ */
+void aabb_tree_free(aabb_tree_t *tree);
+
+/**
+ * Copies a tree, e.g. for a copy of its scene.
+ * Every item keeps its proxy, and stays the same item until aabb_tree_set_item() replaces it.
+ * Asserts that the required memory was allocated.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @return a pointer to the newly allocated copy
+ */
+aabb_tree_t *aabb_tree_clone(aabb_tree_t *tree);
+
+/**
+ * Gets the number of items in a tree.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @return the number of items inserted and not yet removed
+ */
+size_t aabb_tree_size(aabb_tree_t *tree);
+
+/**
+ * Gets the height of a tree, i.e. the length of its longest branch.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @return the height of the root, or 0 if the tree is empty
+ */
+size_t aabb_tree_height(aabb_tree_t *tree);
+
+/**
+ * Adds an item to a tree.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @param item the value reported back for this box, e.g. a body
+ * @param box the bounding box of the item
+ * @return a proxy identifying the item in the tree, which stays
+ *   the same until the item is removed
+ */
+size_t aabb_tree_insert(aabb_tree_t *tree, void *item, aabb_t box);
+
+/**
+ * Removes an item from a tree.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @param proxy the value returned when the item was inserted
+ */
+void aabb_tree_remove(aabb_tree_t *tree, size_t proxy);
+
+/**
+ * Updates the box of an item.
+ * The item is only moved within the tree if the new box
+ * is no longer inside its fat box.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @param proxy the value returned when the item was inserted
+ * @param box the new bounding box of the item
+ * @return whether the item had to be reinserted
+ */
+bool aabb_tree_move(aabb_tree_t *tree, size_t proxy, aabb_t box);
+
+/**
+ * Gets the item stored for a proxy.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @param proxy the value returned when the item was inserted
+ * @return the item passed to aabb_tree_insert()
+ */
+void *aabb_tree_get_item(aabb_tree_t *tree, size_t proxy);
+
+/**
+ * Replaces the item stored for a proxy, keeping its boxes.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @param proxy the value returned when the old item was inserted
+ * @param item the item to store instead
+ */
+void aabb_tree_set_item(aabb_tree_t *tree, size_t proxy, void *item);
+
+/**
+ * Gets the bounding box last given for an item.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @param proxy the value returned when the item was inserted
+ * @return the box passed to aabb_tree_insert() or aabb_tree_move()
+ */
+aabb_t aabb_tree_get_bounds(aabb_tree_t *tree, size_t proxy);
+
+/**
+ * Gets the fat box that an item is stored with.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @param proxy the value returned when the item was inserted
+ * @return the box the item can move within without being reinserted
+ */
+aabb_t aabb_tree_get_fat_bounds(aabb_tree_t *tree, size_t proxy);
+
+/**
+ * Calls a handler for every item whose bounding box overlaps a query box.
+ * The handler must not modify the tree.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @param box the box to search
+ * @param handler the function to call with each overlapping item
+ * @param aux an auxiliary value to pass to the handler
+ */
+void aabb_tree_query(aabb_tree_t *tree, aabb_t box, aabb_query_handler_t handler, void *aux);
+
+/**
+ * Calls a handler once for every pair of items whose bounding boxes overlap.
+ * The tree keeps the pairs whose fat boxes overlap between calls, and only
+ * searches again for the items inserted or reinserted since the last call.
+ * Pairs are reported in a deterministic order for a given sequence
+ * of inserts, removals and moves. The handler must not modify the tree.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @param handler the function to call with each overlapping pair
+ * @param aux an auxiliary value to pass to the handler
+ * @return the number of pairs reported
+ */
+size_t aabb_tree_find_pairs(aabb_tree_t *tree, pair_handler_t handler, void *aux);
+
+/**
+ * Copies the layout of a tree into a snapshot, so that restoring it
+ * makes later queries report the same items in the same order.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @param buffer where to write the snapshot, or NULL to only measure it
+ * @return the number of bytes written
+ */
+size_t aabb_tree_snapshot(aabb_tree_t *tree, void *buffer);
+
+/**
+ * Puts a tree back the way a snapshot of it found it.
+ * The tree must hold the same items as when the snapshot was taken,
+ * and must not have shrunk below the size it had then.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @param buffer a snapshot written by aabb_tree_snapshot()
+ * @return the number of bytes read
+ */
+size_t aabb_tree_restore(aabb_tree_t *tree, const void *buffer);
+
+#endif // #ifndef __AABB_TREE_H__
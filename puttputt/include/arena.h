@@ -0,0 +1,59 @@
+#ifndef __ARENA_H__
+#define __ARENA_H__
+
+#include <stddef.h>
+
+/**
+ * A bump-pointer allocator for memory that only lives for one tick or frame.
+ * Allocating moves a pointer forward through a block of memory,
+ * and everything is released at once with arena_reset().
+ * Individual allocations are never freed.
+ */
+typedef struct arena arena_t;
+
+/**
+ * Allocates memory for an empty arena.
+ * Asserts that the required memory was allocated.
+ *
+ * @param initial_size the number of bytes to allocate space for
+ * @return a pointer to the newly allocated arena
+ */
+arena_t *arena_init(size_t initial_size);
+
+/**
+ * Releases the memory allocated for an arena,
+ * including everything allocated from it.
+ *
+ * @param arena a pointer to an arena returned from arena_init()
+ */
+void arena_free(arena_t *arena);
+
+/**
+ * Allocates memory from an arena, aligned for any type.
+ * The memory stays valid until the arena is reset or freed.
+ * If the arena is full, it grows, and asserts that the growth succeeded.
+ *
+ * @param arena a pointer to an arena returned from arena_init()
+ * @param size the number of bytes to allocate
+ * @return a pointer to the allocated memory
+ */
+void *arena_alloc(arena_t *arena, size_t size);
+
+/**
+ * Releases everything allocated from an arena so its memory can be reused.
+ * If the arena had to grow since the last reset, its blocks are merged
+ * into one big enough for all of them, so a steady workload stops calling malloc.
+ *
+ * @param arena a pointer to an arena returned from arena_init()
+ */
+void arena_reset(arena_t *arena);
+
+/**
+ * Gets the number of bytes allocated from an arena since it was last reset.
+ *
+ * @param arena a pointer to an arena returned from arena_init()
+ * @return the number of bytes in use, including alignment padding
+ */
+size_t arena_used(arena_t *arena);
+
+#endif // #ifndef __ARENA_H__
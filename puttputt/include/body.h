@@ -3,18 +3,35 @@
 
 #include <SDL2/SDL_image.h>
 #include <stdbool.h>
+#include "aabb.h"
+#include "polygon.h"
+#include "body_store.h"
+#include "pool.h"
 #include "color.h"
 #include "list.h"
 #include "vector.h"
 
 /**
  * A rigid body constrained to the plane.
- * Implemented as a polygon with uniform density.
+ * Implemented as a polygon with uniform density, or as a circle or capsule
+ * with an exact outline and a polygon approximating it for drawing.
  * Bodies can accumulate forces and impulses during each tick.
  * Angular physics (i.e. torques) are not currently implemented.
  */
 typedef struct body body_t;
 
+/**
+ * The kinds of outline a body can have.
+ * Collisions involving a circle are computed exactly from its radius;
+ * the other pairs are tested on the bodies' polygons.
+ */
+typedef enum {
+    SHAPE_POLYGON,
+    SHAPE_CIRCLE,
+    /** every point within a radius of a line segment, e.g. a thick wall */
+    SHAPE_CAPSULE
+} shape_kind_t;
+
 /**
  * Initializes a body without any info.
  * Acts like body_init_with_info() where info and info_freer are NULL.
@@ -26,7 +43,8 @@ body_t *body_init(list_t *shape, double mass, rgb_color_t color);
  * The body is initially at rest.
  * Asserts that the mass is positive and that the required memory is allocated.
  *
- * @param shape a list of vectors describing the initial shape of the body
+ * @param shape a list of vectors describing the initial shape of the body.
+ *   The body copies the vectors and frees the list.
  * @param mass the mass of the body (if INFINITY, stops the body from moving)
  * @param color the color of the body, used to draw it on the screen
  * @param info additional information to associate with the body,
@@ -42,6 +60,72 @@ body_t *body_init_with_info(
     free_func_t info_freer
 );
 
+/**
+ * Allocates memory for a body whose shape is already a polygon_t.
+ * Acts like body_init_with_info(), which converts its list of vectors
+ * into a polygon_t and frees the list.
+ *
+ * @param shape the initial shape of the body; the body takes ownership of it
+ * @param mass the mass of the body (if INFINITY, stops the body from moving)
+ * @param color the color of the body, used to draw it on the screen
+ * @param info additional information to associate with the body
+ * @param info_freer if non-NULL, a function call on the info to free it
+ * @return a pointer to the newly allocated body
+ */
+body_t *body_init_polygon(
+    polygon_t *shape,
+    double mass,
+    rgb_color_t color,
+    void *info,
+    free_func_t info_freer
+);
+
+/**
+ * Allocates memory for a circular body.
+ * Acts like body_init_polygon(), but collisions use the exact circle.
+ *
+ * @param center the center of the circle, which is the body's centroid
+ * @param radius the radius of the circle
+ * @param points the number of vertices in the polygon used to draw the circle
+ * @param mass the mass of the body (if INFINITY, stops the body from moving)
+ * @param color the color of the body, used to draw it on the screen
+ * @param info additional information to associate with the body
+ * @param info_freer if non-NULL, a function call on the info to free it
+ * @return a pointer to the newly allocated body
+ */
+body_t *body_init_circle(
+    vector_t center,
+    double radius,
+    size_t points,
+    double mass,
+    rgb_color_t color,
+    void *info,
+    free_func_t info_freer
+);
+
+/**
+ * Allocates memory for a capsule: the points within radius of the segment from start to end.
+ * Its centroid is the middle of the segment, and the segment turns with the body.
+ *
+ * @param start one end of the segment
+ * @param end the other end of the segment
+ * @param radius the distance from the segment to the outline
+ * @param mass the mass of the body (if INFINITY, stops the body from moving)
+ * @param color the color of the body, used to draw it on the screen
+ * @param info additional information to associate with the body
+ * @param info_freer if non-NULL, a function call on the info to free it
+ * @return a pointer to the newly allocated body
+ */
+body_t *body_init_capsule(
+    vector_t start,
+    vector_t end,
+    double radius,
+    double mass,
+    rgb_color_t color,
+    void *info,
+    free_func_t info_freer
+);
+
 /**
  * Releases the memory allocated for a body.
  *
@@ -49,6 +133,14 @@ body_t *body_init_with_info(
  */
 void body_free(body_t *body);
 
+/**
+ * Gets the pool that every body is allocated from.
+ * pool_live() and pool_peak() on it report how many bodies exist.
+ *
+ * @return the body pool, which lives for the whole program
+ */
+pool_t *body_get_pool(void);
+
 /**
  * Gets the current shape of a body.
  * Returns a newly allocated vector list, which must be list_free()d.
@@ -58,6 +150,40 @@ void body_free(body_t *body);
  */
 list_t *body_get_shape(body_t *body);
 
+/**
+ * Gets the current shape of a body as a polygon_t.
+ * Returns a newly allocated polygon, which must be polygon_free()d.
+ * Copies the vertices with a single allocation, unlike body_get_shape().
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the polygon describing the body's current position
+ */
+polygon_t *body_get_polygon(body_t *body);
+
+/**
+ * Gets the current vertices of a body without copying them.
+ * The array belongs to the body and must not be modified or freed.
+ * It is only valid until the body is next moved, rotated or freed.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param count set to the number of vertices in the array
+ * @return the vertices describing the body's current position
+ */
+const vector_t *body_shape_view(body_t *body, size_t *count);
+
+/**
+ * Gets the unit normals of a body's current edges, and its extent along each,
+ * as computed by find_edge_axes() on body_shape_view().
+ * They are derived from ones computed when the body was created,
+ * so they are only rotated when the body turns, and never for static bodies.
+ * The arrays belong to the body, like the one returned from body_shape_view().
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param intervals set to the body's extent along each normal, as (min, max)
+ * @return the normals, one per vertex returned from body_shape_view()
+ */
+const vector_t *body_axes_view(body_t *body, const vector_t **intervals);
+
 /**
  * Gets the current center of mass of a body.
  * While this could be calculated with polygon_centroid(), that becomes too slow
@@ -69,6 +195,49 @@ list_t *body_get_shape(body_t *body);
  */
 vector_t body_get_centroid(body_t *body);
 
+/**
+ * Gets the kind of outline a body has.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return SHAPE_POLYGON, SHAPE_CIRCLE or SHAPE_CAPSULE
+ */
+shape_kind_t body_get_shape_kind(body_t *body);
+
+/**
+ * Gets the radius of a circle or capsule.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the radius, or 0 for a polygon
+ */
+double body_get_radius(body_t *body);
+
+/**
+ * Gets the current ends of a capsule's segment.
+ * For a circle or polygon, both ends are the centroid.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param start set to the first end of the segment
+ * @param end set to the second end of the segment
+ */
+void body_get_segment(body_t *body, vector_t *start, vector_t *end);
+
+/**
+ * Gets where a body's center of mass was before the scene's last fixed step
+ * (see scene_step_fixed()), for drawing it between its previous and current positions.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the body's previous center of mass, or its current one if it is not in a scene
+ */
+vector_t body_get_previous_centroid(body_t *body);
+
+/**
+ * Gets the smallest axis-aligned box containing a body's current shape.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the bounding box of the body
+ */
+aabb_t body_get_bounds(body_t *body);
+
 /**
  * Gets the current velocity of a body.
  *
@@ -132,16 +301,28 @@ void body_swap_color(body_t *body);
 /**
  * Translates a body to a new position.
  * The position is specified by the position of the body's center of mass.
+ * The body's previous centroid moves with it, so it is not drawn in between.
+ * Wakes the body up if it is asleep, unless it is already at x.
  *
  * @param body a pointer to a body returned from body_init()
  * @param x the body's new centroid
  */
-
-
 void body_set_centroid(body_t *body, vector_t x);
 
+/**
+ * Moves a body by an offset, e.g. to scroll everything in a scene at once.
+ * Unlike body_set_centroid(), the previous centroid moves by the same offset,
+ * so a moving body is still drawn partway along its path.
+ * Wakes the body up if it is asleep, unless the offset is zero.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param offset how far to move the body
+ */
+void body_translate(body_t *body, vector_t offset);
+
 /**
  * Changes a body's velocity (the time-derivative of its position).
+ * Wakes the body up if it is asleep, unless the new velocity is zero.
  *
  * @param body a pointer to a body returned from body_init()
  * @param v the body's new velocity
@@ -152,12 +333,30 @@ void body_set_velocity(body_t *body, vector_t v);
  * Changes a body's orientation in the plane.
  * The body is rotated about its center of mass.
  * Note that the angle is *absolute*, not relative to the current orientation.
+ * Wakes the body up if it is asleep.
  *
  * @param body a pointer to a body returned from body_init()
  * @param angle the body's new angle in radians. Positive is counterclockwise.
  */
 void body_set_rotation(body_t *body, double angle);
 
+/**
+ * Gets how far a body has been rotated in total by body_set_rotation().
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the body's angle in radians
+ */
+double body_get_angle(body_t *body);
+
+/**
+ * Sets the total angle a body has been rotated by, e.g. to put it back the way it was.
+ * Unlike body_set_rotation(), leaves a sleeping body asleep.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param angle the body's angle in radians
+ */
+void body_set_angle(body_t *body, double angle);
+
 /**
  * Applies a force to a body over the current tick.
  * If multiple forces are applied in the same tick, they should be added.
@@ -174,6 +373,7 @@ void body_add_force(body_t *body, vector_t force);
  * which is useful for modeling collisions.
  * If multiple impulses are applied in the same tick, they should be added.
  * Should not change the body's position or velocity; see body_tick().
+ * Wakes the body up if it is asleep.
  *
  * @param body a pointer to a body returned from body_init()
  * @param impulse the impulse vector to apply
@@ -199,6 +399,42 @@ void body_hide(body_t *body);
 
 bool body_is_hidden(body_t *body);
 
+/**
+ * Marks a body as fast-moving, so that each tick it stops at the first
+ * static body it would bounce off (see create_physics_collision()),
+ * instead of possibly passing through it when it moves further than the body is thick.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param bullet whether the body's motion should be swept
+ */
+void body_set_bullet(body_t *body, bool bullet);
+
+/**
+ * Gets whether a body's motion is swept, as set by body_set_bullet().
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return whether the body is a bullet
+ */
+bool body_is_bullet(body_t *body);
+
+/**
+ * Gets whether a body has been put to sleep by its scene (see scene_enable_sleeping()).
+ * A sleeping body does not move, and forces between sleeping or static bodies are skipped.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return whether the body is asleep
+ */
+bool body_is_asleep(body_t *body);
+
+/**
+ * Wakes a body up, so it moves on the next tick.
+ * The bodies it is touching or connected to by forces wake up with it.
+ * Does nothing if the body is not in a scene.
+ *
+ * @param body a pointer to a body returned from body_init()
+ */
+void body_wake(body_t *body);
+
 /**
  * Marks a body for removal--future calls to body_is_removed() will return true.
  * Does not free the body.
@@ -218,9 +454,86 @@ void body_remove(body_t *body);
  */
 bool body_is_removed(body_t *body);
 
+/**
+ * Moves a body's physics state into a store, which is where
+ * its accessors read and write it from then on.
+ * Called by the scene when the body is added to it.
+ * Asserts that the body is not already in a store.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param store the store to keep the body's state in
+ */
+void body_attach(body_t *body, body_store_t *store);
+
+/**
+ * Makes a copy of a body for a copy of its scene, e.g. one made by scene_clone().
+ * The copy gets its own physics state in a copy of the body's store, in the same slot,
+ * and takes that slot over from the original; its proxy is the same as well.
+ * Everything else starts out the same as the original's.
+ * The two bodies share their shape until one of them moves or turns, so still bodies never copy it.
+ * They also share their info and texture, which still belong to the original.
+ * Either body can be freed first, on any thread.
+ * Asserts that the body is in a store.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param store a copy of the body's store, made by body_store_clone()
+ * @return a pointer to the newly allocated copy
+ */
+body_t *body_clone(body_t *body, body_store_t *store);
+
+/**
+ * Gets the store holding a body's state.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the store passed to body_attach(), or NULL if it has not been attached
+ */
+body_store_t *body_get_store(body_t *body);
+
+/**
+ * Gets the slot holding a body's state in its store.
+ * Asserts that the body has been attached to a store.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the body's index into the store's arrays
+ */
+size_t body_get_slot(body_t *body);
+
+/**
+ * Records that a body's state was moved to another slot in its store,
+ * e.g. after body_store_remove() returned the body.
+ *
+ * @param body a pointer to a body in a store
+ * @param slot the body's new index into the store's arrays
+ */
+void body_set_slot(body_t *body, size_t slot);
+
+/**
+ * Gets the proxy identifying a body in its scene's bounding volume tree.
+ * Only meaningful once the body has been added to a scene.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the value last passed to body_set_proxy()
+ */
+size_t body_get_proxy(body_t *body);
+
+/**
+ * Records where a scene stored a body in its bounding volume tree.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param proxy the proxy returned from aabb_tree_insert()
+ */
+void body_set_proxy(body_t *body, size_t proxy);
+
 int body_get_orientation(body_t *body);
 
 void body_set_orientation(body_t *body, int orientation);
-SDL_Rect *body_get_rect(body_t *body);
+
+/**
+ * Gets the smallest rectangle containing a body's current shape.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the rectangle, with (x, y) at its minimum corner
+ */
+SDL_Rect body_get_rect(body_t *body);
 
 #endif // #ifndef __BODY_H__
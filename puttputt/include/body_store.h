@@ -0,0 +1,235 @@
+#ifndef __BODY_STORE_H__
+#define __BODY_STORE_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "vector.h"
+
+/**
+ * Contiguous storage for the physics state of the bodies in a scene.
+ * Each quantity lives in its own array (centroids, velocities, ...),
+ * indexed by a slot, so loops over every body read memory in order.
+ * Removing a body moves the last body into its slot.
+ */
+typedef struct body_store body_store_t;
+
+/**
+ * Allocates memory for an empty body store.
+ * Asserts that the required memory was allocated.
+ *
+ * @param initial_size the number of bodies to allocate space for
+ * @return a pointer to the newly allocated store
+ */
+body_store_t *body_store_init(size_t initial_size);
+
+/**
+ * Releases the memory allocated for a body store.
+ * Does not free the bodies that own its slots.
+ *
+ * @param store a pointer to a store returned from body_store_init()
+ */
+void body_store_free(body_store_t *store);
+
+/**
+ * Copies a body store, e.g. for a copy of its scene.
+ * Every body keeps its slot, and its owner until body_store_set_owner() gives it a new one.
+ * Asserts that the required memory was allocated.
+ *
+ * @param store a pointer to a store returned from body_store_init()
+ * @return a pointer to the newly allocated copy
+ */
+body_store_t *body_store_clone(body_store_t *store);
+
+/**
+ * Gets the number of occupied slots in a store.
+ *
+ * @param store a pointer to a store returned from body_store_init()
+ * @return the number of bodies in the store
+ */
+size_t body_store_size(body_store_t *store);
+
+/**
+ * Adds a body's state to the end of a store.
+ *
+ * @param store a pointer to a store returned from body_store_init()
+ * @param owner the body the slot belongs to
+ * @param centroid the body's center of mass
+ * @param velocity the body's velocity
+ * @param mass the body's mass, which is INFINITY for immovable bodies
+ * @return the slot the state was stored in
+ */
+size_t body_store_add(
+    body_store_t *store,
+    void *owner,
+    vector_t centroid,
+    vector_t velocity,
+    double mass
+);
+
+/**
+ * Removes the state in a slot, moving the state in the last slot into it.
+ *
+ * @param store a pointer to a store returned from body_store_init()
+ * @param slot the slot to empty
+ * @return the owner of the state that moved into the slot,
+ *   or NULL if the removed slot was the last one
+ */
+void *body_store_remove(body_store_t *store, size_t slot);
+
+/**
+ * Gets the body that owns a slot.
+ *
+ * @param store a pointer to a store returned from body_store_init()
+ * @param slot an occupied slot
+ * @return the owner passed to body_store_add()
+ */
+void *body_store_get_owner(body_store_t *store, size_t slot);
+
+/**
+ * Gives a slot a new owner, e.g. the copy of a body in a cloned store.
+ *
+ * @param store a pointer to a store returned from body_store_init()
+ * @param slot an occupied slot
+ * @param owner the body the slot now belongs to
+ */
+void body_store_set_owner(body_store_t *store, size_t slot, void *owner);
+
+/**
+ * Gets the array of centroids, indexed by slot.
+ * The array may move when bodies are added.
+ *
+ * @param store a pointer to a store returned from body_store_init()
+ * @return the centroid of each body in the store
+ */
+vector_t *body_store_centroids(body_store_t *store);
+
+/**
+ * Gets the array of centroids as they were when body_store_save_previous() was last called,
+ * indexed by slot. A body added since then has its current centroid.
+ * The array may move when bodies are added.
+ *
+ * @param store a pointer to a store returned from body_store_init()
+ * @return the previous centroid of each body in the store
+ */
+vector_t *body_store_previous_centroids(body_store_t *store);
+
+/**
+ * Copies every body's current centroid into its previous centroid,
+ * e.g. before a step, so drawing can blend between the two.
+ *
+ * @param store a pointer to a store returned from body_store_init()
+ */
+void body_store_save_previous(body_store_t *store);
+
+/**
+ * Gets the array of velocities, indexed by slot.
+ *
+ * @param store a pointer to a store returned from body_store_init()
+ * @return the velocity of each body in the store
+ */
+vector_t *body_store_velocities(body_store_t *store);
+
+/**
+ * Gets the array of forces accumulated over the current tick, indexed by slot.
+ *
+ * @param store a pointer to a store returned from body_store_init()
+ * @return the total force on each body in the store
+ */
+vector_t *body_store_forces(body_store_t *store);
+
+/**
+ * Gets the array of impulses accumulated over the current tick, indexed by slot.
+ *
+ * @param store a pointer to a store returned from body_store_init()
+ * @return the total impulse on each body in the store
+ */
+vector_t *body_store_impulses(body_store_t *store);
+
+/**
+ * Gets the array of masses, indexed by slot.
+ *
+ * @param store a pointer to a store returned from body_store_init()
+ * @return the mass of each body in the store
+ */
+double *body_store_masses(body_store_t *store);
+
+/**
+ * Gets the array of inverse masses, indexed by slot.
+ *
+ * @param store a pointer to a store returned from body_store_init()
+ * @return 1 / the mass of each body in the store
+ */
+double *body_store_inverse_masses(body_store_t *store);
+
+/**
+ * Gets the array of flags for which bodies are asleep, indexed by slot.
+ * A sleeping body is not moved by body_store_integrate().
+ *
+ * @param store a pointer to a store returned from body_store_init()
+ * @return whether each body in the store is asleep
+ */
+bool *body_store_asleep(body_store_t *store);
+
+/**
+ * Gets the array counting how many ticks in a row each body has been nearly still,
+ * indexed by slot. The scene uses it to decide when bodies go to sleep.
+ *
+ * @param store a pointer to a store returned from body_store_init()
+ * @return the number of still ticks of each body in the store
+ */
+size_t *body_store_still_ticks(body_store_t *store);
+
+/**
+ * Wakes a body up and restarts its count of still ticks.
+ *
+ * @param store a pointer to a store returned from body_store_init()
+ * @param slot the body's slot
+ */
+void body_store_wake(body_store_t *store, size_t slot);
+
+/**
+ * Moves every body in a store over a time interval, like body_tick().
+ * Sleeping bodies stay put, and the forces and impulses on them are dropped.
+ * Applies the accumulated forces and impulses, translates each centroid
+ * by the average of the old and new velocities, and resets the
+ * forces and impulses.
+ *
+ * @param store a pointer to a store returned from body_store_init()
+ * @param dt the number of seconds elapsed since the last tick
+ */
+void body_store_integrate(body_store_t *store, double dt);
+
+/**
+ * Moves the bodies in a range of slots, like body_store_integrate().
+ * Each body only depends on its own slot, so separate ranges can be moved by different threads.
+ *
+ * @param store a pointer to a store returned from body_store_init()
+ * @param dt the number of seconds elapsed since the last tick
+ * @param start the first slot to move
+ * @param end one past the last slot to move
+ */
+void body_store_integrate_range(body_store_t *store, double dt, size_t start, size_t end);
+
+/**
+ * Copies the motion of every body in a store into a snapshot:
+ * centroids, velocities, accumulated forces and impulses, and whether each body is asleep.
+ * Masses and owners are left out, since they do not change as the bodies move.
+ *
+ * @param store a pointer to a store returned from body_store_init()
+ * @param buffer where to write the snapshot, or NULL to only measure it
+ * @return the number of bytes written
+ */
+size_t body_store_snapshot(body_store_t *store, void *buffer);
+
+/**
+ * Puts the bodies in a store back the way a snapshot of it found them.
+ * Asserts that the store holds as many bodies as when the snapshot was taken;
+ * they are expected to be the same bodies, in the same slots.
+ *
+ * @param store a pointer to a store returned from body_store_init()
+ * @param buffer a snapshot written by body_store_snapshot()
+ * @return the number of bytes read
+ */
+size_t body_store_restore(body_store_t *store, const void *buffer);
+
+#endif // #ifndef __BODY_STORE_H__
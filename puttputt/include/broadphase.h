@@ -0,0 +1,60 @@
+#ifndef __BROADPHASE_H__
+#define __BROADPHASE_H__
+
+#include <stddef.h>
+#include "aabb.h"
+
+/**
+ * A uniform grid that finds which of a set of boxes overlap.
+ * Each box is filed under every grid cell it covers, so only boxes sharing
+ * a cell are ever compared. Boxes covering too many cells are kept aside
+ * and compared against everything instead.
+ * The grid is meant to be cleared and refilled every tick.
+ */
+typedef struct broadphase broadphase_t;
+
+/**
+ * Allocates memory for an empty broadphase grid.
+ * Asserts that the required memory was allocated.
+ *
+ * @return a pointer to the newly allocated grid
+ */
+broadphase_t *broadphase_init(void);
+
+/**
+ * Releases the memory allocated for a broadphase grid.
+ *
+ * @param broadphase a pointer to a grid returned from broadphase_init()
+ */
+void broadphase_free(broadphase_t *broadphase);
+
+/**
+ * Removes all boxes from the grid and sets the size of its cells.
+ * A good cell size is about twice the size of the moving boxes.
+ *
+ * @param broadphase a pointer to a grid returned from broadphase_init()
+ * @param cell_size the width and height of each grid cell
+ */
+void broadphase_clear(broadphase_t *broadphase, double cell_size);
+
+/**
+ * Adds a box to the grid.
+ *
+ * @param broadphase a pointer to a grid returned from broadphase_init()
+ * @param item the value reported back for this box, e.g. a body
+ * @param box the bounding box of the item
+ */
+void broadphase_insert(broadphase_t *broadphase, void *item, aabb_t box);
+
+/**
+ * Calls a handler once for every pair of inserted boxes that overlap.
+ * Pairs are reported in a deterministic order for a given insertion order.
+ *
+ * @param broadphase a pointer to a grid returned from broadphase_init()
+ * @param handler the function to call with each overlapping pair
+ * @param aux an auxiliary value to pass to the handler
+ * @return the number of pairs reported
+ */
+size_t broadphase_find_pairs(broadphase_t *broadphase, pair_handler_t handler, void *aux);
+
+#endif // #ifndef __BROADPHASE_H__
@@ -4,6 +4,8 @@
 #include <stdbool.h>
 #include "list.h"
 #include "vector.h"
+#include "polygon.h"
+#include "body.h"
 
 /**
  * Represents the status of a collision between two shapes.
@@ -19,6 +21,12 @@ typedef struct {
      * If collided is false, this value is undefined.
      */
     vector_t axis;
+    /**
+     * If the shapes are colliding, how far they overlap along the axis,
+     * i.e. how far one would have to move along it to stop touching.
+     * If collided is false, this value is undefined.
+     */
+    double depth;
 } collision_info_t;
 
 /**
@@ -34,4 +42,199 @@ typedef struct {
  */
 collision_info_t find_collision(list_t *shape1, list_t *shape2);
 
+/**
+ * Computes the status of the collision between two convex polygons,
+ * like find_collision(), without copying their vertices.
+ *
+ * @param shape1 the first shape
+ * @param shape2 the second shape
+ * @return whether the shapes are colliding, and if so, the collision axis.
+ * The axis should be a unit vector pointing from shape1 towards shape2.
+ */
+collision_info_t find_polygon_collision(polygon_t *shape1, polygon_t *shape2);
+
+/**
+ * Computes the status of the collision between two convex polygons
+ * given as arrays of vertices, like find_collision().
+ * Works directly on the arrays returned from body_shape_view().
+ *
+ * @param shape1 the vertices of the first shape
+ * @param n1 the number of vertices in shape1
+ * @param shape2 the vertices of the second shape
+ * @param n2 the number of vertices in shape2
+ * @return whether the shapes are colliding, and if so, the collision axis.
+ * The axis should be a unit vector pointing from shape1 towards shape2.
+ */
+collision_info_t find_collision_points(const vector_t *shape1, size_t n1, const vector_t *shape2, size_t n2);
+
+/**
+ * Computes the axes the separating axis test uses for a convex polygon:
+ * the unit normal of each edge, and the polygon's extent along it.
+ * A body keeps these for its own shape, so they are only recomputed when it turns.
+ *
+ * @param shape the vertices of the polygon
+ * @param n the number of vertices in shape
+ * @param normals filled in with n unit normals; normals[i] is perpendicular
+ *   to the edge from vertex i to vertex i + 1
+ * @param intervals filled in with n intervals; intervals[i].x and .y are the smallest
+ *   and largest projections of the vertices onto normals[i]
+ */
+void find_edge_axes(const vector_t *shape, size_t n, vector_t *normals, vector_t *intervals);
+
+/**
+ * Computes the status of the collision between two convex polygons,
+ * like find_collision_points(), with both polygons' axes already computed
+ * by find_edge_axes() (or taken from body_axes_view()).
+ *
+ * @param shape1 the vertices of the first shape
+ * @param n1 the number of vertices in shape1
+ * @param normals1 the edge normals of shape1
+ * @param intervals1 the extent of shape1 along each of normals1
+ * @param shape2 the vertices of the second shape
+ * @param n2 the number of vertices in shape2
+ * @param normals2 the edge normals of shape2
+ * @param intervals2 the extent of shape2 along each of normals2
+ * @return whether the shapes are colliding, and if so, the collision axis.
+ * The axis should be a unit vector pointing from shape1 towards shape2.
+ */
+collision_info_t find_collision_axes(
+    const vector_t *shape1,
+    size_t n1,
+    const vector_t *normals1,
+    const vector_t *intervals1,
+    const vector_t *shape2,
+    size_t n2,
+    const vector_t *normals2,
+    const vector_t *intervals2
+);
+
+/**
+ * Tests one convex polygon against many others, e.g. a ball against nearby walls.
+ * The polygon's own edge normals and its extent along them are computed once
+ * and reused for every other shape.
+ * results[k] matches find_collision_points(shape, n, others[k], counts[k]).
+ *
+ * @param shape the vertices of the shape to test
+ * @param n the number of vertices in shape
+ * @param others the vertices of each shape to test it against
+ * @param counts the number of vertices in each of the other shapes
+ * @param num_others the number of other shapes
+ * @param results filled in with the collision between shape and each other shape
+ */
+void find_collisions(
+    const vector_t *shape,
+    size_t n,
+    const vector_t *const *others,
+    const size_t *counts,
+    size_t num_others,
+    collision_info_t *results
+);
+
+/**
+ * Computes the status of the collision between two circles.
+ * Circles that are just touching count as colliding.
+ *
+ * @param center1 the center of the first circle
+ * @param radius1 the radius of the first circle
+ * @param center2 the center of the second circle
+ * @param radius2 the radius of the second circle
+ * @return whether the circles are colliding, and if so, the collision axis,
+ * which points from center1 towards center2
+ */
+collision_info_t find_circle_collision(vector_t center1, double radius1, vector_t center2, double radius2);
+
+/**
+ * Computes the status of the collision between a circle and a capsule,
+ * by testing the circle against the point on the capsule's segment closest to its center.
+ *
+ * @param center the center of the circle
+ * @param radius the radius of the circle
+ * @param start one end of the capsule's segment
+ * @param end the other end of the capsule's segment
+ * @param capsule_radius the capsule's distance from its segment to its outline
+ * @return whether the shapes are colliding, and if so, the collision axis,
+ * which points from the circle towards the capsule
+ */
+collision_info_t find_circle_capsule_collision(
+    vector_t center,
+    double radius,
+    vector_t start,
+    vector_t end,
+    double capsule_radius
+);
+
+/**
+ * Computes the status of the collision between a circle and a convex polygon,
+ * from the point on the polygon's boundary closest to the circle's center.
+ * The polygon's vertices may be in either order.
+ *
+ * @param center the center of the circle
+ * @param radius the radius of the circle
+ * @param shape the vertices of the polygon
+ * @param n the number of vertices in shape
+ * @return whether the shapes are colliding, and if so, the collision axis,
+ * which points from the circle towards the polygon
+ */
+collision_info_t find_circle_polygon_collision(vector_t center, double radius, const vector_t *shape, size_t n);
+
+/**
+ * Finds when a moving circle first touches a stationary one.
+ * The circle moves in a straight line from start to end over a tick.
+ *
+ * @param start the moving circle's center at the start of the tick
+ * @param end the moving circle's center at the end of the tick
+ * @param radius the radius of the moving circle
+ * @param center the center of the stationary circle
+ * @param other_radius the radius of the stationary circle
+ * @return the fraction of the motion done when they first touch, from 0 to 1,
+ * or INFINITY if they do not touch during the tick
+ */
+double find_circle_toi(vector_t start, vector_t end, double radius, vector_t center, double other_radius);
+
+/**
+ * Finds when a moving circle first touches a stationary capsule, like find_circle_toi().
+ *
+ * @param start the moving circle's center at the start of the tick
+ * @param end the moving circle's center at the end of the tick
+ * @param radius the radius of the moving circle
+ * @param segment_start one end of the capsule's segment
+ * @param segment_end the other end of the capsule's segment
+ * @param capsule_radius the capsule's distance from its segment to its outline
+ * @return the fraction of the motion done when they first touch, from 0 to 1,
+ * or INFINITY if they do not touch during the tick
+ */
+double find_circle_capsule_toi(
+    vector_t start,
+    vector_t end,
+    double radius,
+    vector_t segment_start,
+    vector_t segment_end,
+    double capsule_radius
+);
+
+/**
+ * Finds when a moving circle first touches a stationary convex polygon, like find_circle_toi().
+ *
+ * @param start the moving circle's center at the start of the tick
+ * @param end the moving circle's center at the end of the tick
+ * @param radius the radius of the moving circle
+ * @param shape the vertices of the polygon
+ * @param n the number of vertices in shape
+ * @return the fraction of the motion done when they first touch, from 0 to 1,
+ * or INFINITY if they do not touch during the tick
+ */
+double find_circle_polygon_toi(vector_t start, vector_t end, double radius, const vector_t *shape, size_t n);
+
+/**
+ * Computes the status of the collision between two bodies,
+ * using the exact test for their kinds of shape (see shape_kind_t).
+ * Pairs without a circle are tested with find_collision_points() on their polygons.
+ *
+ * @param body1 the first body
+ * @param body2 the second body
+ * @return whether the bodies are colliding, and if so, the collision axis.
+ * The axis is a unit vector pointing from body1 towards body2.
+ */
+collision_info_t find_body_collision(body_t *body1, body_t *body2);
+
 #endif // #ifndef __COLLISION_H__
@@ -0,0 +1,191 @@
+#ifndef __CONTACT_SOLVER_H__
+#define __CONTACT_SOLVER_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "body.h"
+#include "body_store.h"
+#include "job_system.h"
+#include "vector.h"
+
+/**
+ * Resolves contact between pairs of bodies that should bounce off each other.
+ * Each tick, every registered pair that is touching gets a manifold,
+ * and the solver makes several passes over all of them, adjusting the impulse
+ * on each pair until none are approaching each other.
+ * The impulse a pair ended up with is kept while the bodies stay in contact
+ * and used as the starting point on the next tick, so resting bodies settle
+ * instead of jittering. Any remaining overlap is removed by moving the bodies apart.
+ */
+typedef struct contact_solver contact_solver_t;
+
+/**
+ * The contact between two touching bodies.
+ * Bodies do not rotate from collisions, so one contact point is enough.
+ */
+typedef struct {
+    /** A unit vector pointing from the first body towards the second */
+    vector_t normal;
+    /** How far the bodies overlap along the normal */
+    double depth;
+    /** The point of the second body deepest inside the first */
+    vector_t point;
+    /** The impulse along the normal the solver applied to the second body */
+    double normal_impulse;
+} contact_manifold_t;
+
+/**
+ * Allocates memory for a solver without any pairs.
+ * Asserts that the required memory was allocated.
+ *
+ * @return a pointer to the newly allocated solver
+ */
+contact_solver_t *contact_solver_init(void);
+
+/**
+ * Releases the memory allocated for a solver.
+ * Does not free the bodies in its pairs.
+ *
+ * @param solver a pointer to a solver returned from contact_solver_init()
+ */
+void contact_solver_free(contact_solver_t *solver);
+
+/**
+ * Copies a solver for a copy of its bodies' scene, e.g. one made by scene_clone().
+ * Each pair is copied with everything it remembers between ticks,
+ * on the bodies that own its bodies' slots in the copied store.
+ * Asserts that every pair's bodies are in a store, and that no pairs are marked.
+ *
+ * @param solver a pointer to a solver returned from contact_solver_init()
+ * @param store a copy of the store holding the pairs' bodies, made by body_store_clone(),
+ *   whose slots have been given to the copies of the bodies
+ * @return a pointer to the newly allocated copy
+ */
+contact_solver_t *contact_solver_clone(contact_solver_t *solver, body_store_t *store);
+
+/**
+ * Gets the number of pairs registered with a solver.
+ *
+ * @param solver a pointer to a solver returned from contact_solver_init()
+ * @return the number of pairs
+ */
+size_t contact_solver_size(contact_solver_t *solver);
+
+/**
+ * Sets the tolerances a solver works with, which depend on the scene's units.
+ * The default overlap of 0.5 suits scenes measured in pixels, and by default
+ * bodies bounce however slowly they approach.
+ *
+ * @param solver a pointer to a solver returned from contact_solver_init()
+ * @param slop the overlap left between touching bodies, so resting bodies stay in contact
+ * @param bounce_speed bodies approaching each other more slowly than this stop instead of bouncing
+ */
+void contact_solver_set_tolerances(contact_solver_t *solver, double slop, double bounce_speed);
+
+/**
+ * Gets the overlap a solver leaves between touching bodies,
+ * as set by contact_solver_set_tolerances().
+ *
+ * @param solver a pointer to a solver returned from contact_solver_init()
+ * @return the slop
+ */
+double contact_solver_get_slop(contact_solver_t *solver);
+
+/**
+ * Gets whether two bodies are a registered pair.
+ *
+ * @param solver a pointer to a solver returned from contact_solver_init()
+ * @param body1 the first body
+ * @param body2 the second body
+ * @return whether the bodies bounce off each other
+ */
+bool contact_solver_has_pair(contact_solver_t *solver, body_t *body1, body_t *body2);
+
+/**
+ * Makes two bodies bounce off each other whenever they touch.
+ * Registering a pair again only changes its elasticity.
+ *
+ * @param solver a pointer to a solver returned from contact_solver_init()
+ * @param body1 the first body
+ * @param body2 the second body
+ * @param elasticity the "coefficient of restitution" of the collision;
+ * 0 is a perfectly inelastic collision and 1 is a perfectly elastic collision
+ */
+void contact_solver_add_pair(contact_solver_t *solver, body_t *body1, body_t *body2, double elasticity);
+
+/**
+ * Marks two bodies as possibly touching this tick, e.g. because their bounding boxes overlap.
+ * Only marked pairs are tested by the next contact_solver_solve().
+ * Does nothing if the bodies are not a registered pair.
+ *
+ * @param solver a pointer to a solver returned from contact_solver_init()
+ * @param body1 the first body
+ * @param body2 the second body
+ * @return whether the bodies are a registered pair
+ */
+bool contact_solver_activate(contact_solver_t *solver, body_t *body1, body_t *body2);
+
+/**
+ * Builds manifolds for the marked pairs that are touching,
+ * and adds the impulses that resolve them to the store.
+ * Must be called after every other force and impulse for the tick has been added,
+ * and before body_store_integrate().
+ * The narrowphase tests can be split across a job system;
+ * the impulses are always solved on the calling thread.
+ *
+ * @param solver a pointer to a solver returned from contact_solver_init()
+ * @param store the store holding the bodies' state
+ * @param dt the length of the tick
+ * @param jobs the job system to run the tests on, or NULL to run them on the calling thread
+ */
+void contact_solver_solve(contact_solver_t *solver, body_store_t *store, double dt, job_system_t *jobs);
+
+/**
+ * Gets the contact between two bodies from the last contact_solver_solve().
+ *
+ * @param solver a pointer to a solver returned from contact_solver_init()
+ * @param body1 the first body; the normal points away from it
+ * @param body2 the second body
+ * @param manifold set to the contact, if the bodies were touching
+ * @return whether the bodies are a registered pair that was touching
+ */
+bool contact_solver_get_manifold(
+    contact_solver_t *solver,
+    body_t *body1,
+    body_t *body2,
+    contact_manifold_t *manifold
+);
+
+/**
+ * Drops every pair involving a body, e.g. because it is being removed from its scene.
+ * Each body's pairs are kept in a list of their own, so this only visits those pairs.
+ *
+ * @param solver a pointer to a solver returned from contact_solver_init()
+ * @param body the body
+ */
+void contact_solver_remove_body(contact_solver_t *solver, body_t *body);
+
+/**
+ * Copies what a solver remembers between ticks into a snapshot:
+ * each pair's last manifold and impulse, and when it was last touching.
+ * The pairs themselves and their elasticities are left out.
+ *
+ * @param solver a pointer to a solver returned from contact_solver_init()
+ * @param buffer where to write the snapshot, or NULL to only measure it
+ * @return the number of bytes written
+ */
+size_t contact_solver_snapshot(contact_solver_t *solver, void *buffer);
+
+/**
+ * Puts a solver back the way a snapshot of it found it.
+ * Asserts that the solver has as many pairs as when the snapshot was taken;
+ * they are expected to be the same pairs, registered in the same order.
+ * Must not be called between marking pairs and solving them.
+ *
+ * @param solver a pointer to a solver returned from contact_solver_init()
+ * @param buffer a snapshot written by contact_solver_snapshot()
+ * @return the number of bytes read
+ */
+size_t contact_solver_restore(contact_solver_t *solver, const void *buffer);
+
+#endif // #ifndef __CONTACT_SOLVER_H__
@@ -3,6 +3,7 @@
 
 #include "scene.h"
 #include "force.h"
+#include "pool.h"
 
 /**
  * A function which adds some forces or impulses to bodies,
@@ -16,10 +17,33 @@ typedef void (*force_creator_t)(void *aux);
  */
 typedef struct force force_t;
 
+/**
+ * A function which adds a copy of a force to a copy of its scene made by scene_clone().
+ * Takes in the force's auxiliary value, and adds exactly one force to the clone,
+ * acting on the clone's copies of the force's bodies (see scene_get_clone()).
+ */
+typedef void (*force_cloner_t)(void *aux, scene_t *clone);
+
 force_t *force_init(force_creator_t fc, void *aux, free_func_t freer);
 
 force_t *force_init_with_bodies(force_creator_t fc, void *aux, free_func_t freer, list_t *bodies);
 
+/**
+ * Allocates a pool that force_init_from_pool() can allocate forces from.
+ *
+ * @param chunk_size the number of forces to allocate at a time
+ * @return a pointer to the newly allocated pool
+ */
+pool_t *force_pool_init(size_t chunk_size);
+
+/**
+ * Like force_init_with_bodies(), but takes the force from a pool.
+ * force_free() returns it to the same pool.
+ *
+ * @param pool a pointer to a pool returned from force_pool_init()
+ */
+force_t *force_init_from_pool(pool_t *pool, force_creator_t fc, void *aux, free_func_t freer, list_t *bodies);
+
 /**
  * Calls the specific force function from the forces file that we want to use.
  */
@@ -51,5 +75,100 @@ bool force_is_removed(force_t *force);
 
 list_t *force_get_bodies(force_t *force);
 
+/**
+ * Marks a force as a contact force: one that only does anything while
+ * the first two bodies in its body list are touching.
+ * The scene uses this to skip the force when their bounding boxes are apart.
+ *
+ * @param force the force to mark
+ */
+void force_set_contact(force_t *force);
+
+/**
+ * Returns whether force_set_contact() has been called on the force.
+ *
+ * @param force the force to check
+ * @return whether the force is a contact force
+ */
+bool force_is_contact(force_t *force);
+
+/**
+ * Sets whether a contact force should be run during the current tick.
+ *
+ * @param force the contact force
+ * @param active whether the bodies of the force may be touching
+ */
+void force_set_active(force_t *force, bool active);
+
+/**
+ * Returns whether a contact force should be run during the current tick.
+ *
+ * @param force the contact force
+ * @return the value last passed to force_set_active()
+ */
+bool force_is_active(force_t *force);
+
+/**
+ * Registers the part of a force's auxiliary value that changes as the scene runs,
+ * e.g. whether a collision has already been handled, so scene_snapshot() saves it.
+ * Parameters that never change do not need to be registered.
+ *
+ * @param force the force
+ * @param state the changing bytes, which must live as long as the force
+ * @param size the number of bytes
+ */
+void force_set_state(force_t *force, void *state, size_t size);
+
+/**
+ * Gets the changing part of a force's auxiliary value, as set by force_set_state().
+ *
+ * @param force the force
+ * @param size set to the number of bytes; 0 if none were registered
+ * @return the bytes, or NULL if none were registered
+ */
+void *force_get_state(force_t *force, size_t *size);
+
+/**
+ * Records where a force's handle is kept by its scene, see scene_force_handle().
+ *
+ * @param force the force
+ * @param handle the index of the force's handle
+ */
+void force_set_handle(force_t *force, size_t handle);
+
+/**
+ * Gets the index of a force's handle, as set by force_set_handle().
+ *
+ * @param force the force
+ * @return the index of the handle; 0 if none was set
+ */
+size_t force_get_handle(force_t *force);
+
+/**
+ * Lets a force be copied by scene_clone().
+ * Forces without a cloner cannot be copied.
+ *
+ * @param force the force
+ * @param cloner the function that adds a copy of the force to a clone of its scene
+ */
+void force_set_cloner(force_t *force, force_cloner_t cloner);
+
+/**
+ * Checks whether a force can be copied by scene_clone().
+ *
+ * @param force the force
+ * @return whether the force has a cloner
+ */
+bool force_is_cloneable(force_t *force);
+
+/**
+ * Adds a copy of a force to a clone of its scene, using the cloner given to force_set_cloner().
+ * Asserts that the force has a cloner.
+ *
+ * @param force the force
+ * @param clone the scene being made by scene_clone()
+ */
+void force_clone(force_t *force, scene_t *clone);
+
     
 #endif // #ifndef __FORCE_H__
\ No newline at end of file
@@ -0,0 +1,157 @@
+#ifndef __FORCE_BATCH_H__
+#define __FORCE_BATCH_H__
+
+#include <stddef.h>
+#include "aabb_tree.h"
+#include "body.h"
+#include "body_store.h"
+#include "job_system.h"
+
+/**
+ * The built-in forces of a scene, grouped by kind.
+ * Each kind keeps its parameters in its own compact array, indexed
+ * by the bodies' slots in the scene's body_store_t, and is evaluated
+ * in one loop, instead of one force_creator_t call per force.
+ *
+ * A force added before its bodies are in the scene waits until
+ * they have been added. A force goes away when one of its bodies is removed.
+ */
+typedef struct force_batch force_batch_t;
+
+/**
+ * A function called with the slots of two bodies joined by a force.
+ */
+typedef void (*slot_pair_handler_t)(size_t slot1, size_t slot2, void *aux);
+
+/**
+ * Allocates memory for an empty force batch.
+ * Asserts that the required memory was allocated.
+ *
+ * @return a pointer to the newly allocated batch
+ */
+force_batch_t *force_batch_init(void);
+
+/**
+ * Releases the memory allocated for a force batch.
+ * Does not free the bodies its forces act on.
+ *
+ * @param batch a pointer to a batch returned from force_batch_init()
+ */
+void force_batch_free(force_batch_t *batch);
+
+/**
+ * Copies a batch for a copy of its scene, e.g. one made by scene_clone().
+ * Since the forces are kept by slot, they act on the same slots of the copied store.
+ * The two batches share their forces until either adds or removes one,
+ * which gives it its own copy, so either can be freed first, on any thread.
+ * Forces still waiting for their bodies are bound to the store first;
+ * asserts that every force's bodies are in it.
+ *
+ * @param batch a pointer to a batch returned from force_batch_init()
+ * @param store the store holding the bodies of the batch's scene
+ * @return a pointer to the newly allocated copy
+ */
+force_batch_t *force_batch_clone(force_batch_t *batch, body_store_t *store);
+
+/**
+ * Gets the number of forces in a batch, including ones still waiting for their bodies.
+ *
+ * @param batch a pointer to a batch returned from force_batch_init()
+ * @return the number of forces
+ */
+size_t force_batch_size(force_batch_t *batch);
+
+/**
+ * Adds a drag force, -gamma * v, on a body.
+ *
+ * @param batch a pointer to a batch returned from force_batch_init()
+ * @param body the body to slow down
+ * @param gamma the proportionality constant between force and velocity
+ */
+void force_batch_add_drag(force_batch_t *batch, body_t *body, double gamma);
+
+/**
+ * Adds a spring force on body1 pulling it towards body2,
+ * k * (centroid2 - centroid1).
+ *
+ * @param batch a pointer to a batch returned from force_batch_init()
+ * @param body1 the body the force acts on
+ * @param body2 the body it is pulled towards
+ * @param k the spring constant
+ */
+void force_batch_add_spring(force_batch_t *batch, body_t *body1, body_t *body2, double k);
+
+/**
+ * Adds Newtonian gravity between two bodies.
+ *
+ * @param batch a pointer to a batch returned from force_batch_init()
+ * @param body1 the first body
+ * @param body2 the second body
+ * @param G the gravitational proportionality constant
+ * @param min_dist the bodies do not pull on each other while their
+ *   centroids are at most this far apart
+ */
+void force_batch_add_gravity(force_batch_t *batch, body_t *body1, body_t *body2, double G, double min_dist);
+
+/**
+ * Adds kinetic friction on body1 while it is moving and touching body2.
+ * The force is friction * mass1, against body1's velocity.
+ *
+ * @param batch a pointer to a batch returned from force_batch_init()
+ * @param body1 the body the force acts on
+ * @param body2 the surface it slides on
+ * @param friction the friction per unit mass
+ */
+void force_batch_add_friction(force_batch_t *batch, body_t *body1, body_t *body2, double friction);
+
+/**
+ * Adds every force in a batch to the accumulated forces in a store.
+ * Friction is only tested when the two bodies' bounding boxes in the tree overlap.
+ * Forces are skipped when the bodies they would push are asleep.
+ *
+ * Large batches are split into lanes, each summing its share of the drags, springs
+ * and gravities into its own array, and the lanes are added up in order.
+ * How the forces are split only depends on how many there are,
+ * so the result is the same whether or not a job system is given, and for any number of threads.
+ *
+ * @param batch a pointer to a batch returned from force_batch_init()
+ * @param store the store holding the bodies' state
+ * @param tree the tree holding the bodies' current bounding boxes
+ * @param jobs the job system to evaluate the lanes on, or NULL to evaluate them on the calling thread
+ */
+void force_batch_apply(force_batch_t *batch, body_store_t *store, aabb_tree_t *tree, job_system_t *jobs);
+
+/**
+ * Calls a function with the slots of the two bodies of each force between
+ * two bodies, e.g. to group bodies that have to move together.
+ * Forces still waiting for their bodies are not included.
+ *
+ * @param batch a pointer to a batch returned from force_batch_init()
+ * @param handler the function to call with each pair of slots
+ * @param aux the auxiliary value to pass to the handler
+ */
+void force_batch_for_each_pair(force_batch_t *batch, slot_pair_handler_t handler, void *aux);
+
+/**
+ * Drops the forces still waiting for their bodies that act on a body marked with body_remove(),
+ * since they can never be bound. Must be called before the removed bodies are freed.
+ *
+ * @param batch a pointer to a batch returned from force_batch_init()
+ */
+void force_batch_drop_removed(force_batch_t *batch);
+
+/**
+ * Updates a batch for a body being removed from its store.
+ * Drops the forces on the body in the given slot, then renames
+ * the last slot to that slot, matching body_store_remove().
+ * Each slot keeps a list of its forces, so this only visits the forces
+ * on those two slots, however many others the batch has.
+ * Must be called before body_store_remove().
+ *
+ * @param batch a pointer to a batch returned from force_batch_init()
+ * @param slot the slot being removed
+ * @param last the last occupied slot in the store
+ */
+void force_batch_remove_slot(force_batch_t *batch, size_t slot, size_t last);
+
+#endif // #ifndef __FORCE_BATCH_H__
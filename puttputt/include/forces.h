@@ -14,6 +14,25 @@
 typedef void (*collision_handler_t)
     (body_t *body1, body_t *body2, vector_t axis, void *aux);
 
+/**
+ * A function that gives the copy of a collision in a scene made by scene_clone()
+ * its own auxiliary value, e.g. a copy of the game state the original aux points to.
+ * @param aux the auxiliary value passed to create_cloneable_collision()
+ * @param clone the scene being made by scene_clone()
+ * @return the auxiliary value to pass to the copy's handler,
+ *   which the copy frees with the same freer as the original
+ */
+typedef void *(*collision_aux_cloner_t)(void *aux, scene_t *clone);
+
+/**
+ * Allocates a pool for the parameters of the force creators in this file.
+ * Each scene owns one, and the create_*() functions take their parameters from it.
+ *
+ * @param chunk_size the number of parameter structs to allocate at a time
+ * @return a pointer to the newly allocated pool
+ */
+pool_t *aux_pool_init(size_t chunk_size);
+
 /**
  * Adds a force creator to a scene that applies gravity between two bodies.
  * The force creator will be called each tick
@@ -29,6 +48,26 @@ typedef void (*collision_handler_t)
  */
 void create_newtonian_gravity(scene_t *scene, double G, body_t *body1, body_t *body2);
 
+/**
+ * Adds a single force creator to a scene that applies gravity
+ * between every pair of bodies in a list.
+ * Rather than one force creator per pair, the bodies are put in
+ * a Barnes-Hut quadtree each tick, so far-away groups of bodies
+ * pull like one body at their center of mass.
+ * Like create_newtonian_gravity(), bodies that are very close
+ * do not pull on each other.
+ *
+ * @param scene the scene containing the bodies
+ * @param G the gravitational proportionality constant
+ * @param theta how coarse the approximation is: a group of bodies is
+ *   treated as one if its width divided by its distance is less than theta.
+ *   0 gives exact pairwise gravity; around 0.5 is much faster for many bodies.
+ * @param bodies the bodies that attract each other.
+ *   The force creator takes ownership of the list and is removed
+ *   if any of the bodies are removed.
+ */
+void create_gravity_field(scene_t *scene, double G, double theta, list_t *bodies);
+
 /**
  * Adds a force creator to a scene that acts like a spring between two bodies.
  * The force creator will be called each tick
@@ -62,6 +101,10 @@ void create_drag(scene_t *scene, double gamma, body_t *body);
  * allowing different things to happen on a collision.
  * The handler is passed the bodies, the collision axis, and an auxiliary value.
  * It should only be called once while the bodies are still colliding.
+ * scene_clone() can only copy the collision if aux is NULL or the scene itself,
+ * in which case the copy's handler is passed the clone instead,
+ * which shares the original's state from scene_set_state().
+ * For any other aux, use create_cloneable_collision().
  *
  * @param scene the scene containing the bodies
  * @param body1 the first body
@@ -79,6 +122,28 @@ void create_collision(
     free_func_t freer
 );
 
+/**
+ * Works like create_collision(), except that scene_clone() can copy the collision
+ * whatever its aux is, by asking aux_cloner for the aux to give the copy.
+ *
+ * @param scene the scene containing the bodies
+ * @param body1 the first body
+ * @param body2 the second body
+ * @param handler a function to call whenever the bodies collide
+ * @param aux an auxiliary value to pass to the handler
+ * @param freer if non-NULL, a function to call in order to free aux
+ * @param aux_cloner the function that makes the aux for a copy of the collision
+ */
+void create_cloneable_collision(
+    scene_t *scene,
+    body_t *body1,
+    body_t *body2,
+    collision_handler_t handler,
+    void *aux,
+    free_func_t freer,
+    collision_aux_cloner_t aux_cloner
+);
+
 /**
  * Adds a force creator to a scene that destroys two bodies when they collide.
  * The bodies should be destroyed by calling body_remove().
@@ -92,15 +157,11 @@ void create_collision(
 void create_destructive_collision(scene_t *scene, body_t *body1, body_t *body2);
 
 /**
- * Adds a force creator to a scene that applies impulses
- * to resolve collisions between two bodies in the scene.
- * This should be represented as an on-collision callback
- * registered with create_collision().
- *
- * You may remember from project01 that you should avoid applying impulses
- * multiple times while the bodies are still colliding.
- * You should also have a special case that allows either body1 or body2
- * to have mass INFINITY, as this is useful for simulating walls.
+ * Makes two bodies in a scene bounce off each other.
+ * The pair is registered with the scene's contact solver (see scene_get_contact_solver()),
+ * which keeps resolving the contact for as long as the bodies touch,
+ * so bodies can rest against each other without sinking in.
+ * Either body1 or body2 may have mass INFINITY, e.g. to simulate walls.
  *
  * @param scene the scene containing the bodies
  * @param elasticity the "coefficient of restitution" of the collision;
@@ -0,0 +1,111 @@
+#ifndef __GOLF_HOLE_H__
+#define __GOLF_HOLE_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "body.h"
+#include "scene.h"
+#include "vector.h"
+
+/**
+ * One hole of the mini golf course, built into a scene.
+ * Holds the bodies that make up the hole: the course and its walls,
+ * the patches, slopes and bumpers that affect the balls, the cup,
+ * and a ball for each player on the tee.
+ * Only the physics of the hole is built; scoring, sounds and power-ups
+ * are left to the game, so a hole can also be played without a window.
+ */
+typedef struct golf_hole golf_hole_t;
+
+/**
+ * The number of holes on the course.
+ */
+extern const size_t GOLF_HOLE_COUNT;
+
+/**
+ * The number of players, each of whom has a ball.
+ */
+extern const size_t GOLF_HOLE_PLAYERS;
+
+/**
+ * Adds a hole's bodies to a scene, along with the forces between them and the balls.
+ * The scene owns the bodies and forces; the hole only keeps track of them.
+ * Asserts that the hole exists and that the required memory was allocated.
+ *
+ * @param scene the scene to build the hole in
+ * @param number which hole to build, from 1 to GOLF_HOLE_COUNT
+ * @return a pointer to the newly allocated hole
+ */
+golf_hole_t *golf_hole_init(scene_t *scene, size_t number);
+
+/**
+ * Releases the memory allocated for a hole.
+ * Does not free its bodies, which belong to the scene.
+ *
+ * @param hole a pointer to a hole returned from golf_hole_init()
+ */
+void golf_hole_free(golf_hole_t *hole);
+
+/**
+ * Gets a player's ball.
+ * Asserts that the player exists.
+ *
+ * @param hole a pointer to a hole returned from golf_hole_init()
+ * @param player the player, from 1 to GOLF_HOLE_PLAYERS
+ * @return the player's ball
+ */
+body_t *golf_hole_get_ball(golf_hole_t *hole, size_t player);
+
+/**
+ * Gets the cup the balls have to end up in.
+ *
+ * @param hole a pointer to a hole returned from golf_hole_init()
+ * @return the cup
+ */
+body_t *golf_hole_get_cup(golf_hole_t *hole);
+
+/**
+ * Gets the polygon the hole is played on.
+ *
+ * @param hole a pointer to a hole returned from golf_hole_init()
+ * @return the course
+ */
+body_t *golf_hole_get_course(golf_hole_t *hole);
+
+/**
+ * Gets the number of obstacles on a hole: every body besides the course
+ * that a ball can run into, i.e. walls, patches, slopes, bumpers and the cup.
+ *
+ * @param hole a pointer to a hole returned from golf_hole_init()
+ * @return the number of obstacles
+ */
+size_t golf_hole_obstacles(golf_hole_t *hole);
+
+/**
+ * Gets an obstacle on a hole.
+ * Asserts that the index is valid.
+ *
+ * @param hole a pointer to a hole returned from golf_hole_init()
+ * @param index the index of the obstacle, from 0 to golf_hole_obstacles() - 1
+ * @return the obstacle
+ */
+body_t *golf_hole_get_obstacle(golf_hole_t *hole, size_t index);
+
+/**
+ * Hits a ball, as if the player dragged the mouse back from it.
+ * The ball is launched away from the drag, and very long drags are weakened.
+ *
+ * @param ball the ball to hit
+ * @param drag how far the mouse was dragged, in screen coordinates
+ */
+void golf_hole_hit(body_t *ball, vector_t drag);
+
+/**
+ * Gets whether a ball touching the cup is slow enough to drop in.
+ *
+ * @param ball a ball touching the cup
+ * @return whether the ball goes in
+ */
+bool golf_hole_sinks(body_t *ball);
+
+#endif // #ifndef __GOLF_HOLE_H__
@@ -0,0 +1,58 @@
+#ifndef __GOLF_PREVIEW_H__
+#define __GOLF_PREVIEW_H__
+
+#include <stddef.h>
+#include "vector.h"
+
+/**
+ * A copy of a hole's physics, kept off to the side of the game
+ * to predict where a stroke would take a ball before it is hit.
+ * Only the ball being hit moves; it bounces off the walls and bumpers,
+ * slows down on the patches and rolls down the slopes of its own copy of the hole,
+ * so the prediction leaves out the other ball and anything the game adds, like coins.
+ * Each prediction starts from a snapshot of the hole at rest
+ * and is fast-forwarded until the ball stops, so it can be redone every frame.
+ */
+typedef struct golf_preview golf_preview_t;
+
+/**
+ * Builds a copy of a hole to predict strokes on.
+ * Asserts that the hole exists and that the required memory was allocated.
+ *
+ * @param number which hole to build, from 1 to GOLF_HOLE_COUNT
+ * @return a pointer to the newly allocated preview
+ */
+golf_preview_t *golf_preview_init(size_t number);
+
+/**
+ * Releases the memory allocated for a preview, including its copy of the hole.
+ *
+ * @param preview a pointer to a preview returned from golf_preview_init()
+ */
+void golf_preview_free(golf_preview_t *preview);
+
+/**
+ * Plays out a stroke on the preview and gets the path the ball would take.
+ * The path starts where the ball is and ends where it stops, or in the cup if it would drop in;
+ * it has a point at least every few pixels along the way and at every bounce.
+ * Positions are given relative to the cup, so the game can scroll its copy of the hole.
+ *
+ * @param preview a pointer to a preview returned from golf_preview_init()
+ * @param player whose ball is hit, from 1 to GOLF_HOLE_PLAYERS
+ * @param position where the ball is resting
+ * @param cup where the cup is, in the same coordinates as position
+ * @param drag the drag the ball is hit with, as passed to golf_hole_hit()
+ * @param n set to the number of points on the path
+ * @return the points on the path, in the same coordinates as position;
+ * valid until the next prediction
+ */
+const vector_t *golf_preview_predict(
+    golf_preview_t *preview,
+    size_t player,
+    vector_t position,
+    vector_t cup,
+    vector_t drag,
+    size_t *n
+);
+
+#endif // #ifndef __GOLF_PREVIEW_H__
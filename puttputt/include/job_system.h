@@ -0,0 +1,142 @@
+#ifndef __JOB_SYSTEM_H__
+#define __JOB_SYSTEM_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+/**
+ * A fixed set of worker threads that run small jobs.
+ * Each worker keeps its own deque of jobs: it takes the newest job from its own deque,
+ * and when that is empty it steals the oldest job from another worker's deque.
+ * A thread waiting for jobs to finish runs jobs too, instead of blocking.
+ *
+ * Jobs report to a counter when they finish, and a batch of jobs can be held back
+ * until a counter reaches zero, so a tick's work can be laid out as a graph of stages.
+ * Which thread runs which job is not fixed, so each job should only
+ * write to memory no other running job touches.
+ */
+typedef struct job_system job_system_t;
+
+/**
+ * A function run by a job, with the job's auxiliary value and index.
+ */
+typedef void (*job_func_t)(void *aux, size_t index);
+
+/**
+ * A unit of work: calls func(aux, index).
+ */
+typedef struct {
+    job_func_t func;
+    void *aux;
+    size_t index;
+} job_t;
+
+/**
+ * Counts the unfinished jobs submitted with it.
+ * Counters are usually declared on the stack of the thread that waits on them,
+ * and must not be destroyed while they have unfinished or held back jobs.
+ */
+typedef struct job_counter {
+    atomic_size_t pending;
+    pthread_mutex_t lock;
+    // batches of jobs held back until pending reaches zero
+    struct job_batch *dependents;
+} job_counter_t;
+
+/**
+ * Starts a job system.
+ * Asserts that the required memory was allocated and the threads were started.
+ *
+ * @param num_threads the number of threads that run jobs, including
+ *   the one that creates the system; 1 runs every job on threads that wait for it
+ * @return a pointer to the newly allocated job system
+ */
+job_system_t *job_system_init(size_t num_threads);
+
+/**
+ * Stops a job system's threads and releases the memory allocated for it.
+ * Every submitted job must have finished.
+ *
+ * @param jobs a pointer to a job system returned from job_system_init()
+ */
+void job_system_free(job_system_t *jobs);
+
+/**
+ * Gets the number of threads that run jobs, including the one that created the system.
+ *
+ * @param jobs a pointer to a job system returned from job_system_init(), or NULL
+ * @return the number of threads; 1 if jobs is NULL
+ */
+size_t job_system_size(job_system_t *jobs);
+
+/**
+ * Prepares a counter with no jobs.
+ *
+ * @param counter the counter to initialize
+ */
+void job_counter_init(job_counter_t *counter);
+
+/**
+ * Releases the resources held by a counter, which must have reached zero.
+ *
+ * @param counter a counter initialized with job_counter_init()
+ */
+void job_counter_destroy(job_counter_t *counter);
+
+/**
+ * Queues jobs to be run by any thread of a job system.
+ * The jobs are copied, so the array can be reused once this returns.
+ *
+ * @param jobs a pointer to a job system returned from job_system_init()
+ * @param batch the jobs to run
+ * @param count the number of jobs
+ * @param counter a counter the jobs are added to, and which they decrement
+ *   when they finish, or NULL
+ */
+void job_system_submit(job_system_t *jobs, const job_t *batch, size_t count, job_counter_t *counter);
+
+/**
+ * Queues jobs that only start once every job counted by another counter has finished,
+ * e.g. to add up partial results after the jobs computing them.
+ * The jobs are added to their own counter right away, so waiting on it
+ * also waits for the jobs they depend on.
+ *
+ * @param jobs a pointer to a job system returned from job_system_init()
+ * @param batch the jobs to run
+ * @param count the number of jobs
+ * @param after the counter to wait for
+ * @param counter a counter the jobs are added to, or NULL
+ */
+void job_system_submit_after(
+    job_system_t *jobs,
+    const job_t *batch,
+    size_t count,
+    job_counter_t *after,
+    job_counter_t *counter
+);
+
+/**
+ * Runs queued jobs on the calling thread until a counter reaches zero.
+ *
+ * @param jobs a pointer to a job system returned from job_system_init()
+ * @param counter the counter to wait for
+ */
+void job_system_wait(job_system_t *jobs, job_counter_t *counter);
+
+/**
+ * Calls a function with every index from 0 to count - 1, in jobs of
+ * up to grain consecutive indices, and returns once all of them have finished.
+ * Can be called from inside a job.
+ *
+ * @param jobs a pointer to a job system returned from job_system_init(),
+ *   or NULL to run the loop on the calling thread
+ * @param count the number of indices
+ * @param grain the most indices one job handles; larger grains cost less to schedule
+ * @param func the function to call with each index
+ * @param aux the auxiliary value to pass to func
+ */
+void job_system_parallel_for(job_system_t *jobs, size_t count, size_t grain, job_func_t func, void *aux);
+
+#endif // #ifndef __JOB_SYSTEM_H__
@@ -65,10 +65,11 @@ void *list_get(list_t *list, size_t index);
 void list_set(list_t *list, size_t index, void *value);
 
 /**
- * Increases the capacity of the list by multiplying by the growing rate
- * and copying elements over
+ * Increases the capacity of the list by multiplying by the growing rate,
+ * resizing its array in place.
  *
  * @param list a pointer to a list returned from list_init()
+ * @return the same list
  */
 list_t *list_increase_capacity(list_t *list);
 
@@ -0,0 +1,69 @@
+#ifndef __PAIR_MAP_H__
+#define __PAIR_MAP_H__
+
+#include <stddef.h>
+
+/**
+ * A hash map keyed by an unordered pair of pointers, e.g. two bodies.
+ * The pairs (a, b) and (b, a) refer to the same entry.
+ * The map does not own its keys or values.
+ */
+typedef struct pair_map pair_map_t;
+
+/**
+ * Allocates memory for an empty pair map.
+ * Asserts that the required memory was allocated.
+ *
+ * @param initial_size the number of entries to allocate space for
+ * @return a pointer to the newly allocated map
+ */
+pair_map_t *pair_map_init(size_t initial_size);
+
+/**
+ * Releases the memory allocated for a pair map.
+ * Does not free the values stored in it.
+ *
+ * @param map a pointer to a map returned from pair_map_init()
+ */
+void pair_map_free(pair_map_t *map);
+
+/**
+ * Gets the number of entries in a pair map.
+ *
+ * @param map a pointer to a map returned from pair_map_init()
+ * @return the number of pairs with a value
+ */
+size_t pair_map_size(pair_map_t *map);
+
+/**
+ * Looks up the value stored for a pair.
+ *
+ * @param map a pointer to a map returned from pair_map_init()
+ * @param a one element of the pair
+ * @param b the other element of the pair
+ * @return the stored value, or NULL if the pair has no entry
+ */
+void *pair_map_get(pair_map_t *map, const void *a, const void *b);
+
+/**
+ * Stores a value for a pair, replacing any previous value.
+ * Asserts that the value is non-NULL.
+ *
+ * @param map a pointer to a map returned from pair_map_init()
+ * @param a one element of the pair
+ * @param b the other element of the pair
+ * @param value the value to store
+ */
+void pair_map_set(pair_map_t *map, const void *a, const void *b, void *value);
+
+/**
+ * Removes the entry for a pair.
+ *
+ * @param map a pointer to a map returned from pair_map_init()
+ * @param a one element of the pair
+ * @param b the other element of the pair
+ * @return the removed value, or NULL if the pair had no entry
+ */
+void *pair_map_remove(pair_map_t *map, const void *a, const void *b);
+
+#endif // #ifndef __PAIR_MAP_H__
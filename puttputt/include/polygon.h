@@ -46,4 +46,136 @@ void polygon_translate(list_t *polygon, vector_t translation);
  */
 void polygon_rotate(list_t *polygon, double angle, vector_t point);
 
+/**
+ * A polygon whose vertices are stored in one contiguous array.
+ * Vertices are listed in counterclockwise order, with an edge between
+ * each pair of consecutive vertices, plus one between the first and last.
+ */
+typedef struct polygon polygon_t;
+
+/**
+ * Allocates memory for a polygon with no vertices.
+ * Asserts that the required memory was allocated.
+ *
+ * @param initial_size the number of vertices to allocate space for
+ * @return a pointer to the newly allocated polygon
+ */
+polygon_t *polygon_init(size_t initial_size);
+
+/**
+ * Creates a polygon with the same vertices as a list.
+ * The list is not modified.
+ *
+ * @param points the list of vertices (vector_t *) to copy
+ * @return a pointer to the newly allocated polygon
+ */
+polygon_t *polygon_from_list(list_t *points);
+
+/**
+ * Copies a polygon's vertices into a list of newly allocated vectors.
+ * Freeing the list with list_free() also frees the vectors.
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @return a new list of the polygon's vertices
+ */
+list_t *polygon_to_list(polygon_t *polygon);
+
+/**
+ * Creates a copy of a polygon.
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @return a pointer to the newly allocated copy
+ */
+polygon_t *polygon_copy(polygon_t *polygon);
+
+/**
+ * Releases the memory allocated for a polygon.
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ */
+void polygon_free(polygon_t *polygon);
+
+/**
+ * Gets the number of vertices in a polygon.
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @return the number of vertices
+ */
+size_t polygon_size(polygon_t *polygon);
+
+/**
+ * Gets one vertex of a polygon.
+ * Asserts that the index is valid.
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @param index the index of the vertex (starting at 0)
+ * @return the vertex
+ */
+vector_t polygon_get(polygon_t *polygon, size_t index);
+
+/**
+ * Gets the array of a polygon's vertices.
+ * The array may move when vertices are added.
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @return the first of polygon_size() contiguous vertices
+ */
+vector_t *polygon_points(polygon_t *polygon);
+
+/**
+ * Adds a vertex to the end of a polygon, growing it if needed.
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @param point the vertex to add
+ */
+void polygon_add(polygon_t *polygon, vector_t point);
+
+/**
+ * Computes the area of a polygon, like polygon_area().
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @return the area of the polygon
+ */
+double polygon_get_area(polygon_t *polygon);
+
+/**
+ * Computes the center of mass of a polygon, like polygon_centroid().
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @return the centroid of the polygon
+ */
+vector_t polygon_get_centroid(polygon_t *polygon);
+
+/**
+ * Translates all vertices in a polygon by a given vector,
+ * like polygon_translate().
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @param translation the vector to add to each vertex's position
+ */
+void polygon_move_by(polygon_t *polygon, vector_t translation);
+
+/**
+ * Rotates the vertices in a polygon about a given point,
+ * like polygon_rotate().
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @param angle the angle to rotate the polygon, in radians.
+ * A positive angle means counterclockwise.
+ * @param point the point to rotate around
+ */
+void polygon_rotate_about(polygon_t *polygon, double angle, vector_t point);
+
+/**
+ * Overwrites a polygon with another polygon rotated about the origin
+ * and then translated, i.e. maps local-space vertices into world space.
+ *
+ * @param dest a pointer to the polygon to write the vertices into
+ * @param local a pointer to the polygon with the vertices to transform
+ * @param position the vector to add to each rotated vertex
+ * @param angle the angle to rotate each vertex about the origin, in radians.
+ * A positive angle means counterclockwise.
+ */
+void polygon_transform(polygon_t *dest, polygon_t *local, vector_t position, double angle);
+
 #endif // #ifndef __POLYGON_H__
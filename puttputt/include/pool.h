@@ -0,0 +1,67 @@
+#ifndef __POOL_H__
+#define __POOL_H__
+
+#include <stddef.h>
+
+/**
+ * A fixed-size object allocator.
+ * Objects are carved out of large chunks and released objects are kept
+ * on a free list, so allocating and releasing is a pointer swap
+ * and long runs do not fragment the heap.
+ * The pool also counts how many objects are live, and the most that ever were.
+ */
+typedef struct pool pool_t;
+
+/**
+ * Allocates memory for an empty pool.
+ * Asserts that the required memory was allocated.
+ *
+ * @param object_size the size of each object, in bytes
+ * @param chunk_size the number of objects to allocate at a time
+ * @return a pointer to the newly allocated pool
+ */
+pool_t *pool_init(size_t object_size, size_t chunk_size);
+
+/**
+ * Releases the memory allocated for a pool,
+ * including every object allocated from it, live or not.
+ *
+ * @param pool a pointer to a pool returned from pool_init()
+ */
+void pool_free(pool_t *pool);
+
+/**
+ * Allocates an object from a pool, aligned for any type.
+ * If every object is in use, allocates another chunk
+ * and asserts that the allocation succeeded.
+ *
+ * @param pool a pointer to a pool returned from pool_init()
+ * @return a pointer to the uninitialized object
+ */
+void *pool_alloc(pool_t *pool);
+
+/**
+ * Returns an object to the pool it was allocated from.
+ *
+ * @param pool a pointer to a pool returned from pool_init()
+ * @param object a pointer returned from pool_alloc() on the same pool
+ */
+void pool_release(pool_t *pool, void *object);
+
+/**
+ * Gets the number of objects allocated from a pool and not yet released.
+ *
+ * @param pool a pointer to a pool returned from pool_init()
+ * @return the number of live objects
+ */
+size_t pool_live(pool_t *pool);
+
+/**
+ * Gets the largest number of objects that were ever live at once in a pool.
+ *
+ * @param pool a pointer to a pool returned from pool_init()
+ * @return the peak number of live objects
+ */
+size_t pool_peak(pool_t *pool);
+
+#endif // #ifndef __POOL_H__
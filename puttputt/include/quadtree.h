@@ -0,0 +1,62 @@
+#ifndef __QUADTREE_H__
+#define __QUADTREE_H__
+
+#include <stddef.h>
+#include "vector.h"
+
+/**
+ * A Barnes-Hut quadtree over a set of point masses.
+ * Each node records the total mass and center of mass of the points inside it,
+ * so the pull of a far-away cluster can be approximated by a single point.
+ * The tree is meant to be rebuilt every tick.
+ */
+typedef struct quadtree quadtree_t;
+
+/**
+ * Allocates memory for an empty quadtree.
+ * Asserts that the required memory was allocated.
+ *
+ * @return a pointer to the newly allocated tree
+ */
+quadtree_t *quadtree_init(void);
+
+/**
+ * Releases the memory allocated for a quadtree.
+ *
+ * @param tree a pointer to a tree returned from quadtree_init()
+ */
+void quadtree_free(quadtree_t *tree);
+
+/**
+ * Replaces the contents of a quadtree with a new set of point masses.
+ * The arrays are not copied, so they must not change
+ * until the tree is rebuilt or freed.
+ *
+ * @param tree a pointer to a tree returned from quadtree_init()
+ * @param positions the position of each point
+ * @param masses the mass of each point
+ * @param n the number of points
+ */
+void quadtree_build(quadtree_t *tree, const vector_t *positions, const double *masses, size_t n);
+
+/**
+ * Computes the gravitational field at one of the points in the tree,
+ * i.e. the sum of m * d / |d|^3 over every other point mass,
+ * where d is the displacement to that mass.
+ * Multiplying by G and the point's own mass gives the force on it.
+ *
+ * A node whose width divided by its distance is less than theta
+ * is treated as a single mass at its center of mass.
+ * A theta of 0 opens every node, which gives exact pairwise gravity.
+ * The tree is only read, so several threads can compute fields from it at once.
+ *
+ * @param tree a pointer to a tree built with quadtree_build()
+ * @param index the index of the point to compute the field at
+ * @param theta the opening angle; around 0.5 is a good tradeoff
+ * @param min_dist masses closer than this are ignored,
+ *   since the field blows up as the distance goes to 0
+ * @return the gravitational field at the point, without the factor G
+ */
+vector_t quadtree_field(quadtree_t *tree, size_t index, double theta, double min_dist);
+
+#endif // #ifndef __QUADTREE_H__
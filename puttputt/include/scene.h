@@ -3,6 +3,12 @@
 
 #include "body.h"
 #include "list.h"
+#include "aabb_tree.h"
+#include "arena.h"
+#include "pool.h"
+#include "force_batch.h"
+#include "contact_solver.h"
+#include "job_system.h"
 
 /**
  * A collection of bodies and force creators.
@@ -18,6 +24,23 @@ typedef struct scene scene_t;
  */
 typedef void (*force_creator_t)(void *aux);
 
+/**
+ * A force creator registered with a scene, as declared in force.h.
+ */
+typedef struct force force_t;
+
+/**
+ * Refers to a body or force in a scene without holding on to a pointer to it.
+ * Removing bodies moves others into their place, so indices do not last,
+ * but a handle keeps finding the same body or force until it is freed,
+ * after which it finds nothing, even once its index has been given to something else.
+ * A zeroed handle never refers to anything.
+ */
+typedef struct{
+    size_t index;
+    size_t generation;
+} scene_handle_t;
+
 /**
  * Allocates memory for an empty scene.
  * Makes a reasonable guess of the number of bodies to allocate space for.
@@ -59,6 +82,9 @@ size_t scene_bodies(scene_t *scene);
 
 /**
  * Gets the body at a given index in a scene.
+ * When bodies are removed, the last bodies are moved into their places,
+ * so a body's index can change at the end of every tick that frees one;
+ * use scene_body_handle() to keep track of a body instead.
  * Asserts that the index is valid.
  *
  * @param scene a pointer to a scene returned from scene_init()
@@ -86,13 +112,53 @@ void scene_add_body(scene_t *scene, body_t *body);
  */
 void scene_remove_body(scene_t *scene, size_t index);
 
+/**
+ * Gets a handle to a body in a scene.
+ * Asserts that the body is in the scene.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param body the body
+ * @return a handle that finds the body until it is freed
+ */
+scene_handle_t scene_body_handle(scene_t *scene, body_t *body);
+
+/**
+ * Finds the body a handle refers to.
+ * A body marked with body_remove() is still found until the end of the tick that frees it.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param handle a handle returned from scene_body_handle()
+ * @return the body, or NULL if it has been freed
+ */
+body_t *scene_resolve_body(scene_t *scene, scene_handle_t handle);
+
+/**
+ * Gets a handle to a force in a scene.
+ * Asserts that the force is in the scene.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param force the force
+ * @return a handle that finds the force until it is freed
+ */
+scene_handle_t scene_force_handle(scene_t *scene, force_t *force);
+
+/**
+ * Finds the force a handle refers to.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param handle a handle returned from scene_force_handle()
+ * @return the force, or NULL if it has been freed
+ */
+force_t *scene_resolve_force(scene_t *scene, scene_handle_t handle);
+
 void *scene_get_state(scene_t *scene);
 
 void scene_set_state(scene_t *scene, void *state);
 
 /**
  * @deprecated Use scene_add_bodies_force_creator() instead
- * so the scene knows which bodies the force creator depends on
+ * so the scene knows which bodies the force creator depends on.
+ * The force cannot be given a cloner, so scene_clone() cannot copy the scene.
  */
 void scene_add_force_creator(
     scene_t *scene,
@@ -107,6 +173,8 @@ void scene_add_force_creator(
  * The auxiliary value is passed to the force creator each time it is called.
  * The force creator is registered with a list of bodies it applies to,
  * so it can be removed when any one of the bodies is removed.
+ * scene_clone() can only copy the scene once the force is given a cloner
+ * (see force_set_cloner()).
  *
  * @param scene a pointer to a scene returned from scene_init()
  * @param forcer a force creator function
@@ -115,8 +183,9 @@ void scene_add_force_creator(
  *   The force creator will be removed if any of these bodies are removed.
  *   This list does not own the bodies, so its freer should be NULL.
  * @param freer if non-NULL, a function to call in order to free aux
+ * @return the force, owned by the scene
  */
-void scene_add_bodies_force_creator(
+force_t *scene_add_bodies_force_creator(
     scene_t *scene,
     force_creator_t forcer,
     void *aux,
@@ -124,16 +193,291 @@ void scene_add_bodies_force_creator(
     free_func_t freer
 );
 
+/**
+ * Adds a force creator that only acts while two bodies are touching,
+ * e.g. a collision or friction between them.
+ * Works like scene_add_bodies_force_creator(), except that scene_tick() skips
+ * the force creator while the bounding boxes of the first two bodies
+ * in the list are apart.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param forcer a force creator function
+ * @param aux an auxiliary value to pass to forcer when it is called
+ * @param bodies the list of bodies affected by the force creator,
+ *   starting with the two bodies that have to touch.
+ *   This list does not own the bodies, so its freer should be NULL.
+ * @param freer if non-NULL, a function to call in order to free aux
+ * @return the force, owned by the scene
+ */
+force_t *scene_add_contact_force_creator(
+    scene_t *scene,
+    force_creator_t forcer,
+    void *aux,
+    list_t *bodies,
+    free_func_t freer
+);
+
+/**
+ * Finds the bodies in a scene whose bounding boxes overlap a box.
+ * Bodies are found where they were at the start of the last scene_tick(),
+ * or where they were added if the scene has not ticked since.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param box the area to search
+ * @param handler a function called with each body found and aux;
+ *   it returns false to stop the search early
+ * @param aux an auxiliary value to pass to the handler
+ */
+void scene_query(scene_t *scene, aabb_t box, aabb_query_handler_t handler, void *aux);
+
+/**
+ * Gets a scene's frame arena, for temporary memory needed during one tick
+ * (by force creators) or one frame (by the code drawing the scene).
+ * Everything allocated from it is released at the start of the next scene_tick(),
+ * so it must not be freed or kept any longer.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @return the arena owned by the scene
+ */
+arena_t *scene_get_arena(scene_t *scene);
+
+/**
+ * Gets the pool a scene allocates its force_t objects from.
+ * pool_live() and pool_peak() on it report how many forces the scene has.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @return the force pool owned by the scene
+ */
+pool_t *scene_get_force_pool(scene_t *scene);
+
+/**
+ * Gets the pool the force creators in forces.h allocate their parameters from.
+ * Everything in it is freed along with the scene.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @return the parameter pool owned by the scene
+ */
+pool_t *scene_get_aux_pool(scene_t *scene);
+
+/**
+ * Gets the batch holding a scene's built-in forces
+ * (drag, springs, Newtonian gravity and friction).
+ * These are evaluated at the start of each scene_tick(),
+ * before the force creators added with scene_add_force_creator().
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @return the force batch owned by the scene
+ */
+force_batch_t *scene_get_force_batch(scene_t *scene);
+
+/**
+ * Gives a scene a job system to split its work across.
+ * The built-in forces, the gravity field, the narrowphase tests of contact pairs
+ * and moving the bodies are run as jobs, and sum their results in a fixed order,
+ * so a tick gives exactly the same result with or without a job system,
+ * and for any number of threads.
+ * Finding pairs, solving contacts and force creators run on the calling thread.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param jobs a pointer to a job system returned from job_system_init(), which must outlive
+ *   the scene or be replaced first, or NULL to do all the work on the calling thread
+ */
+void scene_set_job_system(scene_t *scene, job_system_t *jobs);
+
+/**
+ * Gets the job system a scene splits its work across, as set by scene_set_job_system().
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @return the job system, or NULL if the scene works on the calling thread
+ */
+job_system_t *scene_get_job_system(scene_t *scene);
+
+/**
+ * Makes a scene find the pairs of bodies that might be touching with a uniform grid
+ * (see broadphase.h) instead of its bounding box tree.
+ * The grid is refilled every tick, which beats the tree when most bodies move
+ * and are about the same size, e.g. thousands of balls in a box,
+ * while the tree is faster when most bodies stand still.
+ * Both find the same pairs. While sleeping is on (see scene_enable_sleeping()),
+ * only the awake bodies are searched for, which always uses the tree.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param cell_size the width and height of each grid cell, about twice the size of the moving bodies,
+ *   or 0 to go back to the tree
+ */
+void scene_use_grid(scene_t *scene, double cell_size);
+
+/**
+ * Lets the bodies in a scene go to sleep when they stop moving, so an idle scene costs almost nothing to tick.
+ * Bodies that touch or are joined by forces form an island, which goes to sleep
+ * once all of its bodies have been slower than sleep_speed for sleep_ticks ticks in a row.
+ * A sleeping body does not move, and force creators are skipped when all of their bodies are asleep.
+ * Static bodies sleep once they stop moving.
+ * An island wakes up when an awake body might be touching it,
+ * or when one of its bodies is moved or pushed (see body_wake()).
+ * Force creators that act without naming their bodies always run.
+ * Sleeping is off until this is called.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param sleep_speed the speed below which a body counts as still
+ * @param sleep_ticks the number of still ticks before an island sleeps; 0 turns sleeping off and wakes every body
+ */
+void scene_enable_sleeping(scene_t *scene, double sleep_speed, size_t sleep_ticks);
+
+/**
+ * Gets the number of bodies in a scene that are not asleep.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @return the number of awake bodies
+ */
+size_t scene_awake_bodies(scene_t *scene);
+
+/**
+ * Gets the solver for the pairs of bodies in a scene that bounce off each other,
+ * as added with create_physics_collision().
+ * It runs during each scene_tick(), after every force creator.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @return the contact solver owned by the scene
+ */
+contact_solver_t *scene_get_contact_solver(scene_t *scene);
+
 /**
  * Executes a tick of a given scene over a small time interval.
  * This requires executing all the force creators
  * and then ticking each body (see body_tick()).
+ * Contact force creators only run for bodies whose bounding boxes overlap.
+ * Bodies marked with body_set_bullet() are stopped at the first static body
+ * they would bounce off during the tick, instead of passing through it.
  * If any bodies are marked for removal, they should be removed from the scene
  * and freed, along with any force creators acting on them.
+ * Each body keeps a list of the force creators acting on it, so removing bodies
+ * only visits their own force creators, and the last bodies and force creators
+ * are moved into the gaps they leave.
  *
  * @param scene a pointer to a scene returned from scene_init()
  * @param dt the time elapsed since the last tick, in seconds
  */
 void scene_tick(scene_t *scene, double dt);
 
+/**
+ * Advances a scene by the time since the last frame in whole ticks of a fixed length.
+ * Time left over is carried to the next call, so the scene runs at the same rate
+ * as the clock, but every tick has the same dt and runs the same way every time.
+ * At most max_substeps ticks run per call; after a long pause,
+ * the time that would take more ticks is dropped, so one frame cannot take arbitrarily long.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param frame_dt the time elapsed since the last call, in seconds
+ * @param step the dt of each tick, in seconds
+ * @param max_substeps the most ticks to run in one call
+ * @return the number of ticks that ran
+ */
+size_t scene_step_fixed(scene_t *scene, double frame_dt, double step, size_t max_substeps);
+
+/**
+ * Gets how far the time given to scene_step_fixed() is between the last tick and the next one,
+ * as a fraction of a tick. Drawing each body at its previous centroid plus alpha times
+ * the distance to its current one hides the ticks not lining up with frames.
+ * Is 1 until scene_step_fixed() is first called.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @return a number between 0 and 1
+ */
+double scene_get_alpha(scene_t *scene);
+
+/**
+ * A function called after each tick of scene_fast_forward(),
+ * e.g. to record where a body went or to stop once something has happened.
+ * Takes in the scene and an auxiliary value that can store parameters or state.
+ * Returns whether to keep going.
+ */
+typedef bool (*tick_handler_t)(scene_t *scene, void *aux);
+
+/**
+ * Runs a scene ahead as quickly as possible, e.g. to predict where a shot will end up.
+ * Ticks back to back with a fixed dt, without keeping time like scene_step_fixed()
+ * or remembering the previous positions for drawing, and stops early
+ * once every body is asleep, since nothing more can happen.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param duration the most time to simulate, in seconds
+ * @param step the dt of each tick, in seconds
+ * @param handler called after each tick, or NULL to run the whole duration
+ * @param aux the auxiliary value passed to the handler
+ * @return the number of ticks that ran
+ */
+size_t scene_fast_forward(scene_t *scene, double duration, double step, tick_handler_t handler, void *aux);
+
+/**
+ * Copies the state of a running scene into a flat buffer, so it can be put back later,
+ * e.g. to undo a shot or to try several from the same position.
+ * Holds each body's position, velocity, angle and accumulated forces, whether it is asleep,
+ * the layout of the bounding box tree, what the contact solver remembers about each pair,
+ * and each force's registered state (see force_set_state()).
+ * Restoring a snapshot and ticking gives exactly the same result as ticking from where it was taken. The bodies' shapes, masses and the forces' parameters
+ * are left out, since they do not change as the scene runs; neither is the state
+ * from scene_set_state(), which belongs to the caller.
+ * Must not be called during scene_tick().
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param buffer where to write the snapshot, or NULL to only measure it
+ * @return the number of bytes written
+ */
+size_t scene_snapshot(scene_t *scene, void *buffer);
+
+/**
+ * Puts a scene back the way it was when a snapshot of it was taken,
+ * copying into the memory the scene already has instead of allocating per body or force.
+ * The scene must still have the same bodies and forces, added in the same order,
+ * so bodies and forces cannot have been added or removed since.
+ * Asserts that it has as many of each as when the snapshot was taken.
+ * Must not be called during scene_tick().
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param buffer a snapshot written by scene_snapshot()
+ */
+void scene_restore(scene_t *scene, const void *buffer);
+
+/**
+ * Makes a deep copy of a scene, e.g. to play out a shot without disturbing the game,
+ * or to try many shots at once on different threads.
+ * Ticking the copy gives exactly the same result as ticking the original from the same point.
+ *
+ * Every body, static ones included, gets a copy of itself and its physics state at the same index,
+ * and the bounding box tree, the contact solver's pairs and every force are copied,
+ * so a copy costs time and memory in proportion to the whole scene.
+ * Only read-only data is shared: each body's local shape, its world-space shape
+ * until it moves or turns (see body_clone()), and the parameters of the built-in forces
+ * until either scene adds or removes one (see force_batch_clone()).
+ * Handles to the original's bodies and forces find their copies in the clone.
+ * Every force needs a cloner (see force_set_cloner()); the ones in forces.h have one,
+ * except collisions whose aux cannot be remapped (see create_collision()).
+ * A scene with a force that has no cloner is not copied at all.
+ * The copy uses the same job system and the same state from scene_set_state(),
+ * so collision handlers that use the state work in either scene, and a handler that changes it
+ * changes it for both. Giving the copy a state of its own does not free the shared one.
+ * A snapshot of one scene cannot be restored into the other.
+ *
+ * Either scene can be freed first, and they can be ticked on different threads,
+ * but the original must not be ticked while it is being copied.
+ * Must not be called during scene_tick().
+ * Asserts that the required memory was allocated.
+ *
+ * @param scene a pointer to a scene returned from scene_init() or scene_clone()
+ * @return a pointer to the newly allocated copy, or NULL if a force has no cloner
+ */
+scene_t *scene_clone(scene_t *scene);
+
+/**
+ * Finds a clone's copy of a body in the scene it was copied from, e.g. in a force_cloner_t.
+ * Only valid until a body is removed from either scene.
+ * Asserts that the body is in a scene.
+ *
+ * @param clone a pointer to a scene returned from scene_clone()
+ * @param body a body of the scene that was copied
+ * @return the copy of the body
+ */
+body_t *scene_get_clone(scene_t *clone, body_t *body);
+
 #endif // #ifndef __SCENE_H__
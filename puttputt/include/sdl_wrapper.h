@@ -6,6 +6,7 @@
 #include <stdbool.h>
 #include "color.h"
 #include "list.h"
+#include "polygon.h"
 #include "scene.h"
 #include "vector.h"
 
@@ -65,6 +66,7 @@ bool sdl_is_done(void *scene);
 
 /**
  * Clears the screen. Should be called before drawing polygons in each frame.
+ * Also releases the temporary memory used to draw the last frame.
  */
 void sdl_clear(void);
 
@@ -76,6 +78,25 @@ void sdl_clear(void);
  */
 void sdl_draw_polygon(list_t *points, rgb_color_t color, SDL_Surface *texture, bool has_texture, SDL_Rect *rect);
 
+/**
+ * Draws a polygon_t from the given array of vertices and a color,
+ * like sdl_draw_polygon().
+ *
+ * @param polygon the polygon to draw
+ * @param color the color used to fill in the polygon
+ */
+void sdl_draw_shape(polygon_t *polygon, rgb_color_t color, SDL_Surface *texture, bool has_texture, SDL_Rect *rect);
+
+/**
+ * Draws a polygon from an array of vertices and a color,
+ * like sdl_draw_polygon().
+ *
+ * @param points the vertices of the polygon
+ * @param n the number of vertices
+ * @param color the color used to fill in the polygon
+ */
+void sdl_draw_points(const vector_t *points, size_t n, rgb_color_t color, SDL_Surface *texture, bool has_texture, SDL_Rect *rect);
+
 /**
  * Displays the rendered frame on the SDL window.
  * Must be called after drawing the polygons in order to show them.
@@ -86,6 +107,8 @@ void sdl_show(void);
  * Draws all bodies in a scene.
  * This internally calls sdl_clear(), sdl_draw_polygon(), and sdl_show(),
  * so those functions should not be called directly.
+ * If the scene is advanced with scene_step_fixed(), each body is drawn
+ * between its previous and current centroids according to scene_get_alpha().
  *
  * @param scene the scene to draw
  */
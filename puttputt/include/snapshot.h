@@ -0,0 +1,40 @@
+#ifndef __SNAPSHOT_H__
+#define __SNAPSHOT_H__
+
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * Helpers for the _snapshot() and _restore() functions of the physics modules,
+ * which copy their state into and out of one flat buffer.
+ * Writers take a NULL buffer to only measure how many bytes they would write.
+ * Values are copied byte for byte, so a snapshot can only be read by the same build.
+ */
+
+/**
+ * Copies bytes into a snapshot and moves past them.
+ *
+ * @param buffer the snapshot, or NULL to only count the bytes
+ * @param offset the position in the snapshot, which is advanced by size
+ * @param data the bytes to copy
+ * @param size the number of bytes
+ */
+static inline void snapshot_write(void *buffer, size_t *offset, const void *data, size_t size){
+    if(buffer != NULL && size > 0) memcpy((char *) buffer + *offset, data, size);
+    *offset += size;
+}
+
+/**
+ * Copies bytes out of a snapshot and moves past them.
+ *
+ * @param buffer the snapshot
+ * @param offset the position in the snapshot, which is advanced by size
+ * @param data where to copy the bytes
+ * @param size the number of bytes
+ */
+static inline void snapshot_read(const void *buffer, size_t *offset, void *data, size_t size){
+    if(size > 0) memcpy(data, (const char *) buffer + *offset, size);
+    *offset += size;
+}
+
+#endif // #ifndef __SNAPSHOT_H__
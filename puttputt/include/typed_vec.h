@@ -0,0 +1,114 @@
+#ifndef __TYPED_VEC_H__
+#define __TYPED_VEC_H__
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <assert.h>
+
+/**
+ * Declares a growable array that stores elements of a given type inline,
+ * unlike list_t, which stores a pointer to each element.
+ * Meant for small plain-data elements (vector_t, double, SDL_Rect, ...)
+ * that would otherwise each need their own allocation.
+ *
+ * DECLARE_VEC(vec2_list, vector_t) declares the type vec2_list_t and:
+ *   vec2_list_t *vec2_list_init(size_t initial_size);
+ *   void vec2_list_free(vec2_list_t *vec);
+ *   size_t vec2_list_size(vec2_list_t *vec);
+ *   vector_t *vec2_list_data(vec2_list_t *vec);
+ *   vector_t vec2_list_get(vec2_list_t *vec, size_t index);
+ *   void vec2_list_set(vec2_list_t *vec, size_t index, vector_t value);
+ *   void vec2_list_reserve(vec2_list_t *vec, size_t capacity);
+ *   void vec2_list_add(vec2_list_t *vec, vector_t value);
+ *   void vec2_list_append(vec2_list_t *vec, const vector_t *values, size_t n);
+ *   vector_t vec2_list_swap_remove(vec2_list_t *vec, size_t index);
+ *   void vec2_list_clear(vec2_list_t *vec);
+ *
+ * The array returned by _data() moves when the vector grows.
+ * _swap_remove() moves the last element into the removed index,
+ * so it does not preserve order.
+ * Functions that take an index assert that it is valid.
+ */
+#define DECLARE_VEC(name, type) \
+    typedef struct { \
+        type *data; \
+        size_t size; \
+        size_t capacity; \
+    } name##_t; \
+    \
+    static inline void name##_reserve(name##_t *vec, size_t capacity){ \
+        if(capacity <= vec->capacity) return; \
+        vec->data = realloc(vec->data, capacity * sizeof(type)); \
+        assert(vec->data); \
+        vec->capacity = capacity; \
+    } \
+    \
+    static inline name##_t *name##_init(size_t initial_size){ \
+        name##_t *vec = malloc(sizeof(name##_t)); \
+        assert(vec); \
+        vec->data = NULL; \
+        vec->size = 0; \
+        vec->capacity = 0; \
+        name##_reserve(vec, initial_size > 0 ? initial_size : 1); \
+        return vec; \
+    } \
+    \
+    static inline void name##_free(name##_t *vec){ \
+        free(vec->data); \
+        free(vec); \
+    } \
+    \
+    static inline size_t name##_size(name##_t *vec){ \
+        return vec->size; \
+    } \
+    \
+    static inline type *name##_data(name##_t *vec){ \
+        return vec->data; \
+    } \
+    \
+    static inline type name##_get(name##_t *vec, size_t index){ \
+        assert(index < vec->size); \
+        return vec->data[index]; \
+    } \
+    \
+    static inline void name##_set(name##_t *vec, size_t index, type value){ \
+        assert(index < vec->size); \
+        vec->data[index] = value; \
+    } \
+    \
+    static inline void name##_add(name##_t *vec, type value){ \
+        if(vec->size == vec->capacity) name##_reserve(vec, 2 * vec->capacity); \
+        vec->data[vec->size++] = value; \
+    } \
+    \
+    static inline void name##_append(name##_t *vec, type const *values, size_t n){ \
+        size_t capacity = vec->capacity; \
+        while(capacity < vec->size + n) capacity *= 2; \
+        name##_reserve(vec, capacity); \
+        for(size_t i = 0; i < n; i++){ \
+            vec->data[vec->size + i] = values[i]; \
+        } \
+        vec->size += n; \
+    } \
+    \
+    static inline type name##_swap_remove(name##_t *vec, size_t index){ \
+        assert(index < vec->size); \
+        type removed = vec->data[index]; \
+        vec->data[index] = vec->data[--vec->size]; \
+        return removed; \
+    } \
+    \
+    static inline void name##_clear(name##_t *vec){ \
+        vec->size = 0; \
+    }
+
+/**
+ * Loops over the elements of a vector declared with DECLARE_VEC,
+ * setting elem to a pointer to each one in order.
+ *
+ * VEC_FOR_EACH(vector_t, point, points){ ... *point ... }
+ */
+#define VEC_FOR_EACH(type, elem, vec) \
+    for(type *elem = (vec)->data; elem < (vec)->data + (vec)->size; elem++)
+
+#endif // #ifndef __TYPED_VEC_H__
@@ -0,0 +1,30 @@
+#include <math.h>
+#include "aabb.h"
+
+bool aabb_overlap(aabb_t box1, aabb_t box2){
+    return box1.min.x <= box2.max.x && box2.min.x <= box1.max.x
+        && box1.min.y <= box2.max.y && box2.min.y <= box1.max.y;
+}
+
+aabb_t aabb_union(aabb_t box1, aabb_t box2){
+    aabb_t box = {
+        .min = {.x = fmin(box1.min.x, box2.min.x), .y = fmin(box1.min.y, box2.min.y)},
+        .max = {.x = fmax(box1.max.x, box2.max.x), .y = fmax(box1.max.y, box2.max.y)}
+    };
+    return box;
+}
+
+bool aabb_contains(aabb_t outer, aabb_t inner){
+    return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y
+        && inner.max.x <= outer.max.x && inner.max.y <= outer.max.y;
+}
+
+aabb_t aabb_expand(aabb_t box, double margin){
+    vector_t grow = {.x = margin, .y = margin};
+    aabb_t expanded = {.min = vec_subtract(box.min, grow), .max = vec_add(box.max, grow)};
+    return expanded;
+}
+
+double aabb_perimeter(aabb_t box){
+    return 2 * ((box.max.x - box.min.x) + (box.max.y - box.min.y));
+}
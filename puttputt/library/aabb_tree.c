@@ -0,0 +1,480 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "aabb_tree.h"
+#include "snapshot.h"
+#include "typed_vec.h"
+
+const size_t AABB_TREE_NULL = SIZE_MAX;
+const size_t AABB_TREE_INITIAL_NODES = 16;
+
+typedef struct{
+    // the box searched when walking the tree (fat for leaves)
+    aabb_t fat;
+    // the real box of a leaf's item
+    aabb_t box;
+    void *item;
+    // the parent of a node in the tree, or the next node in the free list
+    size_t parent;
+    size_t child1;
+    size_t child2;
+    // 0 for leaves, -1 for free nodes
+    int height;
+    // whether the node has been inserted, reinserted or removed as a leaf since the last search for pairs
+    bool moved;
+} tree_node_t;
+
+typedef struct{
+    size_t proxy1;
+    size_t proxy2;
+} proxy_pair_t;
+
+DECLARE_VEC(proxy_pair_list, proxy_pair_t)
+DECLARE_VEC(proxy_list, size_t)
+
+typedef struct aabb_tree{
+    tree_node_t *nodes;
+    size_t capacity;
+    size_t root;
+    size_t free_list;
+    size_t size;
+    double margin;
+    // reused by every search so queries do not allocate
+    size_t *stack;
+    size_t stack_capacity;
+    // every pair of leaves whose fat boxes overlapped at the last search for pairs, lower proxy first
+    proxy_pair_list_t *pairs;
+    // the nodes marked as moved, in the order they were marked
+    proxy_list_t *moved;
+} aabb_tree_t;
+
+static void free_nodes_from(aabb_tree_t *tree, size_t start){
+    for(size_t i = start; i < tree->capacity; i++){
+        tree->nodes[i].parent = i + 1 < tree->capacity ? i + 1 : AABB_TREE_NULL;
+        tree->nodes[i].height = -1;
+        tree->nodes[i].moved = false;
+    }
+    tree->free_list = start;
+}
+
+aabb_tree_t *aabb_tree_init(double margin){
+    assert(margin >= 0);
+    aabb_tree_t *tree = malloc(sizeof(aabb_tree_t));
+    assert(tree);
+    tree->capacity = AABB_TREE_INITIAL_NODES;
+    tree->nodes = malloc(tree->capacity * sizeof(tree_node_t));
+    assert(tree->nodes);
+    free_nodes_from(tree, 0);
+    tree->root = AABB_TREE_NULL;
+    tree->size = 0;
+    tree->margin = margin;
+    tree->stack_capacity = AABB_TREE_INITIAL_NODES;
+    tree->stack = malloc(tree->stack_capacity * sizeof(size_t));
+    assert(tree->stack);
+    tree->pairs = proxy_pair_list_init(AABB_TREE_INITIAL_NODES);
+    tree->moved = proxy_list_init(AABB_TREE_INITIAL_NODES);
+    return tree;
+}
+
+void aabb_tree_free(aabb_tree_t *tree){
+    free(tree->nodes);
+    free(tree->stack);
+    proxy_pair_list_free(tree->pairs);
+    proxy_list_free(tree->moved);
+    free(tree);
+}
+
+aabb_tree_t *aabb_tree_clone(aabb_tree_t *tree){
+    aabb_tree_t *clone = malloc(sizeof(aabb_tree_t));
+    assert(clone);
+    *clone = *tree;
+    clone->nodes = malloc(tree->capacity * sizeof(tree_node_t));
+    assert(clone->nodes);
+    memcpy(clone->nodes, tree->nodes, tree->capacity * sizeof(tree_node_t));
+    clone->stack = malloc(tree->stack_capacity * sizeof(size_t));
+    assert(clone->stack);
+    clone->pairs = proxy_pair_list_init(proxy_pair_list_size(tree->pairs));
+    proxy_pair_list_append(clone->pairs, proxy_pair_list_data(tree->pairs), proxy_pair_list_size(tree->pairs));
+    clone->moved = proxy_list_init(proxy_list_size(tree->moved));
+    proxy_list_append(clone->moved, proxy_list_data(tree->moved), proxy_list_size(tree->moved));
+    return clone;
+}
+
+size_t aabb_tree_size(aabb_tree_t *tree){
+    return tree->size;
+}
+
+size_t aabb_tree_height(aabb_tree_t *tree){
+    if(tree->root == AABB_TREE_NULL) return 0;
+    return tree->nodes[tree->root].height;
+}
+
+static size_t allocate_node(aabb_tree_t *tree){
+    if(tree->free_list == AABB_TREE_NULL){
+        size_t old_capacity = tree->capacity;
+        tree->capacity *= 2;
+        tree->nodes = realloc(tree->nodes, tree->capacity * sizeof(tree_node_t));
+        assert(tree->nodes);
+        free_nodes_from(tree, old_capacity);
+    }
+    size_t index = tree->free_list;
+    tree_node_t *node = &tree->nodes[index];
+    tree->free_list = node->parent;
+    node->parent = AABB_TREE_NULL;
+    node->child1 = AABB_TREE_NULL;
+    node->child2 = AABB_TREE_NULL;
+    node->item = NULL;
+    node->height = 0;
+    return index;
+}
+
+static void release_node(aabb_tree_t *tree, size_t index){
+    tree->nodes[index].parent = tree->free_list;
+    tree->nodes[index].height = -1;
+    tree->free_list = index;
+}
+
+static bool is_leaf(tree_node_t *node){
+    return node->child1 == AABB_TREE_NULL;
+}
+
+static int max_height(int height1, int height2){
+    return height1 > height2 ? height1 : height2;
+}
+
+static void replace_child(aabb_tree_t *tree, size_t parent, size_t old_child, size_t new_child){
+    if(parent == AABB_TREE_NULL){
+        tree->root = new_child;
+    }
+    else if(tree->nodes[parent].child1 == old_child){
+        tree->nodes[parent].child1 = new_child;
+    }
+    else{
+        tree->nodes[parent].child2 = new_child;
+    }
+}
+
+// rotates the taller grandchild of a up if a is unbalanced, returning the new subtree root
+static size_t balance(aabb_tree_t *tree, size_t index_a){
+    tree_node_t *nodes = tree->nodes;
+    tree_node_t *a = &nodes[index_a];
+    if(is_leaf(a) || a->height < 2) return index_a;
+    size_t index_b = a->child1;
+    size_t index_c = a->child2;
+    tree_node_t *b = &nodes[index_b];
+    tree_node_t *c = &nodes[index_c];
+    int difference = c->height - b->height;
+    if(difference > 1){
+        size_t index_f = c->child1;
+        size_t index_g = c->child2;
+        tree_node_t *f = &nodes[index_f];
+        tree_node_t *g = &nodes[index_g];
+        c->child1 = index_a;
+        c->parent = a->parent;
+        a->parent = index_c;
+        replace_child(tree, c->parent, index_a, index_c);
+        if(f->height > g->height){
+            c->child2 = index_f;
+            a->child2 = index_g;
+            g->parent = index_a;
+            a->fat = aabb_union(b->fat, g->fat);
+            c->fat = aabb_union(a->fat, f->fat);
+            a->height = 1 + max_height(b->height, g->height);
+            c->height = 1 + max_height(a->height, f->height);
+        }
+        else{
+            c->child2 = index_g;
+            a->child2 = index_f;
+            f->parent = index_a;
+            a->fat = aabb_union(b->fat, f->fat);
+            c->fat = aabb_union(a->fat, g->fat);
+            a->height = 1 + max_height(b->height, f->height);
+            c->height = 1 + max_height(a->height, g->height);
+        }
+        return index_c;
+    }
+    if(difference < -1){
+        size_t index_d = b->child1;
+        size_t index_e = b->child2;
+        tree_node_t *d = &nodes[index_d];
+        tree_node_t *e = &nodes[index_e];
+        b->child1 = index_a;
+        b->parent = a->parent;
+        a->parent = index_b;
+        replace_child(tree, b->parent, index_a, index_b);
+        if(d->height > e->height){
+            b->child2 = index_d;
+            a->child1 = index_e;
+            e->parent = index_a;
+            a->fat = aabb_union(c->fat, e->fat);
+            b->fat = aabb_union(a->fat, d->fat);
+            a->height = 1 + max_height(c->height, e->height);
+            b->height = 1 + max_height(a->height, d->height);
+        }
+        else{
+            b->child2 = index_e;
+            a->child1 = index_d;
+            d->parent = index_a;
+            a->fat = aabb_union(c->fat, d->fat);
+            b->fat = aabb_union(a->fat, e->fat);
+            a->height = 1 + max_height(c->height, d->height);
+            b->height = 1 + max_height(a->height, e->height);
+        }
+        return index_b;
+    }
+    return index_a;
+}
+
+// rebalances and refits every node from index up to the root
+static void refit_from(aabb_tree_t *tree, size_t index){
+    while(index != AABB_TREE_NULL){
+        index = balance(tree, index);
+        tree_node_t *node = &tree->nodes[index];
+        tree_node_t *child1 = &tree->nodes[node->child1];
+        tree_node_t *child2 = &tree->nodes[node->child2];
+        node->height = 1 + max_height(child1->height, child2->height);
+        node->fat = aabb_union(child1->fat, child2->fat);
+        index = node->parent;
+    }
+}
+
+// the extra perimeter a subtree gains from having the box added to it
+static double descend_cost(tree_node_t *child, aabb_t box, double inherited){
+    double cost = aabb_perimeter(aabb_union(box, child->fat)) + inherited;
+    if(!is_leaf(child)) cost -= aabb_perimeter(child->fat);
+    return cost;
+}
+
+static void insert_leaf(aabb_tree_t *tree, size_t leaf){
+    if(tree->root == AABB_TREE_NULL){
+        tree->root = leaf;
+        tree->nodes[leaf].parent = AABB_TREE_NULL;
+        return;
+    }
+    // walks down towards the sibling that grows the total perimeter the least
+    aabb_t box = tree->nodes[leaf].fat;
+    size_t index = tree->root;
+    while(!is_leaf(&tree->nodes[index])){
+        tree_node_t *node = &tree->nodes[index];
+        double perimeter = aabb_perimeter(node->fat);
+        double combined = aabb_perimeter(aabb_union(node->fat, box));
+        double cost = 2 * combined;
+        double inherited = 2 * (combined - perimeter);
+        double cost1 = descend_cost(&tree->nodes[node->child1], box, inherited);
+        double cost2 = descend_cost(&tree->nodes[node->child2], box, inherited);
+        if(cost < cost1 && cost < cost2) break;
+        index = cost1 < cost2 ? node->child1 : node->child2;
+    }
+    size_t sibling = index;
+    size_t old_parent = tree->nodes[sibling].parent;
+    size_t new_parent = allocate_node(tree);
+    tree_node_t *parent = &tree->nodes[new_parent];
+    parent->parent = old_parent;
+    parent->fat = aabb_union(box, tree->nodes[sibling].fat);
+    parent->height = tree->nodes[sibling].height + 1;
+    parent->child1 = sibling;
+    parent->child2 = leaf;
+    replace_child(tree, old_parent, sibling, new_parent);
+    tree->nodes[sibling].parent = new_parent;
+    tree->nodes[leaf].parent = new_parent;
+    refit_from(tree, new_parent);
+}
+
+static void remove_leaf(aabb_tree_t *tree, size_t leaf){
+    if(leaf == tree->root){
+        tree->root = AABB_TREE_NULL;
+        return;
+    }
+    size_t parent = tree->nodes[leaf].parent;
+    size_t grandparent = tree->nodes[parent].parent;
+    size_t sibling = tree->nodes[parent].child1 == leaf ? tree->nodes[parent].child2 : tree->nodes[parent].child1;
+    replace_child(tree, grandparent, parent, sibling);
+    tree->nodes[sibling].parent = grandparent;
+    release_node(tree, parent);
+    refit_from(tree, grandparent);
+}
+
+// marks a node as moved, so the next search for pairs looks for its partners again
+static void mark_moved(aabb_tree_t *tree, size_t index){
+    if(tree->nodes[index].moved) return;
+    tree->nodes[index].moved = true;
+    proxy_list_add(tree->moved, index);
+}
+
+size_t aabb_tree_insert(aabb_tree_t *tree, void *item, aabb_t box){
+    size_t leaf = allocate_node(tree);
+    tree_node_t *node = &tree->nodes[leaf];
+    node->item = item;
+    node->box = box;
+    node->fat = aabb_expand(box, tree->margin);
+    insert_leaf(tree, leaf);
+    mark_moved(tree, leaf);
+    tree->size++;
+    return leaf;
+}
+
+static tree_node_t *get_leaf(aabb_tree_t *tree, size_t proxy){
+    assert(proxy < tree->capacity);
+    tree_node_t *node = &tree->nodes[proxy];
+    assert(node->height == 0);
+    return node;
+}
+
+void aabb_tree_remove(aabb_tree_t *tree, size_t proxy){
+    get_leaf(tree, proxy);
+    remove_leaf(tree, proxy);
+    release_node(tree, proxy);
+    // the node may be reused before the next search for pairs, so its old pairs are dropped then
+    mark_moved(tree, proxy);
+    tree->size--;
+}
+
+bool aabb_tree_move(aabb_tree_t *tree, size_t proxy, aabb_t box){
+    tree_node_t *node = get_leaf(tree, proxy);
+    node->box = box;
+    if(aabb_contains(node->fat, box)) return false;
+    remove_leaf(tree, proxy);
+    node = &tree->nodes[proxy];
+    node->fat = aabb_expand(box, tree->margin);
+    insert_leaf(tree, proxy);
+    mark_moved(tree, proxy);
+    return true;
+}
+
+void *aabb_tree_get_item(aabb_tree_t *tree, size_t proxy){
+    return get_leaf(tree, proxy)->item;
+}
+
+void aabb_tree_set_item(aabb_tree_t *tree, size_t proxy, void *item){
+    get_leaf(tree, proxy)->item = item;
+}
+
+aabb_t aabb_tree_get_bounds(aabb_tree_t *tree, size_t proxy){
+    return get_leaf(tree, proxy)->box;
+}
+
+aabb_t aabb_tree_get_fat_bounds(aabb_tree_t *tree, size_t proxy){
+    return get_leaf(tree, proxy)->fat;
+}
+
+static void push(aabb_tree_t *tree, size_t *count, size_t index){
+    if(*count == tree->stack_capacity){
+        tree->stack_capacity *= 2;
+        tree->stack = realloc(tree->stack, tree->stack_capacity * sizeof(size_t));
+        assert(tree->stack);
+    }
+    tree->stack[(*count)++] = index;
+}
+
+void aabb_tree_query(aabb_tree_t *tree, aabb_t box, aabb_query_handler_t handler, void *aux){
+    if(tree->root == AABB_TREE_NULL) return;
+    size_t count = 0;
+    push(tree, &count, tree->root);
+    while(count > 0){
+        tree_node_t *node = &tree->nodes[tree->stack[--count]];
+        if(!aabb_overlap(node->fat, box)) continue;
+        if(is_leaf(node)){
+            if(aabb_overlap(node->box, box) && !handler(node->item, aux)) return;
+        }
+        else{
+            push(tree, &count, node->child1);
+            push(tree, &count, node->child2);
+        }
+    }
+}
+
+// adds the pairs between a moved leaf and every leaf whose fat box overlaps its own
+static void add_pairs(aabb_tree_t *tree, size_t leaf){
+    aabb_t fat = tree->nodes[leaf].fat;
+    size_t count = 0;
+    push(tree, &count, tree->root);
+    while(count > 0){
+        size_t index = tree->stack[--count];
+        tree_node_t *node = &tree->nodes[index];
+        if(!aabb_overlap(node->fat, fat)) continue;
+        if(is_leaf(node)){
+            if(index == leaf) continue;
+            // a pair of moved leaves is only added from the lower one
+            if(node->moved && index < leaf) continue;
+            proxy_pair_t pair = {.proxy1 = index < leaf ? index : leaf, .proxy2 = index < leaf ? leaf : index};
+            proxy_pair_list_add(tree->pairs, pair);
+        }
+        else{
+            push(tree, &count, node->child1);
+            push(tree, &count, node->child2);
+        }
+    }
+}
+
+size_t aabb_tree_find_pairs(aabb_tree_t *tree, pair_handler_t handler, void *aux){
+    // fat boxes only change when a leaf is reinserted, so a pair of leaves that have not
+    // moved still overlaps exactly as before, and only the moved leaves are searched for
+    for(size_t i = 0; i < proxy_pair_list_size(tree->pairs);){
+        proxy_pair_t pair = proxy_pair_list_get(tree->pairs, i);
+        if(tree->nodes[pair.proxy1].moved || tree->nodes[pair.proxy2].moved) proxy_pair_list_swap_remove(tree->pairs, i);
+        else i++;
+    }
+    VEC_FOR_EACH(size_t, index, tree->moved){
+        if(tree->nodes[*index].height == 0) add_pairs(tree, *index);
+    }
+    VEC_FOR_EACH(size_t, index, tree->moved){
+        tree->nodes[*index].moved = false;
+    }
+    proxy_list_clear(tree->moved);
+    size_t num_pairs = 0;
+    VEC_FOR_EACH(proxy_pair_t, pair, tree->pairs){
+        tree_node_t *node1 = &tree->nodes[pair->proxy1];
+        tree_node_t *node2 = &tree->nodes[pair->proxy2];
+        if(!aabb_overlap(node1->box, node2->box)) continue;
+        handler(node1->item, node2->item, aux);
+        num_pairs++;
+    }
+    return num_pairs;
+}
+
+size_t aabb_tree_snapshot(aabb_tree_t *tree, void *buffer){
+    size_t offset = 0;
+    snapshot_write(buffer, &offset, &tree->capacity, sizeof(size_t));
+    snapshot_write(buffer, &offset, &tree->root, sizeof(size_t));
+    snapshot_write(buffer, &offset, &tree->free_list, sizeof(size_t));
+    snapshot_write(buffer, &offset, &tree->size, sizeof(size_t));
+    snapshot_write(buffer, &offset, tree->nodes, tree->capacity * sizeof(tree_node_t));
+    size_t num_pairs = proxy_pair_list_size(tree->pairs);
+    size_t num_moved = proxy_list_size(tree->moved);
+    snapshot_write(buffer, &offset, &num_pairs, sizeof(size_t));
+    snapshot_write(buffer, &offset, proxy_pair_list_data(tree->pairs), num_pairs * sizeof(proxy_pair_t));
+    snapshot_write(buffer, &offset, &num_moved, sizeof(size_t));
+    snapshot_write(buffer, &offset, proxy_list_data(tree->moved), num_moved * sizeof(size_t));
+    return offset;
+}
+
+size_t aabb_tree_restore(aabb_tree_t *tree, const void *buffer){
+    size_t offset = 0;
+    size_t capacity;
+    snapshot_read(buffer, &offset, &capacity, sizeof(size_t));
+    assert(capacity <= tree->capacity);
+    // a tree that has grown since keeps its memory, but grows again the same way it did the first time
+    tree->capacity = capacity;
+    snapshot_read(buffer, &offset, &tree->root, sizeof(size_t));
+    snapshot_read(buffer, &offset, &tree->free_list, sizeof(size_t));
+    snapshot_read(buffer, &offset, &tree->size, sizeof(size_t));
+    snapshot_read(buffer, &offset, tree->nodes, capacity * sizeof(tree_node_t));
+    size_t num_pairs, num_moved;
+    snapshot_read(buffer, &offset, &num_pairs, sizeof(size_t));
+    proxy_pair_list_clear(tree->pairs);
+    for(size_t i = 0; i < num_pairs; i++){
+        proxy_pair_t pair;
+        snapshot_read(buffer, &offset, &pair, sizeof(proxy_pair_t));
+        proxy_pair_list_add(tree->pairs, pair);
+    }
+    snapshot_read(buffer, &offset, &num_moved, sizeof(size_t));
+    proxy_list_clear(tree->moved);
+    for(size_t i = 0; i < num_moved; i++){
+        size_t index;
+        snapshot_read(buffer, &offset, &index, sizeof(size_t));
+        proxy_list_add(tree->moved, index);
+    }
+    return offset;
+}
@@ -0,0 +1,93 @@
+#include <stddef.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "arena.h"
+
+const size_t ARENA_MIN_SIZE = 1024;
+const size_t ARENA_ALIGNMENT = sizeof(max_align_t);
+
+typedef struct arena_block{
+    struct arena_block *next;
+    size_t capacity;
+    size_t used;
+} arena_block_t;
+
+typedef struct arena{
+    // the block being allocated from, followed by the ones filled before it
+    arena_block_t *head;
+    // the bytes used in full blocks
+    size_t used;
+} arena_t;
+
+static size_t align_up(size_t size){
+    return (size + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT;
+}
+
+// the memory handed out by a block starts after its header
+static char *block_data(arena_block_t *block){
+    return (char *) block + align_up(sizeof(arena_block_t));
+}
+
+static arena_block_t *block_init(size_t capacity, arena_block_t *next){
+    arena_block_t *block = malloc(align_up(sizeof(arena_block_t)) + capacity);
+    assert(block);
+    block->next = next;
+    block->capacity = capacity;
+    block->used = 0;
+    return block;
+}
+
+arena_t *arena_init(size_t initial_size){
+    arena_t *arena = malloc(sizeof(arena_t));
+    assert(arena);
+    arena->head = block_init(align_up(initial_size > ARENA_MIN_SIZE ? initial_size : ARENA_MIN_SIZE), NULL);
+    arena->used = 0;
+    return arena;
+}
+
+static void free_blocks(arena_block_t *block){
+    while(block != NULL){
+        arena_block_t *next = block->next;
+        free(block);
+        block = next;
+    }
+}
+
+void arena_free(arena_t *arena){
+    free_blocks(arena->head);
+    free(arena);
+}
+
+void *arena_alloc(arena_t *arena, size_t size){
+    size = align_up(size);
+    arena_block_t *head = arena->head;
+    if(head->used + size > head->capacity){
+        size_t capacity = 2 * head->capacity;
+        if(capacity < size) capacity = size;
+        arena->used += head->used;
+        head = block_init(capacity, head);
+        arena->head = head;
+    }
+    void *memory = block_data(head) + head->used;
+    head->used += size;
+    return memory;
+}
+
+void arena_reset(arena_t *arena){
+    arena_block_t *head = arena->head;
+    if(head->next != NULL){
+        size_t capacity = head->capacity;
+        for(arena_block_t *block = head->next; block != NULL; block = block->next){
+            capacity += block->capacity;
+        }
+        free_blocks(head);
+        head = block_init(capacity, NULL);
+        arena->head = head;
+    }
+    head->used = 0;
+    arena->used = 0;
+}
+
+size_t arena_used(arena_t *arena){
+    return arena->used + arena->head->used;
+}
@@ -1,21 +1,56 @@
+#include <stdatomic.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <assert.h>
+#include <math.h>
+#include <pthread.h>
 #include "body.h"
 #include "color.h"
 #include "list.h"
 #include "vector.h"
 #include "polygon.h"
 #include "sdl_wrapper.h"
+#include "body_store.h"
+#include "pool.h"
+#include "collision.h"
+
+// the number of bodies to allocate at a time
+const size_t BODY_POOL_CHUNK = 256;
+// the number of vertices drawn around each end of a capsule
+const size_t BODY_CAPSULE_ARC_POINTS = 8;
 
 typedef struct body{
-    list_t* shape;
+    // the vertices relative to the centroid, before rotating by angle
+    polygon_t *local;
+    double angle;
+    shape_kind_t kind;
+    double radius;
+    // for a capsule, the end of its segment relative to the centroid, before rotating;
+    // the other end is its negation
+    vector_t half_segment;
+    // the vertices in world space, recomputed from local when stale
+    polygon_t *shape;
+    // the unit normal of each local edge and the local shape's extent along it,
+    // computed once; these two arrays share one allocation
+    vector_t *local_normals;
+    vector_t *local_intervals;
+    // the same in world space, kept up to date with shape, also in one allocation
+    vector_t *normals;
+    vector_t *intervals;
+    // how many bodies share local and its axes, and shape and its axes, with this one,
+    // or NULL if it is their only owner; a shared shape is copied before it is recomputed
+    atomic_size_t *local_shared;
+    atomic_size_t *shape_shared;
+    // the angle normals were last rotated to
+    double normals_angle;
     rgb_color_t color;
     rgb_color_t color2;
     double mass;
     vector_t velocity;
     vector_t force;
     vector_t impulse;
+    // the physics state, used until the body is attached to a store
     vector_t centroid;
     int orientation;
     void* info;
@@ -25,45 +60,250 @@ typedef struct body{
     SDL_Surface *texture;
     bool hide;
     bool second_color;
+    bool bullet;
+    size_t proxy;
+    body_store_t *store;
+    size_t slot;
+    // where the centroid was when shape was last computed
+    vector_t shape_centroid;
+    bool shape_dirty;
 } body_t;
 
+// every body is allocated from this pool, which is created with the first body.
+// scenes may be built, cloned and freed on several threads at once, so it is locked
+static pool_t *body_pool = NULL;
+static pthread_mutex_t body_pool_lock = PTHREAD_MUTEX_INITIALIZER;
+
+pool_t *body_get_pool(void){
+    if(body_pool == NULL) body_pool = pool_init(sizeof(body_t), BODY_POOL_CHUNK);
+    return body_pool;
+}
+
+static body_t *body_alloc(void){
+    pthread_mutex_lock(&body_pool_lock);
+    body_t *body = pool_alloc(body_get_pool());
+    pthread_mutex_unlock(&body_pool_lock);
+    return body;
+}
+
+// adds a body to the ones sharing part of a shape, counting the first owner if it was not shared yet
+static atomic_size_t *share(atomic_size_t *shared){
+    if(shared == NULL){
+        shared = malloc(sizeof(atomic_size_t));
+        assert(shared);
+        atomic_init(shared, 1);
+    }
+    atomic_fetch_add(shared, 1);
+    return shared;
+}
+
+// lets go of part of a shape; returns whether no other body shares it, so it should be freed
+static bool release(atomic_size_t *shared){
+    if(shared == NULL) return true;
+    if(atomic_fetch_sub(shared, 1) > 1) return false;
+    free(shared);
+    return true;
+}
+
 body_t *body_init(list_t *shape, double mass, rgb_color_t color){
-    body_t* body = malloc(sizeof(body_t));
-    assert(body);
+    return body_init_with_info(shape, mass, color, NULL, NULL);
+}
+
+body_t *body_init_with_info(list_t *shape, double mass, rgb_color_t color, void *info, free_func_t info_freer){
+    body_t *body = body_init_polygon(polygon_from_list(shape), mass, color, info, info_freer);
+    list_free(shape);
+    return body;
+}
+
+// moves the world-space axes to the body's current angle and the intervals to its current centroid
+static void body_sync_axes(body_t *body){
+    size_t n = polygon_size(body->local);
+    if(body->angle != body->normals_angle){
+        double c = cos(body->angle);
+        double s = sin(body->angle);
+        for(size_t i = 0; i < n; i++){
+            vector_t normal = body->local_normals[i];
+            body->normals[i].x = normal.x * c - normal.y * s;
+            body->normals[i].y = normal.x * s + normal.y * c;
+        }
+        body->normals_angle = body->angle;
+    }
+    // projecting a moved shape onto an axis shifts its interval by the centroid's projection
+    vector_t centroid = body->shape_centroid;
+    for(size_t i = 0; i < n; i++){
+        double offset = vec_dot(centroid, body->normals[i]);
+        body->intervals[i].x = body->local_intervals[i].x + offset;
+        body->intervals[i].y = body->local_intervals[i].y + offset;
+    }
+}
+
+// sets up a body around the polygon, whose vertices are given in world space
+static body_t *body_init_shape(polygon_t *shape, vector_t centroid, double mass, rgb_color_t color, void *info, free_func_t info_freer){
+    body_t* body = body_alloc();
     body->shape = shape;
     body->color = color;
     body->mass = mass;
     body->velocity = VEC_ZERO;
     body->force = VEC_ZERO;
     body->impulse = VEC_ZERO;
-    body->centroid = polygon_centroid(shape);
+    body->centroid = centroid;
+    body->local = polygon_copy(shape);
+    polygon_move_by(body->local, vec_negate(body->centroid));
+    body->angle = 0;
+    size_t n = polygon_size(shape);
+    body->local_normals = malloc(2 * n * sizeof(vector_t));
+    body->normals = malloc(2 * n * sizeof(vector_t));
+    assert(body->local_normals && body->normals);
+    body->local_intervals = body->local_normals + n;
+    body->intervals = body->normals + n;
+    body->local_shared = NULL;
+    body->shape_shared = NULL;
+    find_edge_axes(polygon_points(body->local), n, body->local_normals, body->local_intervals);
+    body->normals_angle = 0;
+    for(size_t i = 0; i < n; i++){
+        body->normals[i] = body->local_normals[i];
+    }
+    body->kind = SHAPE_POLYGON;
+    body->radius = 0;
+    body->half_segment = VEC_ZERO;
     body->orientation = 0;
+    body->info = info;
+    body->info_freer = info_freer;
     body->has_texture = false;
     body->removed = false;
     body->texture = NULL;
     body->hide = false;
     body->second_color = false;
+    body->bullet = false;
+    body->store = NULL;
+    body->shape_centroid = body->centroid;
+    body->shape_dirty = false;
+    body_sync_axes(body);
     return body;
 }
 
-body_t *body_init_with_info(list_t *shape, double mass, rgb_color_t color, void *info, free_func_t info_freer){
-    body_t* body = malloc(sizeof(body_t));
-    assert(body);
-    body->shape = shape;
-    body->color = color;
-    body->mass = mass;
-    body->velocity = VEC_ZERO;
-    body->force = VEC_ZERO;
-    body->impulse = VEC_ZERO;
-    body->centroid = polygon_centroid(shape);
-    body->orientation = 0;
-    body->removed = false;
-    body->info = info;
-    body->info_freer = info_freer;
-    body->hide = false;
+body_t *body_init_polygon(polygon_t *shape, double mass, rgb_color_t color, void *info, free_func_t info_freer){
+    return body_init_shape(shape, polygon_get_centroid(shape), mass, color, info, info_freer);
+}
+
+body_t *body_init_circle(vector_t center, double radius, size_t points, double mass, rgb_color_t color, void *info, free_func_t info_freer){
+    assert(radius > 0);
+    assert(points >= 3);
+    polygon_t *shape = polygon_init(points);
+    for(size_t i = 0; i < points; i++){
+        vector_t point = {.x = center.x + radius * sin(2 * M_PI * i / points), .y = center.y - radius * cos(2 * M_PI * i / points)};
+        polygon_add(shape, point);
+    }
+    body_t *body = body_init_shape(shape, center, mass, color, info, info_freer);
+    body->kind = SHAPE_CIRCLE;
+    body->radius = radius;
     return body;
 }
 
+body_t *body_init_capsule(vector_t start, vector_t end, double radius, double mass, rgb_color_t color, void *info, free_func_t info_freer){
+    assert(radius > 0);
+    vector_t diff = vec_subtract(end, start);
+    double length = sqrt(vec_dot(diff, diff));
+    assert(length > 0);
+    vector_t normal = vec_multiply(radius / length, vec_rotate(diff, M_PI / 2));
+    // a half circle around end, from one side of the segment to the other, then one around start
+    polygon_t *shape = polygon_init(2 * (BODY_CAPSULE_ARC_POINTS + 1));
+    for(size_t i = 0; i <= BODY_CAPSULE_ARC_POINTS; i++){
+        polygon_add(shape, vec_add(end, vec_rotate(normal, -M_PI * i / BODY_CAPSULE_ARC_POINTS)));
+    }
+    for(size_t i = 0; i <= BODY_CAPSULE_ARC_POINTS; i++){
+        polygon_add(shape, vec_add(start, vec_rotate(vec_negate(normal), -M_PI * i / BODY_CAPSULE_ARC_POINTS)));
+    }
+    vector_t center = vec_multiply(0.5, vec_add(start, end));
+    body_t *body = body_init_shape(shape, center, mass, color, info, info_freer);
+    body->kind = SHAPE_CAPSULE;
+    body->radius = radius;
+    body->half_segment = vec_subtract(end, center);
+    return body;
+}
+
+static vector_t *centroid_ref(body_t *body){
+    if(body->store == NULL) return &body->centroid;
+    return &body_store_centroids(body->store)[body->slot];
+}
+
+static vector_t *velocity_ref(body_t *body){
+    if(body->store == NULL) return &body->velocity;
+    return &body_store_velocities(body->store)[body->slot];
+}
+
+static vector_t *force_ref(body_t *body){
+    if(body->store == NULL) return &body->force;
+    return &body_store_forces(body->store)[body->slot];
+}
+
+static vector_t *impulse_ref(body_t *body){
+    if(body->store == NULL) return &body->impulse;
+    return &body_store_impulses(body->store)[body->slot];
+}
+
+// gives a body its own copy of the world-space shape it shares with its clones.
+// the copy is made before letting go, since the last other owner may recompute it as soon as it is alone
+static void body_unshare_shape(body_t *body){
+    size_t n = polygon_size(body->local);
+    polygon_t *shape = body->shape;
+    vector_t *normals = body->normals;
+    body->shape = polygon_copy(shape);
+    body->normals = malloc(2 * n * sizeof(vector_t));
+    assert(body->normals);
+    memcpy(body->normals, normals, 2 * n * sizeof(vector_t));
+    body->intervals = body->normals + n;
+    if(release(body->shape_shared)){
+        polygon_free(shape);
+        free(normals);
+    }
+    body->shape_shared = NULL;
+}
+
+// recomputes the world-space shape if the body has moved or rotated since it was last used
+static void body_sync_shape(body_t *body){
+    vector_t centroid = *centroid_ref(body);
+    if(!body->shape_dirty && centroid.x == body->shape_centroid.x && centroid.y == body->shape_centroid.y) return;
+    if(body->shape_shared != NULL) body_unshare_shape(body);
+    polygon_transform(body->shape, body->local, centroid, body->angle);
+    body->shape_centroid = centroid;
+    body->shape_dirty = false;
+    body_sync_axes(body);
+}
+
+void body_attach(body_t *body, body_store_t *store){
+    assert(body->store == NULL);
+    size_t slot = body_store_add(store, body, body->centroid, body->velocity, body->mass);
+    body_store_forces(store)[slot] = body->force;
+    body_store_impulses(store)[slot] = body->impulse;
+    body->store = store;
+    body->slot = slot;
+}
+
+body_t *body_clone(body_t *body, body_store_t *store){
+    assert(body->store != NULL);
+    body_t *clone = body_alloc();
+    body->local_shared = share(body->local_shared);
+    body->shape_shared = share(body->shape_shared);
+    *clone = *body;
+    clone->store = store;
+    body_store_set_owner(store, body->slot, clone);
+    return clone;
+}
+
+body_store_t *body_get_store(body_t *body){
+    return body->store;
+}
+
+size_t body_get_slot(body_t *body){
+    assert(body->store != NULL);
+    return body->slot;
+}
+
+void body_set_slot(body_t *body, size_t slot){
+    body->slot = slot;
+}
+
 void body_free_vec_list(list_t *list){
     size_t size_of_list = list_size(list);
     for(size_t i = 0; i < size_of_list; i++){
@@ -73,45 +313,117 @@ void body_free_vec_list(list_t *list){
 }
 
 void body_free(body_t *body){
-    list_free(body->shape);
-    free(body);
+    if(release(body->local_shared)){
+        polygon_free(body->local);
+        free(body->local_normals);
+    }
+    if(release(body->shape_shared)){
+        polygon_free(body->shape);
+        free(body->normals);
+    }
+    pthread_mutex_lock(&body_pool_lock);
+    pool_release(body_pool, body);
+    pthread_mutex_unlock(&body_pool_lock);
 }
 
 void body_hide(body_t *body){
     body->hide = true;
 }
 
+void body_set_bullet(body_t *body, bool bullet){
+    body->bullet = bullet;
+}
+
+bool body_is_bullet(body_t *body){
+    return body->bullet;
+}
+
+bool body_is_asleep(body_t *body){
+    return body->store != NULL && body_store_asleep(body->store)[body->slot];
+}
+
+void body_wake(body_t *body){
+    if(body->store != NULL) body_store_wake(body->store, body->slot);
+}
+
 bool body_is_hidden(body_t *body){
     return body->hide;
 }
 
 list_t *body_get_shape(body_t *body){
-    list_t *shape = body->shape;
-    list_t* new_shape = list_init(list_size(shape), (free_func_t) body_free_vec_list);
-    for(size_t i = 0; i<list_size(shape); i++){
-        vector_t* vec = list_get(shape, i);
-        vector_t* new_vec = malloc(sizeof(vector_t));
-        new_vec->x = vec->x;
-        new_vec->y = vec->y;
-        list_add(new_shape, new_vec);
-    }
-    return new_shape;
+    body_sync_shape(body);
+    return polygon_to_list(body->shape);
+}
+
+polygon_t *body_get_polygon(body_t *body){
+    body_sync_shape(body);
+    return polygon_copy(body->shape);
+}
+
+const vector_t *body_shape_view(body_t *body, size_t *count){
+    body_sync_shape(body);
+    *count = polygon_size(body->shape);
+    return polygon_points(body->shape);
+}
+
+const vector_t *body_axes_view(body_t *body, const vector_t **intervals){
+    body_sync_shape(body);
+    *intervals = body->intervals;
+    return body->normals;
 }
 
 vector_t body_get_centroid(body_t *body){
-    return body->centroid;
+    return *centroid_ref(body);
+}
+
+shape_kind_t body_get_shape_kind(body_t *body){
+    return body->kind;
+}
+
+double body_get_radius(body_t *body){
+    return body->radius;
+}
+
+void body_get_segment(body_t *body, vector_t *start, vector_t *end){
+    vector_t centroid = *centroid_ref(body);
+    vector_t half = vec_rotate(body->half_segment, body->angle);
+    *start = vec_subtract(centroid, half);
+    *end = vec_add(centroid, half);
+}
+
+aabb_t body_get_bounds(body_t *body){
+    if(body->kind != SHAPE_POLYGON){
+        vector_t start, end;
+        body_get_segment(body, &start, &end);
+        aabb_t bounds = {
+            .min = {.x = fmin(start.x, end.x) - body->radius, .y = fmin(start.y, end.y) - body->radius},
+            .max = {.x = fmax(start.x, end.x) + body->radius, .y = fmax(start.y, end.y) + body->radius}
+        };
+        return bounds;
+    }
+    body_sync_shape(body);
+    vector_t *points = polygon_points(body->shape);
+    aabb_t bounds = {.min = {.x = INFINITY, .y = INFINITY}, .max = {.x = -INFINITY, .y = -INFINITY}};
+    for(size_t i = 0; i < polygon_size(body->shape); i++){
+        vector_t *point = &points[i];
+        if(point->x < bounds.min.x) bounds.min.x = point->x;
+        if(point->x > bounds.max.x) bounds.max.x = point->x;
+        if(point->y < bounds.min.y) bounds.min.y = point->y;
+        if(point->y > bounds.max.y) bounds.max.y = point->y;
+    }
+    return bounds;
 }
 
 vector_t body_get_velocity(body_t *body){
-    return body->velocity;
+    return *velocity_ref(body);
 }
 
 vector_t body_get_force(body_t *body){
-    return body->force;
+    return *force_ref(body);
 }
 
 vector_t body_get_impulse(body_t *body) {
-    return body->impulse;
+    return *impulse_ref(body);
 }
 
 rgb_color_t body_get_color(body_t *body) {
@@ -156,17 +468,52 @@ void *body_get_info(body_t *body){
     return body->info;
 }
 
+vector_t body_get_previous_centroid(body_t *body){
+    if(body->store == NULL) return body->centroid;
+    return body_store_previous_centroids(body->store)[body->slot];
+}
+
 void body_set_centroid(body_t *body, vector_t x){
-    polygon_translate(body->shape, vec_subtract(x, body->centroid));
-    body->centroid = x;
+    vector_t *centroid = centroid_ref(body);
+    // putting a body back where it is leaves it asleep
+    if(x.x == centroid->x && x.y == centroid->y) return;
+    *centroid = x;
+    // a body that is placed somewhere is drawn there, instead of sliding over from where it was
+    if(body->store != NULL) body_store_previous_centroids(body->store)[body->slot] = x;
+    body_wake(body);
+}
+
+void body_translate(body_t *body, vector_t offset){
+    if(offset.x == 0 && offset.y == 0) return;
+    vector_t *centroid = centroid_ref(body);
+    *centroid = vec_add(*centroid, offset);
+    if(body->store != NULL){
+        vector_t *previous = &body_store_previous_centroids(body->store)[body->slot];
+        *previous = vec_add(*previous, offset);
+    }
+    body_wake(body);
 }
 
 void body_set_velocity(body_t *body, vector_t v) {
-    body->velocity = v;
+    *velocity_ref(body) = v;
+    // stopping a body that is already asleep leaves it asleep
+    if(v.x != 0 || v.y != 0) body_wake(body);
 }
 
 void body_set_rotation(body_t *body, double angle) {
-    polygon_rotate(body->shape, angle, body->centroid);
+    body->angle += angle;
+    body->shape_dirty = true;
+    body_wake(body);
+}
+
+double body_get_angle(body_t *body){
+    return body->angle;
+}
+
+void body_set_angle(body_t *body, double angle){
+    if(angle == body->angle) return;
+    body->angle = angle;
+    body->shape_dirty = true;
 }
 
 void body_set_orientation(body_t *body, int orientation) {
@@ -174,20 +521,26 @@ void body_set_orientation(body_t *body, int orientation) {
 }
 
 void body_tick(body_t *body, double dt) {
-    vector_t new_vel = vec_add(body->velocity, vec_multiply((dt/body->mass), body->force));
-    new_vel = vec_add(vec_multiply(1/body->mass, body->impulse), new_vel);
-    body_set_centroid(body, vec_add(vec_multiply(dt/2, vec_add(body->velocity, new_vel)), body_get_centroid(body)));
-    body->velocity = new_vel;
-    body->force = VEC_ZERO;
-    body->impulse = VEC_ZERO;
+    vector_t *velocity = velocity_ref(body);
+    vector_t *force = force_ref(body);
+    vector_t *impulse = impulse_ref(body);
+    vector_t new_vel = vec_add(*velocity, vec_multiply((dt/body->mass), *force));
+    new_vel = vec_add(vec_multiply(1/body->mass, *impulse), new_vel);
+    body_set_centroid(body, vec_add(vec_multiply(dt/2, vec_add(*velocity, new_vel)), body_get_centroid(body)));
+    *velocity = new_vel;
+    *force = VEC_ZERO;
+    *impulse = VEC_ZERO;
 }
 
 void body_add_force(body_t *body, vector_t force){
-    body->force = vec_add(body->force, force);
+    vector_t *total = force_ref(body);
+    *total = vec_add(*total, force);
 }
 
 void body_add_impulse(body_t *body, vector_t impulse){
-     body->impulse = vec_add(body->impulse, impulse);
+    vector_t *total = impulse_ref(body);
+    *total = vec_add(*total, impulse);
+    body_wake(body);
 }
 
 void body_remove(body_t *body){
@@ -198,23 +551,28 @@ bool body_is_removed(body_t *body){
     return(body->removed);
 }
 
-SDL_Rect *body_get_rect(body_t *body){
-    list_t *shape = body->shape;
+size_t body_get_proxy(body_t *body){
+    return body->proxy;
+}
+
+void body_set_proxy(body_t *body, size_t proxy){
+    body->proxy = proxy;
+}
+
+SDL_Rect body_get_rect(body_t *body){
+    body_sync_shape(body);
+    vector_t *points = polygon_points(body->shape);
     double minx = INT16_MAX;
     double maxx = INT16_MIN;
     double miny = INT16_MAX;
     double maxy = INT16_MIN;
-    for(size_t i = 0; i<list_size(shape); i++){
-        vector_t *point = list_get(shape, i);
+    for(size_t i = 0; i<polygon_size(body->shape); i++){
+        vector_t *point = &points[i];
         if(point->x < minx) minx = point->x;
         if(point->x > maxx) maxx = point->x;
         if(point->y < miny) miny = point->y;
         if(point->y > maxy) maxy = point->y;
     }
-    SDL_Rect *rect = malloc(sizeof(*rect));
-    rect->x = minx;
-    rect->y = miny;
-    rect->w = maxx - minx;
-    rect->h = maxy - miny;
+    SDL_Rect rect = {.x = minx, .y = miny, .w = maxx - minx, .h = maxy - miny};
     return rect;
 }
\ No newline at end of file
@@ -0,0 +1,246 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "body_store.h"
+#include "snapshot.h"
+
+const size_t BODY_STORE_MIN_SIZE = 8;
+
+typedef struct body_store{
+    size_t size;
+    size_t capacity;
+    vector_t *centroids;
+    // the centroids when body_store_save_previous() was last called
+    vector_t *previous_centroids;
+    vector_t *velocities;
+    vector_t *forces;
+    vector_t *impulses;
+    double *masses;
+    double *inverse_masses;
+    void **owners;
+    bool *asleep;
+    // the number of ticks each body has been moving slower than the scene's sleep speed
+    size_t *still_ticks;
+} body_store_t;
+
+static void *resize_array(void *array, size_t capacity, size_t element_size){
+    array = realloc(array, capacity * element_size);
+    assert(array);
+    return array;
+}
+
+static void body_store_reserve(body_store_t *store, size_t capacity){
+    store->centroids = resize_array(store->centroids, capacity, sizeof(vector_t));
+    store->previous_centroids = resize_array(store->previous_centroids, capacity, sizeof(vector_t));
+    store->velocities = resize_array(store->velocities, capacity, sizeof(vector_t));
+    store->forces = resize_array(store->forces, capacity, sizeof(vector_t));
+    store->impulses = resize_array(store->impulses, capacity, sizeof(vector_t));
+    store->masses = resize_array(store->masses, capacity, sizeof(double));
+    store->inverse_masses = resize_array(store->inverse_masses, capacity, sizeof(double));
+    store->owners = resize_array(store->owners, capacity, sizeof(void *));
+    store->asleep = resize_array(store->asleep, capacity, sizeof(bool));
+    store->still_ticks = resize_array(store->still_ticks, capacity, sizeof(size_t));
+    store->capacity = capacity;
+}
+
+body_store_t *body_store_init(size_t initial_size){
+    body_store_t *store = malloc(sizeof(body_store_t));
+    assert(store);
+    store->size = 0;
+    store->centroids = NULL;
+    store->previous_centroids = NULL;
+    store->velocities = NULL;
+    store->forces = NULL;
+    store->impulses = NULL;
+    store->masses = NULL;
+    store->inverse_masses = NULL;
+    store->owners = NULL;
+    store->asleep = NULL;
+    store->still_ticks = NULL;
+    body_store_reserve(store, initial_size > BODY_STORE_MIN_SIZE ? initial_size : BODY_STORE_MIN_SIZE);
+    return store;
+}
+
+void body_store_free(body_store_t *store){
+    free(store->centroids);
+    free(store->previous_centroids);
+    free(store->velocities);
+    free(store->forces);
+    free(store->impulses);
+    free(store->masses);
+    free(store->inverse_masses);
+    free(store->owners);
+    free(store->asleep);
+    free(store->still_ticks);
+    free(store);
+}
+
+body_store_t *body_store_clone(body_store_t *store){
+    body_store_t *clone = body_store_init(store->size);
+    size_t n = store->size;
+    clone->size = n;
+    memcpy(clone->centroids, store->centroids, n * sizeof(vector_t));
+    memcpy(clone->previous_centroids, store->previous_centroids, n * sizeof(vector_t));
+    memcpy(clone->velocities, store->velocities, n * sizeof(vector_t));
+    memcpy(clone->forces, store->forces, n * sizeof(vector_t));
+    memcpy(clone->impulses, store->impulses, n * sizeof(vector_t));
+    memcpy(clone->masses, store->masses, n * sizeof(double));
+    memcpy(clone->inverse_masses, store->inverse_masses, n * sizeof(double));
+    memcpy(clone->owners, store->owners, n * sizeof(void *));
+    memcpy(clone->asleep, store->asleep, n * sizeof(bool));
+    memcpy(clone->still_ticks, store->still_ticks, n * sizeof(size_t));
+    return clone;
+}
+
+size_t body_store_size(body_store_t *store){
+    return store->size;
+}
+
+size_t body_store_add(body_store_t *store, void *owner, vector_t centroid, vector_t velocity, double mass){
+    if(store->size == store->capacity) body_store_reserve(store, 2 * store->capacity);
+    size_t slot = store->size++;
+    store->centroids[slot] = centroid;
+    store->previous_centroids[slot] = centroid;
+    store->velocities[slot] = velocity;
+    store->forces[slot] = VEC_ZERO;
+    store->impulses[slot] = VEC_ZERO;
+    store->masses[slot] = mass;
+    store->inverse_masses[slot] = 1 / mass;
+    store->owners[slot] = owner;
+    store->asleep[slot] = false;
+    store->still_ticks[slot] = 0;
+    return slot;
+}
+
+void *body_store_remove(body_store_t *store, size_t slot){
+    assert(slot < store->size);
+    size_t last = --store->size;
+    if(slot == last) return NULL;
+    store->centroids[slot] = store->centroids[last];
+    store->previous_centroids[slot] = store->previous_centroids[last];
+    store->velocities[slot] = store->velocities[last];
+    store->forces[slot] = store->forces[last];
+    store->impulses[slot] = store->impulses[last];
+    store->masses[slot] = store->masses[last];
+    store->inverse_masses[slot] = store->inverse_masses[last];
+    store->owners[slot] = store->owners[last];
+    store->asleep[slot] = store->asleep[last];
+    store->still_ticks[slot] = store->still_ticks[last];
+    return store->owners[slot];
+}
+
+void *body_store_get_owner(body_store_t *store, size_t slot){
+    assert(slot < store->size);
+    return store->owners[slot];
+}
+
+void body_store_set_owner(body_store_t *store, size_t slot, void *owner){
+    assert(slot < store->size);
+    store->owners[slot] = owner;
+}
+
+vector_t *body_store_centroids(body_store_t *store){
+    return store->centroids;
+}
+
+vector_t *body_store_previous_centroids(body_store_t *store){
+    return store->previous_centroids;
+}
+
+void body_store_save_previous(body_store_t *store){
+    memcpy(store->previous_centroids, store->centroids, store->size * sizeof(vector_t));
+}
+
+vector_t *body_store_velocities(body_store_t *store){
+    return store->velocities;
+}
+
+vector_t *body_store_forces(body_store_t *store){
+    return store->forces;
+}
+
+vector_t *body_store_impulses(body_store_t *store){
+    return store->impulses;
+}
+
+double *body_store_masses(body_store_t *store){
+    return store->masses;
+}
+
+double *body_store_inverse_masses(body_store_t *store){
+    return store->inverse_masses;
+}
+
+bool *body_store_asleep(body_store_t *store){
+    return store->asleep;
+}
+
+size_t *body_store_still_ticks(body_store_t *store){
+    return store->still_ticks;
+}
+
+void body_store_wake(body_store_t *store, size_t slot){
+    assert(slot < store->size);
+    store->asleep[slot] = false;
+    store->still_ticks[slot] = 0;
+}
+
+void body_store_integrate(body_store_t *store, double dt){
+    body_store_integrate_range(store, dt, 0, store->size);
+}
+
+void body_store_integrate_range(body_store_t *store, double dt, size_t start, size_t end){
+    assert(start <= end && end <= store->size);
+    vector_t *centroids = store->centroids;
+    vector_t *velocities = store->velocities;
+    vector_t *forces = store->forces;
+    vector_t *impulses = store->impulses;
+    double *inverse_masses = store->inverse_masses;
+    for(size_t i = start; i < end; i++){
+        if(store->asleep[i]){
+            forces[i] = VEC_ZERO;
+            impulses[i] = VEC_ZERO;
+            continue;
+        }
+        double inverse_mass = inverse_masses[i];
+        vector_t old_velocity = velocities[i];
+        vector_t new_velocity = {
+            .x = old_velocity.x + dt * inverse_mass * forces[i].x + inverse_mass * impulses[i].x,
+            .y = old_velocity.y + dt * inverse_mass * forces[i].y + inverse_mass * impulses[i].y
+        };
+        centroids[i].x += dt / 2 * (old_velocity.x + new_velocity.x);
+        centroids[i].y += dt / 2 * (old_velocity.y + new_velocity.y);
+        velocities[i] = new_velocity;
+        forces[i] = VEC_ZERO;
+        impulses[i] = VEC_ZERO;
+    }
+}
+
+size_t body_store_snapshot(body_store_t *store, void *buffer){
+    size_t n = store->size;
+    size_t offset = 0;
+    snapshot_write(buffer, &offset, &n, sizeof(size_t));
+    snapshot_write(buffer, &offset, store->centroids, n * sizeof(vector_t));
+    snapshot_write(buffer, &offset, store->previous_centroids, n * sizeof(vector_t));
+    snapshot_write(buffer, &offset, store->velocities, n * sizeof(vector_t));
+    snapshot_write(buffer, &offset, store->forces, n * sizeof(vector_t));
+    snapshot_write(buffer, &offset, store->impulses, n * sizeof(vector_t));
+    snapshot_write(buffer, &offset, store->still_ticks, n * sizeof(size_t));
+    snapshot_write(buffer, &offset, store->asleep, n * sizeof(bool));
+    return offset;
+}
+
+size_t body_store_restore(body_store_t *store, const void *buffer){
+    size_t n;
+    size_t offset = 0;
+    snapshot_read(buffer, &offset, &n, sizeof(size_t));
+    assert(n == store->size);
+    snapshot_read(buffer, &offset, store->centroids, n * sizeof(vector_t));
+    snapshot_read(buffer, &offset, store->previous_centroids, n * sizeof(vector_t));
+    snapshot_read(buffer, &offset, store->velocities, n * sizeof(vector_t));
+    snapshot_read(buffer, &offset, store->forces, n * sizeof(vector_t));
+    snapshot_read(buffer, &offset, store->impulses, n * sizeof(vector_t));
+    snapshot_read(buffer, &offset, store->still_ticks, n * sizeof(size_t));
+    snapshot_read(buffer, &offset, store->asleep, n * sizeof(bool));
+    return offset;
+}
@@ -0,0 +1,172 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <math.h>
+#include "broadphase.h"
+
+// boxes covering more cells than this are compared against every box instead
+const int64_t BROADPHASE_MAX_CELLS = 64;
+const double BROADPHASE_MAX_CELL_INDEX = 1 << 30;
+const size_t BROADPHASE_INITIAL_SIZE = 64;
+
+typedef struct{
+    void *item;
+    aabb_t box;
+    // the range of grid cells covered by the box
+    int32_t min_x;
+    int32_t min_y;
+    int32_t max_x;
+    int32_t max_y;
+    bool oversized;
+} broadphase_entry_t;
+
+typedef struct{
+    uint64_t cell;
+    uint32_t entry;
+} cell_ref_t;
+
+typedef struct broadphase{
+    double cell_size;
+    broadphase_entry_t *entries;
+    size_t num_entries;
+    size_t entries_capacity;
+    cell_ref_t *refs;
+    size_t num_refs;
+    size_t refs_capacity;
+    uint32_t *oversized;
+    size_t num_oversized;
+    size_t oversized_capacity;
+} broadphase_t;
+
+// grows a manually managed array so it can hold at least needed elements
+static void *grow_array(void *array, size_t *capacity, size_t needed, size_t element_size){
+    if(needed <= *capacity) return array;
+    size_t new_capacity = *capacity ? *capacity : BROADPHASE_INITIAL_SIZE;
+    while(new_capacity < needed) new_capacity *= 2;
+    array = realloc(array, new_capacity * element_size);
+    assert(array);
+    *capacity = new_capacity;
+    return array;
+}
+
+broadphase_t *broadphase_init(void){
+    broadphase_t *broadphase = malloc(sizeof(broadphase_t));
+    assert(broadphase);
+    broadphase->cell_size = 1;
+    broadphase->entries = NULL;
+    broadphase->num_entries = 0;
+    broadphase->entries_capacity = 0;
+    broadphase->refs = NULL;
+    broadphase->num_refs = 0;
+    broadphase->refs_capacity = 0;
+    broadphase->oversized = NULL;
+    broadphase->num_oversized = 0;
+    broadphase->oversized_capacity = 0;
+    return broadphase;
+}
+
+void broadphase_free(broadphase_t *broadphase){
+    free(broadphase->entries);
+    free(broadphase->refs);
+    free(broadphase->oversized);
+    free(broadphase);
+}
+
+void broadphase_clear(broadphase_t *broadphase, double cell_size){
+    assert(cell_size > 0);
+    broadphase->cell_size = cell_size;
+    broadphase->num_entries = 0;
+    broadphase->num_refs = 0;
+    broadphase->num_oversized = 0;
+}
+
+static int32_t cell_index(broadphase_t *broadphase, double coordinate){
+    double index = floor(coordinate / broadphase->cell_size);
+    // clamping keeps far-away bodies from overflowing the cell coordinates
+    if(!(index > -BROADPHASE_MAX_CELL_INDEX)) index = -BROADPHASE_MAX_CELL_INDEX;
+    if(index > BROADPHASE_MAX_CELL_INDEX) index = BROADPHASE_MAX_CELL_INDEX;
+    return (int32_t) index;
+}
+
+static uint64_t cell_key(int32_t x, int32_t y){
+    return ((uint64_t) (uint32_t) x << 32) | (uint32_t) y;
+}
+
+void broadphase_insert(broadphase_t *broadphase, void *item, aabb_t box){
+    broadphase->entries = grow_array(broadphase->entries, &broadphase->entries_capacity,
+        broadphase->num_entries + 1, sizeof(broadphase_entry_t));
+    uint32_t index = broadphase->num_entries++;
+    broadphase_entry_t *entry = &broadphase->entries[index];
+    entry->item = item;
+    entry->box = box;
+    entry->min_x = cell_index(broadphase, box.min.x);
+    entry->min_y = cell_index(broadphase, box.min.y);
+    entry->max_x = cell_index(broadphase, box.max.x);
+    entry->max_y = cell_index(broadphase, box.max.y);
+    int64_t cells = ((int64_t) entry->max_x - entry->min_x + 1) * ((int64_t) entry->max_y - entry->min_y + 1);
+    entry->oversized = cells > BROADPHASE_MAX_CELLS;
+    if(entry->oversized){
+        broadphase->oversized = grow_array(broadphase->oversized, &broadphase->oversized_capacity,
+            broadphase->num_oversized + 1, sizeof(uint32_t));
+        broadphase->oversized[broadphase->num_oversized++] = index;
+        return;
+    }
+    broadphase->refs = grow_array(broadphase->refs, &broadphase->refs_capacity,
+        broadphase->num_refs + cells, sizeof(cell_ref_t));
+    for(int32_t x = entry->min_x; x <= entry->max_x; x++){
+        for(int32_t y = entry->min_y; y <= entry->max_y; y++){
+            cell_ref_t ref = {.cell = cell_key(x, y), .entry = index};
+            broadphase->refs[broadphase->num_refs++] = ref;
+        }
+    }
+}
+
+static int compare_refs(const void *ref1, const void *ref2){
+    const cell_ref_t *r1 = ref1;
+    const cell_ref_t *r2 = ref2;
+    if(r1->cell != r2->cell) return r1->cell < r2->cell ? -1 : 1;
+    return (r1->entry > r2->entry) - (r1->entry < r2->entry);
+}
+
+static int32_t max_int(int32_t a, int32_t b){
+    return a > b ? a : b;
+}
+
+size_t broadphase_find_pairs(broadphase_t *broadphase, pair_handler_t handler, void *aux){
+    size_t num_pairs = 0;
+    broadphase_entry_t *entries = broadphase->entries;
+    // sorting the cell references groups together all boxes in each cell
+    qsort(broadphase->refs, broadphase->num_refs, sizeof(cell_ref_t), compare_refs);
+    size_t start = 0;
+    while(start < broadphase->num_refs){
+        uint64_t cell = broadphase->refs[start].cell;
+        size_t end = start + 1;
+        while(end < broadphase->num_refs && broadphase->refs[end].cell == cell) end++;
+        for(size_t i = start; i < end; i++){
+            broadphase_entry_t *entry1 = &entries[broadphase->refs[i].entry];
+            for(size_t j = i + 1; j < end; j++){
+                broadphase_entry_t *entry2 = &entries[broadphase->refs[j].entry];
+                if(!aabb_overlap(entry1->box, entry2->box)) continue;
+                // a pair sharing several cells is only reported from the first one
+                uint64_t first_shared = cell_key(max_int(entry1->min_x, entry2->min_x), max_int(entry1->min_y, entry2->min_y));
+                if(first_shared != cell) continue;
+                handler(entry1->item, entry2->item, aux);
+                num_pairs++;
+            }
+        }
+        start = end;
+    }
+    for(size_t i = 0; i < broadphase->num_oversized; i++){
+        uint32_t big = broadphase->oversized[i];
+        for(uint32_t other = 0; other < broadphase->num_entries; other++){
+            // pairs of two oversized boxes are only reported once
+            if(other == big || (entries[other].oversized && other < big)) continue;
+            if(!aabb_overlap(entries[big].box, entries[other].box)) continue;
+            if(other < big) handler(entries[other].item, entries[big].item, aux);
+            else handler(entries[big].item, entries[other].item, aux);
+            num_pairs++;
+        }
+    }
+    return num_pairs;
+}
@@ -8,21 +8,81 @@
 #include "polygon.h"
 #include "collision.h"
 
+// vertices are projected two (SSE2) or four (AVX) at a time when the compiler targets it
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// shapes with at most this many vertices keep their axes on the stack in find_collisions()
+#define MAX_STACK_AXES 32
+
 typedef struct{
     collision_info_t collision_info;
     double overlap;
 }collision_helper_t;
 
-double get_vector_proj(vector_t vec1, vector_t vec2){
-    vector_t unit_vec2 = vec_multiply(1/sqrt(vec_dot(vec2, vec2)), vec2);
-    return vec_dot(vec1, unit_vec2);
+// the unit normal of the edge starting at vertex i
+static vector_t edge_normal(const vector_t *points, size_t n, size_t i){
+    vector_t edge = vec_subtract(points[i], points[(i + 1) % n]);
+    // the edge turned a quarter turn counterclockwise
+    vector_t axis = {-edge.y, edge.x};
+    return vec_multiply(1/sqrt(vec_dot(axis, axis)), axis);
 }
 
-vector_t get_polygon_proj(list_t *shape, vector_t vec){
+// the interval (min, max) the points cover along a unit axis
+static vector_t get_polygon_proj(const vector_t *points, size_t n, vector_t unit){
     double min = INT16_MAX;
     double max = INT16_MIN;
-    for(size_t i = 0; i < list_size(shape); i++){
-        double proj = get_vector_proj(*(vector_t *)list_get(shape, i), vec);
+    size_t i = 0;
+#if defined(__AVX__)
+    __m256d ux = _mm256_set1_pd(unit.x);
+    __m256d uy = _mm256_set1_pd(unit.y);
+    __m256d mins = _mm256_set1_pd(min);
+    __m256d maxs = _mm256_set1_pd(max);
+    for(; i + 4 <= n; i += 4){
+        __m256d a = _mm256_loadu_pd(&points[i].x);
+        __m256d b = _mm256_loadu_pd(&points[i + 2].x);
+        __m256d xs = _mm256_unpacklo_pd(a, b);
+        __m256d ys = _mm256_unpackhi_pd(a, b);
+        __m256d proj = _mm256_add_pd(_mm256_mul_pd(xs, ux), _mm256_mul_pd(ys, uy));
+        mins = _mm256_min_pd(proj, mins);
+        maxs = _mm256_max_pd(proj, maxs);
+    }
+    double lanes_min[4];
+    double lanes_max[4];
+    _mm256_storeu_pd(lanes_min, mins);
+    _mm256_storeu_pd(lanes_max, maxs);
+    for(int lane = 0; lane < 4; lane++){
+        if(lanes_min[lane] < min) min = lanes_min[lane];
+        if(lanes_max[lane] > max) max = lanes_max[lane];
+    }
+#elif defined(__SSE2__)
+    __m128d ux = _mm_set1_pd(unit.x);
+    __m128d uy = _mm_set1_pd(unit.y);
+    __m128d mins = _mm_set1_pd(min);
+    __m128d maxs = _mm_set1_pd(max);
+    for(; i + 2 <= n; i += 2){
+        __m128d a = _mm_loadu_pd(&points[i].x);
+        __m128d b = _mm_loadu_pd(&points[i + 1].x);
+        __m128d xs = _mm_unpacklo_pd(a, b);
+        __m128d ys = _mm_unpackhi_pd(a, b);
+        __m128d proj = _mm_add_pd(_mm_mul_pd(xs, ux), _mm_mul_pd(ys, uy));
+        mins = _mm_min_pd(proj, mins);
+        maxs = _mm_max_pd(proj, maxs);
+    }
+    double lanes_min[2];
+    double lanes_max[2];
+    _mm_storeu_pd(lanes_min, mins);
+    _mm_storeu_pd(lanes_max, maxs);
+    for(int lane = 0; lane < 2; lane++){
+        if(lanes_min[lane] < min) min = lanes_min[lane];
+        if(lanes_max[lane] > max) max = lanes_max[lane];
+    }
+#endif
+    for(; i < n; i++){
+        double proj = points[i].x * unit.x + points[i].y * unit.y;
         if(proj < min) min = proj;
         if(proj > max) max = proj;
     }
@@ -30,40 +90,302 @@ vector_t get_polygon_proj(list_t *shape, vector_t vec){
     return poly_proj;
 }
 
-collision_helper_t collision_helper(list_t *shape1, list_t *shape2) {
-    double min_overlap = INT16_MAX;
-    vector_t min_axis;
-
-    for(size_t i = 0; i < list_size(shape1); i++) {
-        vector_t *point1 = (vector_t*) list_get(shape1, i);
-        vector_t *point2 = (vector_t*) list_get(shape1, (i + 1) % list_size(shape1));
-        vector_t edge = vec_subtract(*point1, *point2);
-        vector_t axis = vec_rotate(edge, M_PI / 2);
-        vector_t proj1 = get_polygon_proj(shape1, axis);
-        vector_t proj2 = get_polygon_proj(shape2, axis);
-        axis = vec_multiply(1/sqrt(vec_dot(axis, axis)), axis);
-        if ((proj1.x < proj2.x && proj1.y < proj2.x) || (proj2.x < proj1.x && proj2.y < proj1.x)) {
-            collision_info_t not_collide = {.collided = false};
-            collision_helper_t not_collide_helper = {.collision_info = not_collide, .overlap = 0};
-            return not_collide_helper;
-        }
-        double overlap = fmin(proj1.y, proj2.y) - fmax(proj1.x, proj2.x);
-        if(overlap < min_overlap){
-            min_overlap = overlap;
-            min_axis = axis;
-        }
+// tests one axis, keeping the axis with the smallest overlap so far; returns false if it separates the shapes
+static bool test_axis(vector_t axis, vector_t proj1, vector_t proj2, collision_helper_t *result){
+    if ((proj1.x < proj2.x && proj1.y < proj2.x) || (proj2.x < proj1.x && proj2.y < proj1.x)) {
+        collision_info_t not_collide = {.collided = false};
+        result->collision_info = not_collide;
+        result->overlap = 0;
+        return false;
+    }
+    double overlap = fmin(proj1.y, proj2.y) - fmax(proj1.x, proj2.x);
+    if(overlap < result->overlap){
+        result->overlap = overlap;
+        result->collision_info.axis = axis;
+        result->collision_info.depth = overlap;
     }
-    collision_info_t collide = {.collided = true, .axis = min_axis};
-    collision_helper_t collide_helper = {.collision_info = collide, .overlap = min_overlap};
-    return collide_helper;
+    return true;
 }
 
-collision_info_t find_collision(list_t *shape1, list_t *shape2){
-    collision_helper_t shape1_collide = collision_helper(shape1, shape2);
-    collision_helper_t shape2_collide = collision_helper(shape2, shape1); 
+static collision_helper_t helper_init(void){
+    collision_helper_t helper = {.collision_info = {.collided = true, .axis = VEC_ZERO}, .overlap = INT16_MAX};
+    return helper;
+}
+
+static collision_helper_t collision_helper(const vector_t *shape1, size_t n1, const vector_t *shape2, size_t n2) {
+    collision_helper_t result = helper_init();
+    for(size_t i = 0; i < n1; i++) {
+        vector_t axis = edge_normal(shape1, n1, i);
+        vector_t proj1 = get_polygon_proj(shape1, n1, axis);
+        vector_t proj2 = get_polygon_proj(shape2, n2, axis);
+        if(!test_axis(axis, proj1, proj2, &result)) break;
+    }
+    return result;
+}
+
+// like collision_helper(), with shape1's axes and its extent along them already known
+static collision_helper_t cached_helper(const vector_t *normals1, const vector_t *intervals1, size_t n1, const vector_t *shape2, size_t n2) {
+    collision_helper_t result = helper_init();
+    for(size_t i = 0; i < n1; i++) {
+        vector_t proj2 = get_polygon_proj(shape2, n2, normals1[i]);
+        if(!test_axis(normals1[i], intervals1[i], proj2, &result)) break;
+    }
+    return result;
+}
+
+static collision_info_t combine(collision_helper_t shape1_collide, collision_helper_t shape2_collide){
     if(!shape1_collide.collision_info.collided || !shape2_collide.collision_info.collided) return (collision_info_t){.collided = false};
     if(shape1_collide.overlap < shape2_collide.overlap){
         return shape1_collide.collision_info;
     }
     return shape2_collide.collision_info;
-}
\ No newline at end of file
+}
+
+collision_info_t find_collision(list_t *shape1, list_t *shape2){
+    polygon_t *polygon1 = polygon_from_list(shape1);
+    polygon_t *polygon2 = polygon_from_list(shape2);
+    collision_info_t info = find_polygon_collision(polygon1, polygon2);
+    polygon_free(polygon1);
+    polygon_free(polygon2);
+    return info;
+}
+
+collision_info_t find_polygon_collision(polygon_t *shape1, polygon_t *shape2){
+    return find_collision_points(polygon_points(shape1), polygon_size(shape1), polygon_points(shape2), polygon_size(shape2));
+}
+
+collision_info_t find_collision_points(const vector_t *shape1, size_t n1, const vector_t *shape2, size_t n2){
+    collision_helper_t shape1_collide = collision_helper(shape1, n1, shape2, n2);
+    if(!shape1_collide.collision_info.collided) return shape1_collide.collision_info;
+    collision_helper_t shape2_collide = collision_helper(shape2, n2, shape1, n1);
+    return combine(shape1_collide, shape2_collide);
+}
+
+void find_edge_axes(const vector_t *shape, size_t n, vector_t *normals, vector_t *intervals){
+    for(size_t i = 0; i < n; i++){
+        normals[i] = edge_normal(shape, n, i);
+        intervals[i] = get_polygon_proj(shape, n, normals[i]);
+    }
+}
+
+collision_info_t find_collision_axes(
+    const vector_t *shape1,
+    size_t n1,
+    const vector_t *normals1,
+    const vector_t *intervals1,
+    const vector_t *shape2,
+    size_t n2,
+    const vector_t *normals2,
+    const vector_t *intervals2
+){
+    collision_helper_t shape1_collide = cached_helper(normals1, intervals1, n1, shape2, n2);
+    if(!shape1_collide.collision_info.collided) return shape1_collide.collision_info;
+    collision_helper_t shape2_collide = cached_helper(normals2, intervals2, n2, shape1, n1);
+    return combine(shape1_collide, shape2_collide);
+}
+
+void find_collisions(const vector_t *shape, size_t n, const vector_t *const *others, const size_t *counts, size_t num_others, collision_info_t *results){
+    // the shape's own axes, and its extent along each, are the same against every other shape
+    vector_t stack_axes[2 * MAX_STACK_AXES];
+    vector_t *axes = stack_axes;
+    if(n > MAX_STACK_AXES){
+        axes = malloc(2 * n * sizeof(vector_t));
+        assert(axes);
+    }
+    vector_t *intervals = axes + n;
+    find_edge_axes(shape, n, axes, intervals);
+    for(size_t k = 0; k < num_others; k++){
+        collision_helper_t shape_collide = helper_init();
+        for(size_t i = 0; i < n; i++){
+            vector_t proj2 = get_polygon_proj(others[k], counts[k], axes[i]);
+            if(!test_axis(axes[i], intervals[i], proj2, &shape_collide)) break;
+        }
+        if(!shape_collide.collision_info.collided){
+            results[k] = shape_collide.collision_info;
+            continue;
+        }
+        collision_helper_t other_collide = collision_helper(others[k], counts[k], shape, n);
+        results[k] = combine(shape_collide, other_collide);
+    }
+    if(axes != stack_axes) free(axes);
+}
+
+// the unit vector along diff, or an arbitrary one if diff is zero
+static vector_t unit_or_default(vector_t diff, double length){
+    if(length == 0) return (vector_t){.x = 1, .y = 0};
+    return vec_multiply(1 / length, diff);
+}
+
+// the point on the segment from start to end closest to point
+static vector_t closest_on_segment(vector_t point, vector_t start, vector_t end){
+    vector_t edge = vec_subtract(end, start);
+    double length_squared = vec_dot(edge, edge);
+    if(length_squared == 0) return start;
+    double t = vec_dot(vec_subtract(point, start), edge) / length_squared;
+    if(t < 0) t = 0;
+    if(t > 1) t = 1;
+    return vec_add(start, vec_multiply(t, edge));
+}
+
+static collision_info_t flip(collision_info_t info){
+    info.axis = vec_negate(info.axis);
+    return info;
+}
+
+collision_info_t find_circle_collision(vector_t center1, double radius1, vector_t center2, double radius2){
+    collision_info_t info = {.collided = false};
+    vector_t diff = vec_subtract(center2, center1);
+    double dist_squared = vec_dot(diff, diff);
+    double reach = radius1 + radius2;
+    if(dist_squared > reach * reach) return info;
+    double dist = sqrt(dist_squared);
+    info.collided = true;
+    info.axis = unit_or_default(diff, dist);
+    info.depth = reach - dist;
+    return info;
+}
+
+collision_info_t find_circle_capsule_collision(vector_t center, double radius, vector_t start, vector_t end, double capsule_radius){
+    return find_circle_collision(center, radius, closest_on_segment(center, start, end), capsule_radius);
+}
+
+collision_info_t find_circle_polygon_collision(vector_t center, double radius, const vector_t *shape, size_t n){
+    collision_info_t info = {.collided = false};
+    vector_t closest = shape[0];
+    double closest_dist_squared = INFINITY;
+    // the center is inside when a ray from it crosses the outline an odd number of times,
+    // which also works for concave polygons like golf courses
+    bool inside = false;
+    for(size_t i = 0; i < n; i++){
+        vector_t start = shape[i];
+        vector_t end = shape[i + 1 < n ? i + 1 : 0];
+        if((start.y > center.y) != (end.y > center.y)){
+            double crossing_x = start.x + (center.y - start.y) * (end.x - start.x) / (end.y - start.y);
+            if(center.x < crossing_x) inside = !inside;
+        }
+        // closest_on_segment() written out, since courses can have dozens of edges
+        double edge_x = end.x - start.x;
+        double edge_y = end.y - start.y;
+        double length_squared = edge_x * edge_x + edge_y * edge_y;
+        double t = 0;
+        if(length_squared != 0){
+            t = ((center.x - start.x) * edge_x + (center.y - start.y) * edge_y) / length_squared;
+            if(t < 0) t = 0;
+            if(t > 1) t = 1;
+        }
+        vector_t point = {.x = start.x + t * edge_x, .y = start.y + t * edge_y};
+        double diff_x = point.x - center.x;
+        double diff_y = point.y - center.y;
+        double dist_squared = diff_x * diff_x + diff_y * diff_y;
+        if(dist_squared < closest_dist_squared){
+            closest_dist_squared = dist_squared;
+            closest = point;
+        }
+    }
+    if(!inside && closest_dist_squared > radius * radius) return info;
+    info.collided = true;
+    double dist = sqrt(closest_dist_squared);
+    if(dist == 0){
+        // the center is on the boundary, so push it away from the middle of the polygon
+        vector_t middle = VEC_ZERO;
+        for(size_t i = 0; i < n; i++) middle = vec_add(middle, shape[i]);
+        vector_t diff = vec_subtract(vec_multiply(1.0 / n, middle), center);
+        info.axis = unit_or_default(diff, sqrt(vec_dot(diff, diff)));
+        info.depth = radius;
+        return info;
+    }
+    // from outside, the polygon is towards the closest point; from inside, the circle escapes through it
+    vector_t diff = inside ? vec_subtract(center, closest) : vec_subtract(closest, center);
+    info.axis = vec_multiply(1 / dist, diff);
+    info.depth = inside ? radius + dist : radius - dist;
+    return info;
+}
+
+double find_circle_toi(vector_t start, vector_t end, double radius, vector_t center, double other_radius){
+    double reach = radius + other_radius;
+    vector_t motion = vec_subtract(end, start);
+    vector_t offset = vec_subtract(start, center);
+    double c = vec_dot(offset, offset) - reach * reach;
+    if(c <= 0) return 0;
+    double a = vec_dot(motion, motion);
+    double b = 2 * vec_dot(offset, motion);
+    double discriminant = b * b - 4 * a * c;
+    if(a == 0 || discriminant < 0) return INFINITY;
+    double t = (-b - sqrt(discriminant)) / (2 * a);
+    return t >= 0 && t <= 1 ? t : INFINITY;
+}
+
+double find_circle_capsule_toi(vector_t start, vector_t end, double radius, vector_t segment_start, vector_t segment_end, double capsule_radius){
+    double reach = radius + capsule_radius;
+    vector_t closest = closest_on_segment(start, segment_start, segment_end);
+    vector_t gap = vec_subtract(start, closest);
+    if(vec_dot(gap, gap) <= reach * reach) return 0;
+    // the circle first touches one of the rounded ends, or one of the flat sides
+    double toi = fmin(
+        find_circle_toi(start, end, radius, segment_start, capsule_radius),
+        find_circle_toi(start, end, radius, segment_end, capsule_radius)
+    );
+    vector_t edge = vec_subtract(segment_end, segment_start);
+    double length_squared = vec_dot(edge, edge);
+    if(length_squared == 0) return toi;
+    vector_t normal = vec_multiply(1 / sqrt(length_squared), (vector_t){.x = -edge.y, .y = edge.x});
+    vector_t motion = vec_subtract(end, start);
+    double approach = vec_dot(motion, normal);
+    if(approach == 0) return toi;
+    double distance = vec_dot(vec_subtract(start, segment_start), normal);
+    for(int side = -1; side <= 1; side += 2){
+        double t = (side * reach - distance) / approach;
+        if(t < 0 || t > 1 || t >= toi) continue;
+        vector_t point = vec_add(start, vec_multiply(t, motion));
+        double along = vec_dot(vec_subtract(point, segment_start), edge) / length_squared;
+        if(along >= 0 && along <= 1) toi = t;
+    }
+    return toi;
+}
+
+double find_circle_polygon_toi(vector_t start, vector_t end, double radius, const vector_t *shape, size_t n){
+    if(find_circle_polygon_collision(start, radius, shape, n).collided) return 0;
+    // a circle outside the polygon has to touch an edge before it can get in
+    double toi = INFINITY;
+    for(size_t i = 0; i < n; i++){
+        toi = fmin(toi, find_circle_capsule_toi(start, end, radius, shape[i], shape[(i + 1) % n], 0));
+    }
+    return toi;
+}
+
+// the collision between a circle and any body, with the axis pointing towards the body
+static collision_info_t circle_collision(body_t *circle, body_t *other){
+    vector_t center = body_get_centroid(circle);
+    double radius = body_get_radius(circle);
+    switch(body_get_shape_kind(other)){
+        case SHAPE_CIRCLE:
+            return find_circle_collision(center, radius, body_get_centroid(other), body_get_radius(other));
+        case SHAPE_CAPSULE: {
+            vector_t start, end;
+            body_get_segment(other, &start, &end);
+            return find_circle_capsule_collision(center, radius, start, end, body_get_radius(other));
+        }
+        case SHAPE_POLYGON:
+        default: {
+            size_t n;
+            const vector_t *shape = body_shape_view(other, &n);
+            return find_circle_polygon_collision(center, radius, shape, n);
+        }
+    }
+}
+
+collision_info_t find_body_collision(body_t *body1, body_t *body2){
+    if(body_get_shape_kind(body1) == SHAPE_CIRCLE) return circle_collision(body1, body2);
+    if(body_get_shape_kind(body2) == SHAPE_CIRCLE) return flip(circle_collision(body2, body1));
+    size_t n1, n2;
+    const vector_t *intervals1, *intervals2;
+    const vector_t *shape1 = body_shape_view(body1, &n1);
+    const vector_t *shape2 = body_shape_view(body2, &n2);
+    const vector_t *normals1 = body_axes_view(body1, &intervals1);
+    const vector_t *normals2 = body_axes_view(body2, &intervals2);
+    collision_info_t info = find_collision_axes(shape1, n1, normals1, intervals1, shape2, n2, normals2, intervals2);
+    // an edge normal can face either way, so turn the axis towards body2
+    vector_t between = vec_subtract(body_get_centroid(body2), body_get_centroid(body1));
+    if(info.collided && vec_dot(info.axis, between) < 0) info.axis = vec_negate(info.axis);
+    return info;
+}
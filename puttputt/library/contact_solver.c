@@ -0,0 +1,386 @@
+#include <stdlib.h>
+#include <assert.h>
+#include <math.h>
+#include "contact_solver.h"
+#include "collision.h"
+#include "pair_map.h"
+#include "pool.h"
+#include "typed_vec.h"
+#include "snapshot.h"
+
+const size_t CONTACT_INITIAL_SIZE = 16;
+// the number of pairs to allocate at a time
+const size_t CONTACT_POOL_CHUNK = 64;
+// the number of passes over the touching pairs each tick
+const int CONTACT_ITERATIONS = 8;
+// the default overlap left alone, so resting bodies keep touching instead of separating every tick
+const double CONTACT_DEFAULT_SLOP = 0.5;
+// the fraction of the remaining overlap removed each tick
+const double CONTACT_CORRECTION = 0.4;
+// by default every approach bounces with the pair's elasticity; scenes with gravity can raise this
+// above the speed a few ticks of gravity add, so stacked bodies do not keep hopping
+const double CONTACT_DEFAULT_BOUNCE_SPEED = 0;
+// the number of pairs each narrowphase job tests
+const size_t CONTACT_TEST_GRAIN = 64;
+
+typedef struct contact_pair{
+    body_t *body1;
+    body_t *body2;
+    double elasticity;
+    contact_manifold_t manifold;
+    // the tick the bodies were last touching on, starting from 1
+    size_t touch_tick;
+    // the tick the pair was last tested on, and what the test found
+    size_t test_tick;
+    collision_info_t info;
+    // the slots, inverse masses and separating speed the pair is being solved with
+    size_t slot1;
+    size_t slot2;
+    double inverse_mass1;
+    double inverse_mass2;
+    double target_speed;
+    // where the pair is in the solver's list of all pairs, and in body1's and body2's lists of pairs
+    size_t index;
+    size_t links[2];
+} contact_pair_t;
+
+DECLARE_VEC(contact_pair_list, contact_pair_t *)
+
+typedef struct contact_solver{
+    pair_map_t *pairs;
+    // the pairs each body is in, keyed by the body and NULL, so removing a body only visits its own pairs
+    pair_map_t *body_pairs;
+    contact_pair_list_t *all;
+    // the pairs marked since the last solve
+    contact_pair_list_t *active;
+    // the marked pairs once each, while solving
+    contact_pair_list_t *tested;
+    // the marked pairs that are touching, while solving
+    contact_pair_list_t *touching;
+    pool_t *pool;
+    size_t tick;
+    double slop;
+    double bounce_speed;
+} contact_solver_t;
+
+contact_solver_t *contact_solver_init(void){
+    contact_solver_t *solver = malloc(sizeof(contact_solver_t));
+    assert(solver);
+    solver->pairs = pair_map_init(CONTACT_INITIAL_SIZE);
+    solver->body_pairs = pair_map_init(CONTACT_INITIAL_SIZE);
+    solver->all = contact_pair_list_init(CONTACT_INITIAL_SIZE);
+    solver->active = contact_pair_list_init(CONTACT_INITIAL_SIZE);
+    solver->tested = contact_pair_list_init(CONTACT_INITIAL_SIZE);
+    solver->touching = contact_pair_list_init(CONTACT_INITIAL_SIZE);
+    solver->pool = pool_init(sizeof(contact_pair_t), CONTACT_POOL_CHUNK);
+    solver->tick = 1;
+    solver->slop = CONTACT_DEFAULT_SLOP;
+    solver->bounce_speed = CONTACT_DEFAULT_BOUNCE_SPEED;
+    return solver;
+}
+
+// forgets the list of a body's pairs
+static void free_body_pairs(contact_solver_t *solver, body_t *body){
+    contact_pair_list_t *pairs = pair_map_remove(solver->body_pairs, body, NULL);
+    if(pairs != NULL) contact_pair_list_free(pairs);
+}
+
+void contact_solver_free(contact_solver_t *solver){
+    VEC_FOR_EACH(contact_pair_t *, pair, solver->all){
+        free_body_pairs(solver, (*pair)->body1);
+        free_body_pairs(solver, (*pair)->body2);
+    }
+    pair_map_free(solver->pairs);
+    pair_map_free(solver->body_pairs);
+    contact_pair_list_free(solver->all);
+    contact_pair_list_free(solver->active);
+    contact_pair_list_free(solver->tested);
+    contact_pair_list_free(solver->touching);
+    pool_free(solver->pool);
+    free(solver);
+}
+
+// which of a pair's bodies a body is
+static size_t pair_end(contact_pair_t *pair, body_t *body){
+    return pair->body1 == body ? 0 : 1;
+}
+
+static void link_pair(contact_solver_t *solver, body_t *body, contact_pair_t *pair){
+    contact_pair_list_t *pairs = pair_map_get(solver->body_pairs, body, NULL);
+    if(pairs == NULL){
+        pairs = contact_pair_list_init(1);
+        pair_map_set(solver->body_pairs, body, NULL, pairs);
+    }
+    pair->links[pair_end(pair, body)] = contact_pair_list_size(pairs);
+    contact_pair_list_add(pairs, pair);
+}
+
+// removes a pair from a body's list; the body's last pair takes its place
+static void unlink_pair(contact_solver_t *solver, body_t *body, contact_pair_t *pair){
+    contact_pair_list_t *pairs = pair_map_get(solver->body_pairs, body, NULL);
+    size_t position = pair->links[pair_end(pair, body)];
+    contact_pair_t *last = contact_pair_list_get(pairs, contact_pair_list_size(pairs) - 1);
+    last->links[pair_end(last, body)] = position;
+    contact_pair_list_swap_remove(pairs, position);
+    if(contact_pair_list_size(pairs) == 0) free_body_pairs(solver, body);
+}
+
+// adds a new pair to the list of all pairs and to each of its bodies' lists
+static void insert_pair(contact_solver_t *solver, contact_pair_t *pair){
+    pair->index = contact_pair_list_size(solver->all);
+    pair_map_set(solver->pairs, pair->body1, pair->body2, pair);
+    contact_pair_list_add(solver->all, pair);
+    link_pair(solver, pair->body1, pair);
+    if(pair->body2 != pair->body1) link_pair(solver, pair->body2, pair);
+}
+
+contact_solver_t *contact_solver_clone(contact_solver_t *solver, body_store_t *store){
+    assert(contact_pair_list_size(solver->active) == 0);
+    contact_solver_t *clone = contact_solver_init();
+    clone->tick = solver->tick;
+    clone->slop = solver->slop;
+    clone->bounce_speed = solver->bounce_speed;
+    VEC_FOR_EACH(contact_pair_t *, pair, solver->all){
+        contact_pair_t *copy = pool_alloc(clone->pool);
+        *copy = **pair;
+        copy->body1 = body_store_get_owner(store, body_get_slot((*pair)->body1));
+        copy->body2 = body_store_get_owner(store, body_get_slot((*pair)->body2));
+        insert_pair(clone, copy);
+    }
+    return clone;
+}
+
+size_t contact_solver_size(contact_solver_t *solver){
+    return contact_pair_list_size(solver->all);
+}
+
+void contact_solver_set_tolerances(contact_solver_t *solver, double slop, double bounce_speed){
+    assert(slop >= 0);
+    assert(bounce_speed >= 0);
+    solver->slop = slop;
+    solver->bounce_speed = bounce_speed;
+}
+
+double contact_solver_get_slop(contact_solver_t *solver){
+    return solver->slop;
+}
+
+bool contact_solver_has_pair(contact_solver_t *solver, body_t *body1, body_t *body2){
+    return pair_map_get(solver->pairs, body1, body2) != NULL;
+}
+
+void contact_solver_add_pair(contact_solver_t *solver, body_t *body1, body_t *body2, double elasticity){
+    contact_pair_t *pair = pair_map_get(solver->pairs, body1, body2);
+    if(pair != NULL){
+        pair->elasticity = elasticity;
+        return;
+    }
+    pair = pool_alloc(solver->pool);
+    pair->body1 = body1;
+    pair->body2 = body2;
+    pair->elasticity = elasticity;
+    pair->manifold.normal_impulse = 0;
+    pair->touch_tick = 0;
+    pair->test_tick = 0;
+    insert_pair(solver, pair);
+}
+
+bool contact_solver_activate(contact_solver_t *solver, body_t *body1, body_t *body2){
+    contact_pair_t *pair = pair_map_get(solver->pairs, body1, body2);
+    if(pair == NULL) return false;
+    contact_pair_list_add(solver->active, pair);
+    return true;
+}
+
+// the point of a body furthest along a direction
+static vector_t support_point(body_t *body, vector_t direction){
+    vector_t start, end;
+    switch(body_get_shape_kind(body)){
+        case SHAPE_CIRCLE:
+        case SHAPE_CAPSULE:
+            body_get_segment(body, &start, &end);
+            if(vec_dot(end, direction) > vec_dot(start, direction)) start = end;
+            return vec_add(start, vec_multiply(body_get_radius(body), direction));
+        case SHAPE_POLYGON:
+        default: {
+            size_t n;
+            const vector_t *points = body_shape_view(body, &n);
+            vector_t best = points[0];
+            for(size_t i = 1; i < n; i++){
+                if(vec_dot(points[i], direction) > vec_dot(best, direction)) best = points[i];
+            }
+            return best;
+        }
+    }
+}
+
+// the velocity a body will have after this tick's forces and impulses so far
+static vector_t predicted_velocity(body_store_t *store, size_t slot, double inverse_mass, double dt){
+    vector_t velocity = body_store_velocities(store)[slot];
+    vector_t force = body_store_forces(store)[slot];
+    vector_t impulse = body_store_impulses(store)[slot];
+    velocity.x += inverse_mass * (dt * force.x + impulse.x);
+    velocity.y += inverse_mass * (dt * force.y + impulse.y);
+    return velocity;
+}
+
+static double normal_speed(contact_pair_t *pair, body_store_t *store, double dt){
+    vector_t velocity1 = predicted_velocity(store, pair->slot1, pair->inverse_mass1, dt);
+    vector_t velocity2 = predicted_velocity(store, pair->slot2, pair->inverse_mass2, dt);
+    return vec_dot(vec_subtract(velocity2, velocity1), pair->manifold.normal);
+}
+
+static void apply_impulse(contact_pair_t *pair, body_store_t *store, double impulse){
+    vector_t *impulses = body_store_impulses(store);
+    vector_t normal = pair->manifold.normal;
+    impulses[pair->slot1].x -= impulse * normal.x;
+    impulses[pair->slot1].y -= impulse * normal.y;
+    impulses[pair->slot2].x += impulse * normal.x;
+    impulses[pair->slot2].y += impulse * normal.y;
+}
+
+// runs the narrowphase test of one pair; the bodies' shapes must already be up to date
+static void test_pair(contact_pair_list_t *tested, size_t index){
+    contact_pair_t *pair = contact_pair_list_get(tested, index);
+    pair->info = find_body_collision(pair->body1, pair->body2);
+}
+
+// lists each marked pair once, updating the cached shapes its test reads,
+// so the tests themselves only read the bodies and can run at the same time
+static void find_tested(contact_solver_t *solver){
+    contact_pair_list_clear(solver->tested);
+    VEC_FOR_EACH(contact_pair_t *, active, solver->active){
+        contact_pair_t *pair = *active;
+        // a pair is marked twice if it was activated twice
+        if(pair->test_tick == solver->tick) continue;
+        pair->test_tick = solver->tick;
+        size_t n;
+        body_shape_view(pair->body1, &n);
+        body_shape_view(pair->body2, &n);
+        contact_pair_list_add(solver->tested, pair);
+    }
+    contact_pair_list_clear(solver->active);
+}
+
+// builds the pair's manifold from its test, returning whether it needs solving
+static bool prepare_pair(contact_solver_t *solver, contact_pair_t *pair, body_store_t *store, double dt){
+    collision_info_t info = pair->info;
+    if(!info.collided) return false;
+    contact_manifold_t *manifold = &pair->manifold;
+    // the impulse from last tick is only a good guess if the bodies stayed in contact
+    if(pair->touch_tick != solver->tick - 1) manifold->normal_impulse = 0;
+    pair->touch_tick = solver->tick;
+    manifold->normal = info.axis;
+    manifold->depth = info.depth;
+    manifold->point = support_point(pair->body2, vec_negate(info.axis));
+    double *inverse_masses = body_store_inverse_masses(store);
+    pair->slot1 = body_get_slot(pair->body1);
+    pair->slot2 = body_get_slot(pair->body2);
+    pair->inverse_mass1 = inverse_masses[pair->slot1];
+    pair->inverse_mass2 = inverse_masses[pair->slot2];
+    if(pair->inverse_mass1 + pair->inverse_mass2 == 0) return false;
+    double speed = normal_speed(pair, store, dt);
+    pair->target_speed = speed < -solver->bounce_speed ? -pair->elasticity * speed : 0;
+    apply_impulse(pair, store, manifold->normal_impulse);
+    return true;
+}
+
+// removes part of the overlap by moving the bodies apart in proportion to their inverse masses
+static void correct_position(contact_pair_t *pair, body_store_t *store, double slop){
+    double overlap = pair->manifold.depth - slop;
+    if(overlap <= 0) return;
+    double correction = CONTACT_CORRECTION * overlap / (pair->inverse_mass1 + pair->inverse_mass2);
+    vector_t normal = pair->manifold.normal;
+    vector_t *centroids = body_store_centroids(store);
+    centroids[pair->slot1].x -= pair->inverse_mass1 * correction * normal.x;
+    centroids[pair->slot1].y -= pair->inverse_mass1 * correction * normal.y;
+    centroids[pair->slot2].x += pair->inverse_mass2 * correction * normal.x;
+    centroids[pair->slot2].y += pair->inverse_mass2 * correction * normal.y;
+}
+
+void contact_solver_solve(contact_solver_t *solver, body_store_t *store, double dt, job_system_t *jobs){
+    solver->tick++;
+    find_tested(solver);
+    job_system_parallel_for(
+        jobs,
+        contact_pair_list_size(solver->tested),
+        CONTACT_TEST_GRAIN,
+        (job_func_t) test_pair,
+        solver->tested
+    );
+    contact_pair_list_clear(solver->touching);
+    VEC_FOR_EACH(contact_pair_t *, tested, solver->tested){
+        if(prepare_pair(solver, *tested, store, dt)) contact_pair_list_add(solver->touching, *tested);
+    }
+    for(int iteration = 0; iteration < CONTACT_ITERATIONS; iteration++){
+        VEC_FOR_EACH(contact_pair_t *, touching, solver->touching){
+            contact_pair_t *pair = *touching;
+            double speed = normal_speed(pair, store, dt);
+            double impulse = (pair->target_speed - speed) / (pair->inverse_mass1 + pair->inverse_mass2);
+            // the total impulse can only push the bodies apart
+            double total = fmax(pair->manifold.normal_impulse + impulse, 0);
+            apply_impulse(pair, store, total - pair->manifold.normal_impulse);
+            pair->manifold.normal_impulse = total;
+        }
+    }
+    VEC_FOR_EACH(contact_pair_t *, touching, solver->touching){
+        correct_position(*touching, store, solver->slop);
+    }
+}
+
+bool contact_solver_get_manifold(contact_solver_t *solver, body_t *body1, body_t *body2, contact_manifold_t *manifold){
+    contact_pair_t *pair = pair_map_get(solver->pairs, body1, body2);
+    if(pair == NULL || pair->touch_tick != solver->tick) return false;
+    *manifold = pair->manifold;
+    if(pair->body1 != body1){
+        manifold->normal = vec_negate(manifold->normal);
+        manifold->point = support_point(body2, vec_negate(manifold->normal));
+    }
+    return true;
+}
+
+void contact_solver_remove_body(contact_solver_t *solver, body_t *body){
+    contact_pair_list_t *pairs = pair_map_remove(solver->body_pairs, body, NULL);
+    if(pairs == NULL) return;
+    VEC_FOR_EACH(contact_pair_t *, entry, pairs){
+        contact_pair_t *pair = *entry;
+        body_t *other = pair->body1 == body ? pair->body2 : pair->body1;
+        if(other != body) unlink_pair(solver, other, pair);
+        pair_map_remove(solver->pairs, pair->body1, pair->body2);
+        // the last pair takes the removed pair's place
+        contact_pair_t *last = contact_pair_list_get(solver->all, contact_pair_list_size(solver->all) - 1);
+        last->index = pair->index;
+        contact_pair_list_swap_remove(solver->all, pair->index);
+        pool_release(solver->pool, pair);
+    }
+    contact_pair_list_free(pairs);
+}
+
+size_t contact_solver_snapshot(contact_solver_t *solver, void *buffer){
+    size_t count = contact_pair_list_size(solver->all);
+    size_t offset = 0;
+    snapshot_write(buffer, &offset, &count, sizeof(size_t));
+    snapshot_write(buffer, &offset, &solver->tick, sizeof(size_t));
+    VEC_FOR_EACH(contact_pair_t *, pair, solver->all){
+        snapshot_write(buffer, &offset, &(*pair)->manifold, sizeof(contact_manifold_t));
+        snapshot_write(buffer, &offset, &(*pair)->touch_tick, sizeof(size_t));
+        snapshot_write(buffer, &offset, &(*pair)->test_tick, sizeof(size_t));
+    }
+    return offset;
+}
+
+size_t contact_solver_restore(contact_solver_t *solver, const void *buffer){
+    assert(contact_pair_list_size(solver->active) == 0);
+    size_t count;
+    size_t offset = 0;
+    snapshot_read(buffer, &offset, &count, sizeof(size_t));
+    assert(count == contact_pair_list_size(solver->all));
+    snapshot_read(buffer, &offset, &solver->tick, sizeof(size_t));
+    // the ticks are restored with the pairs, so pairs touching after the snapshot do not look recent
+    VEC_FOR_EACH(contact_pair_t *, pair, solver->all){
+        snapshot_read(buffer, &offset, &(*pair)->manifold, sizeof(contact_manifold_t));
+        snapshot_read(buffer, &offset, &(*pair)->touch_tick, sizeof(size_t));
+        snapshot_read(buffer, &offset, &(*pair)->test_tick, sizeof(size_t));
+    }
+    return offset;
+}
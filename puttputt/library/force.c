@@ -2,6 +2,7 @@
 #include <stdio.h>
 #include <assert.h>
 #include "force.h"
+#include "pool.h"
 
 typedef struct force{
     force_creator_t force_creator;
@@ -9,6 +10,17 @@ typedef struct force{
     free_func_t freer;
     bool removed;
     list_t *bodies;
+    bool contact;
+    bool active;
+    // the bytes of aux that change as the scene runs
+    void *state;
+    size_t state_size;
+    // copies the force into a clone of its scene, or NULL if it cannot be copied
+    force_cloner_t cloner;
+    // the index of the force's handle in its scene
+    size_t handle;
+    // the pool the force was allocated from, or NULL if it was malloc()ed
+    pool_t *pool;
 }force_t;
 
 force_t *force_init(force_creator_t fc, void *aux, free_func_t freer){
@@ -19,24 +31,60 @@ force_t *force_init(force_creator_t fc, void *aux, free_func_t freer){
     force->freer = freer;
     force->removed = false;
     force->bodies = list_init(0, free);
+    force->contact = false;
+    force->active = false;
+    force->state = NULL;
+    force->state_size = 0;
+    force->cloner = NULL;
+    force->handle = 0;
+    force->pool = NULL;
     return force;
 }
 
 force_t *force_init_with_bodies(force_creator_t fc, void *aux, free_func_t freer, list_t *bodies){
     force_t* force = malloc(sizeof(force_t));
     assert(force);
+    force->pool = NULL;
     force->force_creator = fc;
     force->aux = aux;
     force->freer = freer;
     force->removed = false;
     force->bodies = bodies;
+    force->contact = false;
+    force->active = false;
+    force->state = NULL;
+    force->state_size = 0;
+    force->cloner = NULL;
+    force->handle = 0;
+    return force;
+}
+
+pool_t *force_pool_init(size_t chunk_size){
+    return pool_init(sizeof(force_t), chunk_size);
+}
+
+force_t *force_init_from_pool(pool_t *pool, force_creator_t fc, void *aux, free_func_t freer, list_t *bodies){
+    force_t *force = pool_alloc(pool);
+    force->pool = pool;
+    force->force_creator = fc;
+    force->aux = aux;
+    force->freer = freer;
+    force->removed = false;
+    force->bodies = bodies;
+    force->contact = false;
+    force->active = false;
+    force->state = NULL;
+    force->state_size = 0;
+    force->cloner = NULL;
+    force->handle = 0;
     return force;
 }
 
 void force_free(force_t *force){
     if(force->freer != NULL) force->freer(force->aux);
     free(force->bodies);
-    free(force);
+    if(force->pool != NULL) pool_release(force->pool, force);
+    else free(force);
 }
 
 void force_create(force_t *force){
@@ -53,4 +101,52 @@ bool force_is_removed(force_t *force){
 
 list_t *force_get_bodies(force_t *force){
     return force->bodies;
-}
\ No newline at end of file
+}
+
+void force_set_contact(force_t *force){
+    assert(list_size(force->bodies) >= 2);
+    force->contact = true;
+}
+
+bool force_is_contact(force_t *force){
+    return force->contact;
+}
+
+void force_set_active(force_t *force, bool active){
+    force->active = active;
+}
+
+bool force_is_active(force_t *force){
+    return force->active;
+}
+
+void force_set_state(force_t *force, void *state, size_t size){
+    force->state = state;
+    force->state_size = size;
+}
+
+void *force_get_state(force_t *force, size_t *size){
+    *size = force->state_size;
+    return force->state;
+}
+
+void force_set_cloner(force_t *force, force_cloner_t cloner){
+    force->cloner = cloner;
+}
+
+bool force_is_cloneable(force_t *force){
+    return force->cloner != NULL;
+}
+
+void force_set_handle(force_t *force, size_t handle){
+    force->handle = handle;
+}
+
+size_t force_get_handle(force_t *force){
+    return force->handle;
+}
+
+void force_clone(force_t *force, scene_t *clone){
+    assert(force->cloner != NULL);
+    force->cloner(force->aux, clone);
+}
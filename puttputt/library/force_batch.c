@@ -0,0 +1,563 @@
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <math.h>
+#include "force_batch.h"
+#include "collision.h"
+#include "typed_vec.h"
+
+const size_t FORCE_BATCH_INITIAL_SIZE = 16;
+// friction only acts on bodies moving faster than this, squared
+const double FORCE_BATCH_MIN_FRICTION_SPEED = 0.001;
+// the fewest drags, springs and gravities worth splitting off into another lane
+const size_t FORCE_BATCH_LANE_SIZE = 1024;
+const size_t FORCE_BATCH_MAX_LANES = 16;
+// the number of slots each job adds the lanes' forces up for
+const size_t FORCE_BATCH_REDUCE_CHUNK = 4096;
+
+typedef enum {
+    DRAG_FORCE,
+    SPRING_FORCE,
+    GRAVITY_FORCE,
+    FRICTION_FORCE,
+    NUM_FORCE_KINDS
+} force_kind_t;
+
+typedef struct{
+    size_t body;
+    double gamma;
+} drag_force_t;
+
+typedef struct{
+    size_t body1;
+    size_t body2;
+    double k;
+} spring_force_t;
+
+typedef struct{
+    size_t body1;
+    size_t body2;
+    double G;
+    double min_dist;
+} gravity_force_t;
+
+typedef struct{
+    size_t body1;
+    size_t body2;
+    double friction;
+} friction_force_t;
+
+// a force whose bodies were not in the store yet when it was added
+typedef struct{
+    force_kind_t kind;
+    body_t *body1;
+    body_t *body2;
+    double param1;
+    double param2;
+} pending_force_t;
+
+// the slots of a bound force's bodies, and where the force is in each slot's list of links;
+// a drag only uses the first of each
+typedef struct{
+    size_t slots[2];
+    size_t links[2];
+} force_ends_t;
+
+// a bound force on a slot: its kind, its index in that kind's array, and which of its bodies the slot is
+typedef struct{
+    force_kind_t kind;
+    size_t index;
+    size_t end;
+} slot_link_t;
+
+DECLARE_VEC(drag_list, drag_force_t)
+DECLARE_VEC(spring_list, spring_force_t)
+DECLARE_VEC(gravity_list, gravity_force_t)
+DECLARE_VEC(friction_list, friction_force_t)
+DECLARE_VEC(pending_list, pending_force_t)
+DECLARE_VEC(ends_list, force_ends_t)
+DECLARE_VEC(link_list, slot_link_t)
+DECLARE_VEC(slot_links_list, link_list_t *)
+
+typedef struct force_batch{
+    drag_list_t *drags;
+    spring_list_t *springs;
+    gravity_list_t *gravities;
+    friction_list_t *frictions;
+    // the ends of each kind's forces, in the same order as their arrays
+    ends_list_t *ends[NUM_FORCE_KINDS];
+    // the forces on each slot, so removing a body only visits its own forces; NULL for slots with none yet
+    slot_links_list_t *links;
+    // how many batches share the lists above with this one, clones included,
+    // or NULL if it is their only owner; shared lists are copied before they change
+    atomic_size_t *shared;
+    pending_list_t *pending;
+    // the forces summed by every lane but the first, one store-sized array after another
+    vector_t *lane_forces;
+    size_t lane_capacity;
+} force_batch_t;
+
+// one tick's split of the forces into lanes
+typedef struct{
+    force_batch_t *batch;
+    body_store_t *store;
+    size_t lanes;
+} lane_split_t;
+
+force_batch_t *force_batch_init(void){
+    force_batch_t *batch = malloc(sizeof(force_batch_t));
+    assert(batch);
+    batch->drags = drag_list_init(FORCE_BATCH_INITIAL_SIZE);
+    batch->springs = spring_list_init(FORCE_BATCH_INITIAL_SIZE);
+    batch->gravities = gravity_list_init(FORCE_BATCH_INITIAL_SIZE);
+    batch->frictions = friction_list_init(FORCE_BATCH_INITIAL_SIZE);
+    for(force_kind_t kind = 0; kind < NUM_FORCE_KINDS; kind++){
+        batch->ends[kind] = ends_list_init(FORCE_BATCH_INITIAL_SIZE);
+    }
+    batch->links = slot_links_list_init(FORCE_BATCH_INITIAL_SIZE);
+    batch->shared = NULL;
+    batch->pending = pending_list_init(FORCE_BATCH_INITIAL_SIZE);
+    batch->lane_forces = NULL;
+    batch->lane_capacity = 0;
+    return batch;
+}
+
+// lets go of a batch's bound forces, freeing them if no other batch shares them
+static void release_bound(force_batch_t *batch){
+    if(batch->shared != NULL){
+        if(atomic_fetch_sub(batch->shared, 1) > 1) return;
+        free(batch->shared);
+    }
+    drag_list_free(batch->drags);
+    spring_list_free(batch->springs);
+    gravity_list_free(batch->gravities);
+    friction_list_free(batch->frictions);
+    for(force_kind_t kind = 0; kind < NUM_FORCE_KINDS; kind++){
+        ends_list_free(batch->ends[kind]);
+    }
+    VEC_FOR_EACH(link_list_t *, links, batch->links){
+        if(*links != NULL) link_list_free(*links);
+    }
+    slot_links_list_free(batch->links);
+}
+
+// gives a batch its own copy of the bound forces before it changes them.
+// the copy is made before letting go, since the last other owner may change them as soon as it is alone
+static void unshare_bound(force_batch_t *batch){
+    if(batch->shared == NULL) return;
+    force_batch_t old = *batch;
+    batch->drags = drag_list_init(drag_list_size(old.drags));
+    drag_list_append(batch->drags, drag_list_data(old.drags), drag_list_size(old.drags));
+    batch->springs = spring_list_init(spring_list_size(old.springs));
+    spring_list_append(batch->springs, spring_list_data(old.springs), spring_list_size(old.springs));
+    batch->gravities = gravity_list_init(gravity_list_size(old.gravities));
+    gravity_list_append(batch->gravities, gravity_list_data(old.gravities), gravity_list_size(old.gravities));
+    batch->frictions = friction_list_init(friction_list_size(old.frictions));
+    friction_list_append(batch->frictions, friction_list_data(old.frictions), friction_list_size(old.frictions));
+    for(force_kind_t kind = 0; kind < NUM_FORCE_KINDS; kind++){
+        batch->ends[kind] = ends_list_init(ends_list_size(old.ends[kind]));
+        ends_list_append(batch->ends[kind], ends_list_data(old.ends[kind]), ends_list_size(old.ends[kind]));
+    }
+    batch->links = slot_links_list_init(slot_links_list_size(old.links));
+    VEC_FOR_EACH(link_list_t *, links, old.links){
+        link_list_t *copy = NULL;
+        if(*links != NULL){
+            copy = link_list_init(link_list_size(*links));
+            link_list_append(copy, link_list_data(*links), link_list_size(*links));
+        }
+        slot_links_list_add(batch->links, copy);
+    }
+    batch->shared = NULL;
+    release_bound(&old);
+}
+
+void force_batch_free(force_batch_t *batch){
+    release_bound(batch);
+    pending_list_free(batch->pending);
+    free(batch->lane_forces);
+    free(batch);
+}
+
+size_t force_batch_size(force_batch_t *batch){
+    return drag_list_size(batch->drags)
+        + spring_list_size(batch->springs)
+        + gravity_list_size(batch->gravities)
+        + friction_list_size(batch->frictions)
+        + pending_list_size(batch->pending);
+}
+
+static void add_pending(force_batch_t *batch, force_kind_t kind, body_t *body1, body_t *body2, double param1, double param2){
+    pending_force_t force = {.kind = kind, .body1 = body1, .body2 = body2, .param1 = param1, .param2 = param2};
+    pending_list_add(batch->pending, force);
+}
+
+void force_batch_add_drag(force_batch_t *batch, body_t *body, double gamma){
+    add_pending(batch, DRAG_FORCE, body, body, gamma, 0);
+}
+
+void force_batch_add_spring(force_batch_t *batch, body_t *body1, body_t *body2, double k){
+    add_pending(batch, SPRING_FORCE, body1, body2, k, 0);
+}
+
+void force_batch_add_gravity(force_batch_t *batch, body_t *body1, body_t *body2, double G, double min_dist){
+    add_pending(batch, GRAVITY_FORCE, body1, body2, G, min_dist);
+}
+
+void force_batch_add_friction(force_batch_t *batch, body_t *body1, body_t *body2, double friction){
+    add_pending(batch, FRICTION_FORCE, body1, body2, friction, 0);
+}
+
+// the number of bodies a kind of force acts on
+static size_t kind_ends(force_kind_t kind){
+    return kind == DRAG_FORCE ? 1 : 2;
+}
+
+// adds a link to a force to the list for the slot at one of its ends
+static void link_end(force_batch_t *batch, force_kind_t kind, size_t index, size_t end){
+    force_ends_t *ends = &ends_list_data(batch->ends[kind])[index];
+    size_t slot = ends->slots[end];
+    while(slot_links_list_size(batch->links) <= slot) slot_links_list_add(batch->links, NULL);
+    link_list_t **links = &slot_links_list_data(batch->links)[slot];
+    if(*links == NULL) *links = link_list_init(1);
+    ends->links[end] = link_list_size(*links);
+    link_list_add(*links, (slot_link_t){.kind = kind, .index = index, .end = end});
+}
+
+// removes the link to a force from the list for the slot at one of its ends;
+// the slot's last link takes its place
+static void unlink_end(force_batch_t *batch, force_kind_t kind, size_t index, size_t end){
+    force_ends_t ends = ends_list_get(batch->ends[kind], index);
+    link_list_t *links = slot_links_list_get(batch->links, ends.slots[end]);
+    slot_link_t last = link_list_get(links, link_list_size(links) - 1);
+    ends_list_data(batch->ends[last.kind])[last.index].links[last.end] = ends.links[end];
+    link_list_swap_remove(links, ends.links[end]);
+}
+
+// records a force just added to the end of its kind's array
+static void bind(force_batch_t *batch, force_kind_t kind, size_t slot1, size_t slot2){
+    size_t index = ends_list_size(batch->ends[kind]);
+    ends_list_add(batch->ends[kind], (force_ends_t){.slots = {slot1, slot2}});
+    for(size_t end = 0; end < kind_ends(kind); end++){
+        link_end(batch, kind, index, end);
+    }
+}
+
+// moves the pending forces whose bodies are now in the store into the arrays for their kinds
+static void bind_pending(force_batch_t *batch, body_store_t *store){
+    unshare_bound(batch);
+    pending_force_t *pending = pending_list_data(batch->pending);
+    size_t kept = 0;
+    for(size_t i = 0; i < pending_list_size(batch->pending); i++){
+        pending_force_t force = pending[i];
+        if(body_get_store(force.body1) != store || body_get_store(force.body2) != store){
+            pending[kept++] = force;
+            continue;
+        }
+        size_t slot1 = body_get_slot(force.body1);
+        size_t slot2 = body_get_slot(force.body2);
+        switch(force.kind){
+            case DRAG_FORCE:
+                drag_list_add(batch->drags, (drag_force_t){.body = slot1, .gamma = force.param1});
+                break;
+            case SPRING_FORCE:
+                spring_list_add(batch->springs, (spring_force_t){.body1 = slot1, .body2 = slot2, .k = force.param1});
+                break;
+            case GRAVITY_FORCE:
+                gravity_list_add(batch->gravities, (gravity_force_t){.body1 = slot1, .body2 = slot2, .G = force.param1, .min_dist = force.param2});
+                break;
+            case FRICTION_FORCE:
+                friction_list_add(batch->frictions, (friction_force_t){.body1 = slot1, .body2 = slot2, .friction = force.param1});
+                break;
+            default:
+                break;
+        }
+        bind(batch, force.kind, slot1, slot2);
+    }
+    batch->pending->size = kept;
+}
+
+void force_batch_drop_removed(force_batch_t *batch){
+    pending_force_t *pending = pending_list_data(batch->pending);
+    size_t kept = 0;
+    for(size_t i = 0; i < pending_list_size(batch->pending); i++){
+        if(body_is_removed(pending[i].body1) || body_is_removed(pending[i].body2)) continue;
+        pending[kept++] = pending[i];
+    }
+    batch->pending->size = kept;
+}
+
+force_batch_t *force_batch_clone(force_batch_t *batch, body_store_t *store){
+    if(pending_list_size(batch->pending) > 0) bind_pending(batch, store);
+    assert(pending_list_size(batch->pending) == 0);
+    if(batch->shared == NULL){
+        batch->shared = malloc(sizeof(atomic_size_t));
+        assert(batch->shared);
+        atomic_init(batch->shared, 1);
+    }
+    atomic_fetch_add(batch->shared, 1);
+    force_batch_t *clone = malloc(sizeof(force_batch_t));
+    assert(clone);
+    *clone = *batch;
+    clone->pending = pending_list_init(FORCE_BATCH_INITIAL_SIZE);
+    clone->lane_forces = NULL;
+    clone->lane_capacity = 0;
+    return clone;
+}
+
+// the part of an array of forces that a lane evaluates
+static size_t lane_start(size_t size, size_t lane, size_t lanes){
+    return size * lane / lanes;
+}
+
+static void apply_drags(force_batch_t *batch, body_store_t *store, vector_t *forces, size_t start, size_t end){
+    vector_t *velocities = body_store_velocities(store);
+    bool *asleep = body_store_asleep(store);
+    drag_force_t *drags = drag_list_data(batch->drags);
+    for(size_t i = start; i < end; i++){
+        drag_force_t *drag = &drags[i];
+        if(asleep[drag->body]) continue;
+        double scale = -1 * drag->gamma;
+        forces[drag->body].x += scale * velocities[drag->body].x;
+        forces[drag->body].y += scale * velocities[drag->body].y;
+    }
+}
+
+static void apply_springs(force_batch_t *batch, body_store_t *store, vector_t *forces, size_t start, size_t end){
+    vector_t *centroids = body_store_centroids(store);
+    bool *asleep = body_store_asleep(store);
+    spring_force_t *springs = spring_list_data(batch->springs);
+    for(size_t i = start; i < end; i++){
+        spring_force_t *spring = &springs[i];
+        if(asleep[spring->body1]) continue;
+        forces[spring->body1].x += spring->k * (centroids[spring->body2].x - centroids[spring->body1].x);
+        forces[spring->body1].y += spring->k * (centroids[spring->body2].y - centroids[spring->body1].y);
+    }
+}
+
+static void apply_gravities(force_batch_t *batch, body_store_t *store, vector_t *forces, size_t start, size_t end){
+    vector_t *centroids = body_store_centroids(store);
+    double *masses = body_store_masses(store);
+    bool *asleep = body_store_asleep(store);
+    gravity_force_t *gravities = gravity_list_data(batch->gravities);
+    for(size_t i = start; i < end; i++){
+        gravity_force_t *gravity = &gravities[i];
+        if(asleep[gravity->body1] && asleep[gravity->body2]) continue;
+        double dx = centroids[gravity->body1].x - centroids[gravity->body2].x;
+        double dy = centroids[gravity->body1].y - centroids[gravity->body2].y;
+        double dist_squared = dx * dx + dy * dy;
+        double distance = sqrt(dist_squared);
+        if(distance <= gravity->min_dist) continue;
+        double inverse_distance = 1 / distance;
+        double magnitude = gravity->G * masses[gravity->body1] * masses[gravity->body2] / dist_squared;
+        double fx = magnitude * (inverse_distance * dx);
+        double fy = magnitude * (inverse_distance * dy);
+        forces[gravity->body2].x += fx;
+        forces[gravity->body2].y += fy;
+        forces[gravity->body1].x += -1 * fx;
+        forces[gravity->body1].y += -1 * fy;
+    }
+}
+
+static void apply_frictions(force_batch_t *batch, body_store_t *store, aabb_tree_t *tree){
+    vector_t *velocities = body_store_velocities(store);
+    double *masses = body_store_masses(store);
+    vector_t *forces = body_store_forces(store);
+    bool *asleep = body_store_asleep(store);
+    VEC_FOR_EACH(friction_force_t, friction, batch->frictions){
+        if(asleep[friction->body1]) continue;
+        vector_t velocity = velocities[friction->body1];
+        double speed_squared = velocity.x * velocity.x + velocity.y * velocity.y;
+        if(speed_squared <= FORCE_BATCH_MIN_FRICTION_SPEED) continue;
+        body_t *body1 = body_store_get_owner(store, friction->body1);
+        body_t *body2 = body_store_get_owner(store, friction->body2);
+        aabb_t bounds1 = aabb_tree_get_bounds(tree, body_get_proxy(body1));
+        aabb_t bounds2 = aabb_tree_get_bounds(tree, body_get_proxy(body2));
+        if(!aabb_overlap(bounds1, bounds2)) continue;
+        if(!find_body_collision(body1, body2).collided) continue;
+        double scale = -1 * friction->friction * masses[friction->body1];
+        double inverse_speed = 1 / sqrt(speed_squared);
+        forces[friction->body1].x += scale * (inverse_speed * velocity.x);
+        forces[friction->body1].y += scale * (inverse_speed * velocity.y);
+    }
+}
+
+// evaluates one lane's share of each kind of force;
+// the first lane adds to the store, the others to their own arrays
+static void apply_lane(lane_split_t *split, size_t lane){
+    force_batch_t *batch = split->batch;
+    size_t lanes = split->lanes;
+    vector_t *forces = body_store_forces(split->store);
+    if(lane > 0){
+        size_t n = body_store_size(split->store);
+        forces = &batch->lane_forces[(lane - 1) * n];
+        for(size_t i = 0; i < n; i++){
+            forces[i] = VEC_ZERO;
+        }
+    }
+    size_t size = drag_list_size(batch->drags);
+    apply_drags(batch, split->store, forces, lane_start(size, lane, lanes), lane_start(size, lane + 1, lanes));
+    size = spring_list_size(batch->springs);
+    apply_springs(batch, split->store, forces, lane_start(size, lane, lanes), lane_start(size, lane + 1, lanes));
+    size = gravity_list_size(batch->gravities);
+    apply_gravities(batch, split->store, forces, lane_start(size, lane, lanes), lane_start(size, lane + 1, lanes));
+}
+
+// adds the other lanes' forces to the store in lane order, for one chunk of slots
+static void reduce_lanes(lane_split_t *split, size_t chunk){
+    size_t n = body_store_size(split->store);
+    vector_t *forces = body_store_forces(split->store);
+    size_t end = (chunk + 1) * FORCE_BATCH_REDUCE_CHUNK < n ? (chunk + 1) * FORCE_BATCH_REDUCE_CHUNK : n;
+    for(size_t slot = chunk * FORCE_BATCH_REDUCE_CHUNK; slot < end; slot++){
+        for(size_t lane = 1; lane < split->lanes; lane++){
+            vector_t force = split->batch->lane_forces[(lane - 1) * n + slot];
+            forces[slot].x += force.x;
+            forces[slot].y += force.y;
+        }
+    }
+}
+
+// the lanes, then the sums, as two stages of jobs; the sums only start once every lane is done
+static void run_lanes(lane_split_t *split, size_t chunks, job_system_t *jobs){
+    job_t *lane_jobs = malloc((split->lanes + chunks) * sizeof(job_t));
+    assert(lane_jobs);
+    for(size_t lane = 0; lane < split->lanes; lane++){
+        lane_jobs[lane] = (job_t){.func = (job_func_t) apply_lane, .aux = split, .index = lane};
+    }
+    job_t *reduce_jobs = &lane_jobs[split->lanes];
+    for(size_t chunk = 0; chunk < chunks; chunk++){
+        reduce_jobs[chunk] = (job_t){.func = (job_func_t) reduce_lanes, .aux = split, .index = chunk};
+    }
+    job_counter_t lanes_done, reduced;
+    job_counter_init(&lanes_done);
+    job_counter_init(&reduced);
+    job_system_submit(jobs, lane_jobs, split->lanes, &lanes_done);
+    job_system_submit_after(jobs, reduce_jobs, chunks, &lanes_done, &reduced);
+    job_system_wait(jobs, &reduced);
+    job_counter_destroy(&lanes_done);
+    job_counter_destroy(&reduced);
+    free(lane_jobs);
+}
+
+void force_batch_apply(force_batch_t *batch, body_store_t *store, aabb_tree_t *tree, job_system_t *jobs){
+    if(pending_list_size(batch->pending) > 0) bind_pending(batch, store);
+    // the number of lanes only depends on the forces, so every job system sums them in the same order
+    size_t total = drag_list_size(batch->drags) + spring_list_size(batch->springs) + gravity_list_size(batch->gravities);
+    lane_split_t split = {.batch = batch, .store = store, .lanes = total / FORCE_BATCH_LANE_SIZE};
+    if(split.lanes > FORCE_BATCH_MAX_LANES) split.lanes = FORCE_BATCH_MAX_LANES;
+    if(split.lanes <= 1){
+        split.lanes = 1;
+        apply_lane(&split, 0);
+    }
+    else{
+        size_t n = body_store_size(store);
+        if((split.lanes - 1) * n > batch->lane_capacity){
+            batch->lane_capacity = (split.lanes - 1) * n;
+            free(batch->lane_forces);
+            batch->lane_forces = malloc(batch->lane_capacity * sizeof(vector_t));
+            assert(batch->lane_forces);
+        }
+        size_t chunks = (n + FORCE_BATCH_REDUCE_CHUNK - 1) / FORCE_BATCH_REDUCE_CHUNK;
+        // with one thread, queueing the lanes as jobs only adds overhead
+        if(job_system_size(jobs) > 1) run_lanes(&split, chunks, jobs);
+        else{
+            for(size_t lane = 0; lane < split.lanes; lane++){
+                apply_lane(&split, lane);
+            }
+            for(size_t chunk = 0; chunk < chunks; chunk++){
+                reduce_lanes(&split, chunk);
+            }
+        }
+    }
+    // friction runs narrowphase tests, which update the bodies' cached shapes, so it stays on one thread
+    apply_frictions(batch, store, tree);
+}
+
+void force_batch_for_each_pair(force_batch_t *batch, slot_pair_handler_t handler, void *aux){
+    VEC_FOR_EACH(spring_force_t, spring, batch->springs){
+        handler(spring->body1, spring->body2, aux);
+    }
+    VEC_FOR_EACH(gravity_force_t, gravity, batch->gravities){
+        handler(gravity->body1, gravity->body2, aux);
+    }
+    VEC_FOR_EACH(friction_force_t, friction, batch->frictions){
+        handler(friction->body1, friction->body2, aux);
+    }
+}
+
+// points a bound force at a new slot for one of its bodies
+static void set_slot(force_batch_t *batch, force_kind_t kind, size_t index, size_t end, size_t slot){
+    ends_list_data(batch->ends[kind])[index].slots[end] = slot;
+    switch(kind){
+        case DRAG_FORCE:
+            drag_list_data(batch->drags)[index].body = slot;
+            break;
+        case SPRING_FORCE:
+            if(end == 0) spring_list_data(batch->springs)[index].body1 = slot;
+            else spring_list_data(batch->springs)[index].body2 = slot;
+            break;
+        case GRAVITY_FORCE:
+            if(end == 0) gravity_list_data(batch->gravities)[index].body1 = slot;
+            else gravity_list_data(batch->gravities)[index].body2 = slot;
+            break;
+        case FRICTION_FORCE:
+            if(end == 0) friction_list_data(batch->frictions)[index].body1 = slot;
+            else friction_list_data(batch->frictions)[index].body2 = slot;
+            break;
+        default:
+            break;
+    }
+}
+
+// removes a bound force from its kind's array and from its slots' lists of links.
+// the kind's last force takes its place, and its links are pointed at its new index
+static void remove_bound(force_batch_t *batch, force_kind_t kind, size_t index){
+    for(size_t end = 0; end < kind_ends(kind); end++){
+        unlink_end(batch, kind, index, end);
+    }
+    size_t last = ends_list_size(batch->ends[kind]) - 1;
+    if(index != last){
+        force_ends_t moved = ends_list_get(batch->ends[kind], last);
+        for(size_t end = 0; end < kind_ends(kind); end++){
+            link_list_data(slot_links_list_get(batch->links, moved.slots[end]))[moved.links[end]].index = index;
+        }
+    }
+    ends_list_swap_remove(batch->ends[kind], index);
+    switch(kind){
+        case DRAG_FORCE:
+            drag_list_swap_remove(batch->drags, index);
+            break;
+        case SPRING_FORCE:
+            spring_list_swap_remove(batch->springs, index);
+            break;
+        case GRAVITY_FORCE:
+            gravity_list_swap_remove(batch->gravities, index);
+            break;
+        case FRICTION_FORCE:
+            friction_list_swap_remove(batch->frictions, index);
+            break;
+        default:
+            break;
+    }
+}
+
+void force_batch_remove_slot(force_batch_t *batch, size_t slot, size_t last){
+    unshare_bound(batch);
+    size_t num_slots = slot_links_list_size(batch->links);
+    link_list_t **links = slot_links_list_data(batch->links);
+    if(slot < num_slots && links[slot] != NULL){
+        while(link_list_size(links[slot]) > 0){
+            slot_link_t link = link_list_get(links[slot], link_list_size(links[slot]) - 1);
+            remove_bound(batch, link.kind, link.index);
+        }
+    }
+    if(last == slot || last >= num_slots) return;
+    // the last slot's forces move over with its body, along with their links
+    if(links[last] != NULL){
+        VEC_FOR_EACH(slot_link_t, link, links[last]){
+            set_slot(batch, link->kind, link->index, link->end, slot);
+        }
+    }
+    link_list_t *removed = links[slot];
+    links[slot] = links[last];
+    links[last] = removed;
+}
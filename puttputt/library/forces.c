@@ -4,103 +4,126 @@
 #include <stdlib.h>
 #include "forces.h"
 #include "scene.h"
+#include "force.h"
 #include "collision.h"
 #include "vector.h"
+#include "quadtree.h"
+#include "pool.h"
+#include "job_system.h"
 
 const double MIN_DIST = 3;
+// the number of bodies whose field each job finds
+const size_t FIELD_GRAIN = 32;
 
 typedef struct aux{
     double G;
-    double k;
-    double gamma;
-    double elasticity;
     body_t *body1;
     body_t *body2;
     vector_t force;
     collision_handler_t handler;
     free_func_t handler_freer;
+    collision_aux_cloner_t aux_cloner;
     void* aux;
     bool recent_col;
     double friction;
     double angle;
     vector_t slope_direction;
     double min_vel_magnitude;
+    double theta;
+    list_t *bodies;
+    quadtree_t *tree;
+    vector_t *positions;
+    double *masses;
+    // the field at each body, found in parallel before being added in order
+    vector_t *pulls;
+    scene_t *scene;
+    // the pool the aux was allocated from
+    pool_t *pool;
 }aux_t;
 
-aux_t *aux_init(){
-    aux_t *aux = malloc(sizeof(aux_t));
+pool_t *aux_pool_init(size_t chunk_size){
+    return pool_init(sizeof(aux_t), chunk_size);
+}
+
+aux_t *aux_init(scene_t *scene){
+    aux_t *aux = pool_alloc(scene_get_aux_pool(scene));
+    aux->pool = scene_get_aux_pool(scene);
+    aux->scene = scene;
     aux->handler_freer = NULL;
     aux->min_vel_magnitude = 0;
-    assert(aux);
+    aux->tree = NULL;
+    aux->positions = NULL;
+    aux->masses = NULL;
+    aux->pulls = NULL;
     return aux;
 }
 
 void aux_free(aux_t *aux) {
     if(aux->handler_freer != NULL) aux->handler_freer(aux->aux);
-    free(aux);
-}
-
-// force on body2 from body 1
-void newtonian_gravity(aux_t *gravity){
-    vector_t displacement = vec_subtract(body_get_centroid(gravity->body1), body_get_centroid(gravity->body2));
-    vector_t unit_disp = vec_multiply(1/sqrt(vec_dot(displacement, displacement)), displacement);
-    double distance = sqrt(vec_dot(displacement, displacement));
-    if(distance > MIN_DIST){
-        vector_t grav_force = vec_multiply(gravity->G * body_get_mass(gravity->body1) * body_get_mass(gravity->body2)/vec_dot(displacement, displacement), unit_disp);
-        body_add_force(gravity->body2, grav_force);
-        body_add_force(gravity->body1, vec_multiply(-1, grav_force));
-    }
+    if(aux->tree != NULL) quadtree_free(aux->tree);
+    free(aux->positions);
+    free(aux->masses);
+    free(aux->pulls);
+    pool_release(aux->pool, aux);
 }
 
 void create_newtonian_gravity(scene_t *scene, double G, body_t *body1, body_t *body2) {
-    //add force to bodies
-    aux_t *gravity = aux_init();
-    gravity->body1 = body1;
-    gravity->body2 = body2;
-    gravity->G = G;
-    list_t *bodies = list_init(2, (free_func_t) free);
-    list_add(bodies, body1);
-    list_add(bodies, body2);
-    scene_add_bodies_force_creator(scene, (force_creator_t) newtonian_gravity, gravity, bodies, (free_func_t) aux_free);
+    force_batch_add_gravity(scene_get_force_batch(scene), body1, body2, G, MIN_DIST);
 }
 
-void spring(aux_t *spring){
-    vector_t displacement = vec_subtract(body_get_centroid(spring->body2), body_get_centroid(spring->body1));
-    vector_t spring_force = vec_multiply(spring->k, displacement);
-    body_add_force(spring->body1, spring_force);
+static void find_pull(aux_t *field, size_t index){
+    field->pulls[index] = quadtree_field(field->tree, index, field->theta, MIN_DIST);
 }
 
-void create_spring(scene_t *scene, double k, body_t *body1, body_t *body2) {
-    aux_t *s = aux_init();
-    s->body1 = body1;
-    s->body2 = body2;
-    s->k = k;
-    list_t *bodies = list_init(2, (free_func_t) free);
-    list_add(bodies, body1);
-    list_add(bodies, body2);
-    scene_add_bodies_force_creator(scene, (force_creator_t) spring, s, bodies, (free_func_t) aux_free);
+void gravity_field(aux_t *field){
+    size_t n = list_size(field->bodies);
+    for(size_t i = 0; i < n; i++){
+        body_t *body = list_get(field->bodies, i);
+        field->positions[i] = body_get_centroid(body);
+        field->masses[i] = body_get_mass(body);
+    }
+    quadtree_build(field->tree, field->positions, field->masses, n);
+    job_system_parallel_for(scene_get_job_system(field->scene), n, FIELD_GRAIN, (job_func_t) find_pull, field);
+    for(size_t i = 0; i < n; i++){
+        body_add_force(list_get(field->bodies, i), vec_multiply(field->G * field->masses[i], field->pulls[i]));
+    }
 }
 
-void drag(aux_t *drag){
-    vector_t cons_force = vec_multiply(-1 * drag->gamma, body_get_velocity(drag->body1));
-    body_add_force(drag->body1, cons_force);
+static void clone_gravity_field(aux_t *field, scene_t *clone){
+    list_t *bodies = list_init(list_size(field->bodies), (free_func_t) free);
+    for(size_t i = 0; i < list_size(field->bodies); i++){
+        list_add(bodies, scene_get_clone(clone, list_get(field->bodies, i)));
+    }
+    create_gravity_field(clone, field->G, field->theta, bodies);
+}
+
+void create_gravity_field(scene_t *scene, double G, double theta, list_t *bodies){
+    assert(theta >= 0);
+    aux_t *field = aux_init(scene);
+    field->G = G;
+    field->theta = theta;
+    field->bodies = bodies;
+    field->tree = quadtree_init();
+    field->positions = malloc(list_size(bodies) * sizeof(vector_t));
+    field->masses = malloc(list_size(bodies) * sizeof(double));
+    field->pulls = malloc(list_size(bodies) * sizeof(vector_t));
+    assert(field->positions && field->masses && field->pulls);
+    force_t *force = scene_add_bodies_force_creator(scene, (force_creator_t) gravity_field, field, bodies, (free_func_t) aux_free);
+    force_set_cloner(force, (force_cloner_t) clone_gravity_field);
+}
+
+void create_spring(scene_t *scene, double k, body_t *body1, body_t *body2) {
+    force_batch_add_spring(scene_get_force_batch(scene), body1, body2, k);
 }
 
 void create_drag(scene_t *scene, double gamma, body_t *body) {
-    aux_t *d = aux_init();
-    d->body1 = body;
-    d->gamma = gamma;
-    list_t *bodies = list_init(2, (free_func_t) free);
-    list_add(bodies, body);
-    scene_add_bodies_force_creator(scene, (force_creator_t) drag, d, bodies, (free_func_t) aux_free);
+    force_batch_add_drag(scene_get_force_batch(scene), body, gamma);
 }
 
 void collision(aux_t *aux){
     body_t *body1 = aux->body1;
     body_t *body2 = aux->body2;
-    list_t *l1 = body_get_shape(body1);
-    list_t *l2 = body_get_shape(body2);
-    collision_info_t collision_axis = find_collision(l1, l2);
+    collision_info_t collision_axis = find_body_collision(body1, body2);
     if(collision_axis.collided && !aux->recent_col){
         aux->handler(body1, body2, collision_axis.axis, aux->aux);
         aux->recent_col = true;
@@ -108,25 +131,55 @@ void collision(aux_t *aux){
     else if(!collision_axis.collided){
         aux->recent_col = false;
     }
-    list_free(l1);
-    list_free(l2);
+}
+
+static void clone_collision(aux_t *collide, scene_t *clone){
+    body_t *body1 = scene_get_clone(clone, collide->body1);
+    body_t *body2 = scene_get_clone(clone, collide->body2);
+    if(collide->aux_cloner != NULL){
+        void *aux = collide->aux_cloner(collide->aux, clone);
+        create_cloneable_collision(clone, body1, body2, collide->handler, aux, collide->handler_freer, collide->aux_cloner);
+        return;
+    }
+    // without an aux cloner, only collisions whose aux is NULL or their own scene can be copied
+    void *aux = collide->aux == collide->scene ? clone : NULL;
+    create_collision(clone, body1, body2, collide->handler, aux, NULL);
 }
 
 void create_collision(scene_t *scene, body_t *body1, body_t *body2, collision_handler_t handler, void *aux, free_func_t freer){
-    aux_t *collide = aux_init();
+    create_cloneable_collision(scene, body1, body2, handler, aux, freer, NULL);
+}
+
+void create_cloneable_collision(
+    scene_t *scene,
+    body_t *body1,
+    body_t *body2,
+    collision_handler_t handler,
+    void *aux,
+    free_func_t freer,
+    collision_aux_cloner_t aux_cloner
+){
+    aux_t *collide = aux_init(scene);
     collide->body1 = body1;
     collide->body2 = body2;
     collide->aux = aux;
     collide->handler = handler;
     collide->handler_freer = freer;
+    collide->aux_cloner = aux_cloner;
     collide->recent_col = false;
     list_t *bodies = list_init(2, (free_func_t) free);
     list_add(bodies, body1);
     list_add(bodies, body2);
-    scene_add_bodies_force_creator(scene, (force_creator_t) collision, collide, bodies, (free_func_t) aux_free);
+    force_t *force = scene_add_contact_force_creator(scene, (force_creator_t) collision, collide, bodies, (free_func_t) aux_free);
+    force_set_state(force, &collide->recent_col, sizeof(collide->recent_col));
+    // a copy calling the handler with another scene's aux would change that scene
+    if(aux == NULL || aux == scene || aux_cloner != NULL) force_set_cloner(force, (force_cloner_t) clone_collision);
 }
 
 void destructive_collision(body_t *body1, body_t *body2, vector_t axis, aux_t *collide){
+    (void) body2;
+    (void) axis;
+    (void) collide;
     body_remove(body1);
 }
 
@@ -134,43 +187,12 @@ void create_destructive_collision(scene_t *scene, body_t *body1, body_t *body2){
     create_collision(scene, body1, body2, (collision_handler_t) destructive_collision, NULL, NULL);
 }
 
-void physics_collision(body_t *body1, body_t *body2, vector_t axis, aux_t *collide) {
-    double mass1 = body_get_mass(body1);
-    double mass2 = body_get_mass(body2);
-    
-    vector_t vel1 = body_get_velocity(body1);
-    vector_t vel2 = body_get_velocity(body2);
-
-    double mag = vec_dot(axis, axis);
-    vector_t u_a = vec_multiply(1/mag, vec_multiply(vec_dot(vel1, axis), axis));
-    vector_t u_b = vec_multiply(1/mag, vec_multiply(vec_dot(vel2, axis), axis));
-    double reduced_mass;
-    if (mass1 == INFINITY) {
-        reduced_mass = mass2;
-    }
-    else if (mass2 == INFINITY) {
-        reduced_mass = mass1;
-    }
-    else {
-        reduced_mass = (mass1 * mass2) / (mass1 + mass2);
-    }
-    vector_t J_n = vec_multiply(reduced_mass*(1 + collide->elasticity), vec_subtract(u_b, u_a));
-    body_add_impulse(body1, J_n);
-    body_add_impulse(body2, vec_negate(J_n));
-}
-
 void create_physics_collision(scene_t *scene, double elasticity, body_t *body1, body_t *body2) {
-    aux_t *col = aux_init();
-    col->body1 = body1;
-    col->body2 = body2;
-    col->elasticity = elasticity;
-    create_collision(scene, body1, body2, (collision_handler_t) physics_collision, col, (free_func_t) aux_free);
+    contact_solver_add_pair(scene_get_contact_solver(scene), body1, body2, elasticity);
 }
 
 void friction_and_slope_force(aux_t *fric_slope) {
-    list_t *l1 = body_get_shape(fric_slope->body1);
-    list_t *l2 = body_get_shape(fric_slope->body2);
-    collision_info_t collision_axis = find_collision(l1, l2);
+    collision_info_t collision_axis = find_body_collision(fric_slope->body1, fric_slope->body2);
     if(collision_axis.collided && vec_dot(body_get_velocity(fric_slope->body1), body_get_velocity(fric_slope->body1)) > 0.001){
         vector_t g_force = vec_multiply(fric_slope->G * sin(fric_slope->angle), fric_slope->slope_direction);
         vector_t unit_velocity_direc = vec_multiply(1/vec_dot(body_get_velocity(fric_slope->body1), body_get_velocity(fric_slope->body1)), body_get_velocity(fric_slope->body1));
@@ -178,12 +200,16 @@ void friction_and_slope_force(aux_t *fric_slope) {
         vector_t cons_force = vec_multiply(body_get_mass(fric_slope->body1), vec_add(g_force, fric_force));
         body_add_force(fric_slope->body1, cons_force);
     }
-    list_free(l1);
-    list_free(l2);
+}
+
+static void clone_frictional_and_slope_force(aux_t *d, scene_t *clone){
+    body_t *body1 = scene_get_clone(clone, d->body1);
+    body_t *body2 = scene_get_clone(clone, d->body2);
+    create_frictional_and_slope_force(clone, d->friction, d->angle, d->slope_direction, d->G, body1, body2);
 }
 
 void create_frictional_and_slope_force(scene_t *scene, double u_k, double theta, vector_t slope_direc, double g, body_t *body1, body_t *body2) {
-    aux_t *d = aux_init();
+    aux_t *d = aux_init(scene);
     d->body1 = body1;
     d->body2 = body2;
     d->friction = u_k;
@@ -192,54 +218,36 @@ void create_frictional_and_slope_force(scene_t *scene, double u_k, double theta,
     d->slope_direction = slope_direc;
     list_t *bodies = list_init(2, (free_func_t) free);
     list_add(bodies, body1);
-    scene_add_bodies_force_creator(scene, (force_creator_t) friction_and_slope_force, d, bodies, (free_func_t) aux_free);
+    list_add(bodies, body2);
+    force_t *force = scene_add_contact_force_creator(scene, (force_creator_t) friction_and_slope_force, d, bodies, (free_func_t) aux_free);
+    force_set_cloner(force, (force_cloner_t) clone_frictional_and_slope_force);
 }
 
 void force_collision(aux_t *aux){
     body_t *body1 = aux->body1;
     body_t *body2 = aux->body2;
-    list_t *l1 = body_get_shape(body1);
-    list_t *l2 = body_get_shape(body2);
-    collision_info_t collision_axis = find_collision(l1, l2);
+    collision_info_t collision_axis = find_body_collision(body1, body2);
     if(collision_axis.collided){
         body_add_force(body1, aux->force);
     }
-    list_free(l1);
-    list_free(l2);
+}
+
+static void clone_force_collision(aux_t *col, scene_t *clone){
+    create_force_collision(clone, col->force, scene_get_clone(clone, col->body1), scene_get_clone(clone, col->body2));
 }
 
 void create_force_collision(scene_t *scene, vector_t force, body_t *body1, body_t *body2) {
-    aux_t *col = aux_init();
+    aux_t *col = aux_init(scene);
     col->body1 = body1;
     col->body2 = body2;
     col->force = force;
     list_t *bodies = list_init(2, (free_func_t) free);
     list_add(bodies, body1);
     list_add(bodies, body2);
-    scene_add_bodies_force_creator(scene, (force_creator_t) force_collision, col, bodies, (free_func_t) aux_free);
-}
-
-void friction(aux_t *aux){
-    body_t *body1 = aux->body1;
-    body_t *body2 = aux->body2;
-    list_t *l1 = body_get_shape(body1);
-    list_t *l2 = body_get_shape(body2);
-    collision_info_t collision_axis = find_collision(l1, l2);
-    if(collision_axis.collided && vec_dot(body_get_velocity(body1), body_get_velocity(body1)) > 0.001){
-        vector_t direction = vec_multiply(1/sqrt(vec_dot(body_get_velocity(body1), body_get_velocity(body1))), body_get_velocity(body1));
-        body_add_force(body1, vec_multiply(-1 * aux->friction * body_get_mass(body1), direction));
-    }
-    list_free(l1);
-    list_free(l2);
+    force_t *creator = scene_add_contact_force_creator(scene, (force_creator_t) force_collision, col, bodies, (free_func_t) aux_free);
+    force_set_cloner(creator, (force_cloner_t) clone_force_collision);
 }
 
 void create_friction(scene_t *scene, double frict, body_t *body1, body_t *body2) {
-    aux_t *col = aux_init();
-    col->body1 = body1;
-    col->body2 = body2;
-    col->friction = frict;
-    list_t *bodies = list_init(2, (free_func_t) free);
-    list_add(bodies, body1);
-    list_add(bodies, body2);
-    scene_add_bodies_force_creator(scene, (force_creator_t) friction, col, bodies, (free_func_t) aux_free);
+    force_batch_add_friction(scene_get_force_batch(scene), body1, body2, frict);
 }
@@ -0,0 +1,320 @@
+#include <math.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "golf_hole.h"
+#include "golf_course.h"
+#include "forces.h"
+#include "polygon.h"
+#include "star.h"
+#include "typed_vec.h"
+
+DECLARE_VEC(body_list, body_t *)
+
+const size_t GOLF_HOLE_COUNT = 3;
+const size_t GOLF_HOLE_PLAYERS = 2;
+const size_t GOLF_HOLE_INITIAL_OBSTACLES = 64;
+
+// the holes are laid out on a 1000 by 500 canvas and then scaled up
+const vector_t GOLF_CANVAS_SIZE = {.x=1000, .y=500};
+const double GOLF_SCALE = 1.2;
+const double GOLF_BALL_RADIUS = 10;
+const double GOLF_BALL_MASS = 0.001;
+const size_t GOLF_CIRCLE_POINTS = 20;
+const double GOLF_COURSE_FRICTION = 100;
+const double GOLF_WALL_ELASTICITY = 0.3;
+const double GOLF_BUMPER_ELASTICITY = 1.5;
+const size_t GOLF_STAR_POINTS = 5;
+const double GOLF_LAUNCH_FACTOR = 5;
+// drags longer than the square root of this are weakened
+const double GOLF_MAX_DRAG_SQUARED = 2000000000;
+// balls faster than the square root of this roll over the cup
+const double GOLF_MAX_SINK_SPEED_SQUARED = 1000000;
+
+const rgb_color_t GOLF_COURSE_COLOR = {.r=0.2, .g=0.7, .b=0.2};
+const rgb_color_t GOLF_WALL_COLOR = {.r=0.2, .g=0.5, .b=0.2};
+const rgb_color_t GOLF_BALL1_COLOR = {.r=1, .g=1, .b=0.5};
+const rgb_color_t GOLF_BALL2_COLOR = {.r=0.5, .g=1, .b=1};
+const rgb_color_t GOLF_CUP_COLOR = {.r=0, .g=0, .b=0};
+const rgb_color_t GOLF_PATCH_COLOR = {.r=((double) 66)/255, .g=((double) 117)/255, .b=((double) 73)/255};
+const rgb_color_t GOLF_SLOPE_COLOR = {.r=((double) 30)/255, .g=((double) 117)/255, .b=((double) 73)/255};
+const rgb_color_t GOLF_BUMPER_COLOR = {.r=((double) 30)/255, .g=((double) 50)/255, .b=((double) 73)/255};
+const rgb_color_t GOLF_FORCE_COLOR = {.r=0.5, .g=0.8, .b=0.3};
+
+// the colors of the alternate (beach mode) color scheme
+const rgb_color_t GOLF_ALT_COURSE_COLOR = {.r=((double) 20)/255, .g=((double) 66)/255, .b=((double) 140)/255};
+const rgb_color_t GOLF_ALT_WALL_COLOR = {.r=((double) 138)/255, .g=((double) 154)/255, .b=((double) 181)/255};
+const rgb_color_t GOLF_ALT_CUP_COLOR = {.r=1, .g=1, .b=1};
+const rgb_color_t GOLF_ALT_PATCH_COLOR = {.r=((double) 95)/255, .g=((double) 136)/255, .b=((double) 201)/255};
+const rgb_color_t GOLF_ALT_SLOPE_COLOR = {.r=((double) 95)/255, .g=((double) 136)/255, .b=((double) 100)/255};
+const rgb_color_t GOLF_ALT_BUMPER_COLOR = {.r=((double) 40)/255, .g=((double) 136)/255, .b=((double) 150)/255};
+const rgb_color_t GOLF_ALT_FORCE_COLOR = {.r=0.3, .g=0.8, .b=0.5};
+
+// the corners of each hole's shapes, as fractions of the canvas
+const vector_t HOLE1_COURSE[] = {
+    {0, 0}, {0, 1}, {1, 1}, {1, 0}, {4.0/5, 0}, {4.0/5, 3.0/5}, {1.0/5, 3.0/5}, {1.0/5, 0}
+};
+const vector_t HOLE1_PATCH[] = {{3.7/5, 3.5/5}, {3.7/5, 4.2/5}, {4.2/5, 4.2/5}, {4.2/5, 3.5/5}};
+const vector_t HOLE1_SLOPE[] = {{2.0/5, 3.0/5}, {2.0/5, 1}, {3.0/5, 1}, {3.0/5, 3.0/5}};
+const vector_t HOLE1_FORCE_SURFACE[] = {{0.5/5, 3.8/5}, {0.5/5, 9.0/10}, {1.25/5, 8.5/10}, {1.25/5, 3.3/5}};
+const vector_t HOLE2_COURSE[] = {
+    {0, 0}, {0, 2.0/5}, {2.0/7, 2.0/5}, {2.0/7, 1}, {5.0/7, 1}, {5.0/7, 3.0/6}, {6.0/7, 3.0/6}, {6.0/7, 1},
+    {1, 1}, {1, 0}, {4.0/7, 0}, {4.0/7, 2.0/6}, {3.0/7, 2.0/6}, {3.0/7, 1.0/6}, {1.0/7, 1.0/6}, {1.0/7, 0}
+};
+const vector_t HOLE2_SLOPE[] = {{4.0/7, 0}, {1, 0}, {1, 2.0/6}, {4.0/7, 2.0/6}};
+// hole 3 is drawn on a 27 by 13 grid
+const vector_t HOLE3_COURSE[] = {
+    {0, 3}, {3, 3}, {3, 5}, {2, 5}, {2, 8}, {5, 8}, {5, 10}, {7, 10}, {7, 7}, {5, 7},
+    {5, 0}, {16, 0}, {16, 5}, {21, 5}, {21, 7}, {27, 7}, {27, 9}, {25, 9}, {25, 10}, {26, 10},
+    {26, 11}, {25, 11}, {25, 12}, {26, 12}, {26, 13}, {24, 13}, {24, 9}, {22, 9}, {22, 10}, {23, 10},
+    {23, 11}, {22, 11}, {22, 12}, {23, 12}, {23, 13}, {21, 13}, {21, 9}, {18, 9}, {18, 7}, {14, 7},
+    {14, 5}, {7, 5}, {7, 6}, {8, 6}, {8, 11}, {4, 11}, {4, 9}, {1, 9}, {1, 5}, {0, 5}
+};
+const vector_t HOLE3_PATCHES[][4] = {
+    {{6, 1}, {6, 2}, {8, 2}, {8, 1}},
+    {{12, 3}, {12, 4}, {13, 4}, {13, 3}},
+    {{19, 5}, {19, 7}, {21, 7}, {21, 5}}
+};
+const double HOLE3_PATCH_FRICTIONS[] = {300, 250, 180};
+const vector_t HOLE3_GRID = {.x=27, .y=13};
+
+typedef struct golf_hole{
+    body_t *course;
+    body_t *cup;
+    body_list_t *balls;
+    body_list_t *obstacles;
+} golf_hole_t;
+
+// converts a fraction of the canvas into a position on the scaled-up hole
+static vector_t course_point(vector_t fraction){
+    return (vector_t){
+        .x = fraction.x * GOLF_CANVAS_SIZE.x * GOLF_SCALE,
+        .y = fraction.y * GOLF_CANVAS_SIZE.y * GOLF_SCALE
+    };
+}
+
+static vector_t grid_point(vector_t cell, vector_t grid){
+    return course_point((vector_t){cell.x / grid.x, cell.y / grid.y});
+}
+
+static body_t *add_body(scene_t *scene, body_t *body, rgb_color_t color2){
+    body_set_color2(body, color2);
+    scene_add_body(scene, body);
+    return body;
+}
+
+static body_t *add_polygon(
+    scene_t *scene,
+    const vector_t *corners,
+    size_t n,
+    vector_t grid,
+    rgb_color_t color,
+    rgb_color_t color2,
+    char *info
+){
+    polygon_t *shape = polygon_init(n);
+    for(size_t i = 0; i < n; i++){
+        polygon_add(shape, grid_point(corners[i], grid));
+    }
+    return add_body(scene, body_init_polygon(shape, INFINITY, color, info, NULL), color2);
+}
+
+// adds an obstacle the balls bounce off
+static void add_bumper(golf_hole_t *hole, scene_t *scene, body_t *bumper){
+    body_list_add(hole->obstacles, bumper);
+    VEC_FOR_EACH(body_t *, ball, hole->balls){
+        create_physics_collision(scene, GOLF_BUMPER_ELASTICITY, *ball, bumper);
+    }
+}
+
+// adds a patch of rough that slows the balls down more than the rest of the course
+static void add_friction_patch(golf_hole_t *hole, scene_t *scene, body_t *patch, double friction){
+    body_list_add(hole->obstacles, patch);
+    VEC_FOR_EACH(body_t *, ball, hole->balls){
+        create_friction(scene, friction, *ball, patch);
+    }
+}
+
+// adds a patch that rolls the balls downhill
+static void add_slope(golf_hole_t *hole, scene_t *scene, body_t *slope, vector_t direction, double g){
+    body_list_add(hole->obstacles, slope);
+    VEC_FOR_EACH(body_t *, ball, hole->balls){
+        create_frictional_and_slope_force(scene, 0.3, 40, direction, g, *ball, slope);
+    }
+}
+
+// adds a patch that keeps pushing the balls in one direction
+static void add_force_surface(golf_hole_t *hole, scene_t *scene, body_t *surface, vector_t force){
+    body_list_add(hole->obstacles, surface);
+    VEC_FOR_EACH(body_t *, ball, hole->balls){
+        create_force_collision(scene, force, *ball, surface);
+    }
+}
+
+static void add_cup(golf_hole_t *hole, scene_t *scene, vector_t fraction){
+    vector_t center = course_point(fraction);
+    hole->cup = add_body(
+        scene,
+        body_init_circle(center, GOLF_BALL_RADIUS * GOLF_SCALE, GOLF_CIRCLE_POINTS, INFINITY, GOLF_CUP_COLOR, "hole", NULL),
+        GOLF_ALT_CUP_COLOR
+    );
+    body_list_add(hole->obstacles, hole->cup);
+    // the rim is only drawn; a ball has to reach the cup itself to drop in
+    add_body(
+        scene,
+        body_init_circle(center, GOLF_BALL_RADIUS * 2 * GOLF_SCALE, GOLF_CIRCLE_POINTS, INFINITY, GOLF_CUP_COLOR, "hole_real", NULL),
+        GOLF_ALT_CUP_COLOR
+    );
+}
+
+// makes the balls, which are only added to the scene once everything under them has been drawn
+static void init_balls(golf_hole_t *hole, vector_t fraction1, vector_t fraction2){
+    body_t *ball1 = body_init_circle(course_point(fraction1), GOLF_BALL_RADIUS * GOLF_SCALE, GOLF_CIRCLE_POINTS, GOLF_BALL_MASS, GOLF_BALL1_COLOR, "golf_ball1", NULL);
+    body_t *ball2 = body_init_circle(course_point(fraction2), GOLF_BALL_RADIUS * GOLF_SCALE, GOLF_CIRCLE_POINTS, GOLF_BALL_MASS, GOLF_BALL2_COLOR, "golf_ball2", NULL);
+    body_list_add(hole->balls, ball1);
+    body_list_add(hole->balls, ball2);
+    VEC_FOR_EACH(body_t *, ball, hole->balls){
+        body_set_bullet(*ball, true);
+    }
+}
+
+// walls in the course, rolls the balls over it and puts them on the tee
+static void finish_course(golf_hole_t *hole, scene_t *scene){
+    vector_t tee1 = body_get_centroid(body_list_get(hole->balls, 0));
+    vector_t tee2 = body_get_centroid(body_list_get(hole->balls, 1));
+    golf_course_t *golf_course = golf_course_init(hole->course, hole->cup, tee1, tee2, GOLF_WALL_COLOR);
+    golf_course_add_walls(golf_course);
+    list_t *walls = golf_course_get_walls(golf_course);
+    for(size_t i = 0; i < list_size(walls); i++){
+        body_t *wall = list_get(walls, i);
+        add_body(scene, wall, GOLF_ALT_WALL_COLOR);
+        body_list_add(hole->obstacles, wall);
+        VEC_FOR_EACH(body_t *, ball, hole->balls){
+            create_physics_collision(scene, GOLF_WALL_ELASTICITY, *ball, wall);
+        }
+    }
+    golf_course_free(golf_course);
+    VEC_FOR_EACH(body_t *, ball, hole->balls){
+        create_friction(scene, GOLF_COURSE_FRICTION, *ball, hole->course);
+    }
+}
+
+// an open field with a bumper, a hill and a patch that pushes the ball towards the cup
+static void build_hole_1(golf_hole_t *hole, scene_t *scene){
+    vector_t whole = {1, 1};
+    hole->course = add_polygon(scene, HOLE1_COURSE, sizeof(HOLE1_COURSE) / sizeof(vector_t), whole, GOLF_COURSE_COLOR, GOLF_ALT_COURSE_COLOR, "course");
+    body_t *patch = add_polygon(scene, HOLE1_PATCH, 4, whole, GOLF_PATCH_COLOR, GOLF_ALT_PATCH_COLOR, "patch");
+    body_t *slope = add_polygon(scene, HOLE1_SLOPE, 4, whole, GOLF_SLOPE_COLOR, GOLF_ALT_SLOPE_COLOR, "slope");
+    body_t *surface = add_polygon(scene, HOLE1_FORCE_SURFACE, 4, whole, GOLF_FORCE_COLOR, GOLF_ALT_FORCE_COLOR, "force_surface");
+    add_cup(hole, scene, (vector_t){9.0/10, 1.0/10});
+    init_balls(hole, (vector_t){1.0/30, 1.0/20}, (vector_t){2.0/15, 1.0/20});
+    add_slope(hole, scene, slope, (vector_t){-1, 0}, 5000);
+    add_force_surface(hole, scene, surface, (vector_t){1, 0.5});
+    vector_t bumper_center = course_point((vector_t){0.7/7, 3.0/5});
+    add_bumper(hole, scene, add_body(
+        scene,
+        body_init_circle(bumper_center, 50, GOLF_CIRCLE_POINTS, INFINITY, GOLF_BUMPER_COLOR, "bouncy_ball", NULL),
+        GOLF_ALT_BUMPER_COLOR
+    ));
+    finish_course(hole, scene);
+    add_friction_patch(hole, scene, patch, 250);
+}
+
+// a winding course around a star-shaped bumper, finishing up a hill
+static void build_hole_2(golf_hole_t *hole, scene_t *scene){
+    vector_t whole = {1, 1};
+    hole->course = add_polygon(scene, HOLE2_COURSE, sizeof(HOLE2_COURSE) / sizeof(vector_t), whole, GOLF_COURSE_COLOR, GOLF_ALT_COURSE_COLOR, "course");
+    body_t *slope = add_polygon(scene, HOLE2_SLOPE, 4, whole, GOLF_SLOPE_COLOR, GOLF_ALT_SLOPE_COLOR, "slope");
+    add_cup(hole, scene, (vector_t){13.0/14, 11.0/12});
+    init_balls(hole, (vector_t){1.0/30, 1.0/20}, (vector_t){1.0/15, 1.0/20});
+    add_slope(hole, scene, slope, (vector_t){0, 1}, 2000);
+    vector_t star_center = course_point((vector_t){3.5/7, 3.5/5});
+    list_t *star = star_create(GOLF_STAR_POINTS, star_center.x, star_center.y, 100);
+    add_bumper(hole, scene, add_body(
+        scene,
+        body_init_with_info(star, INFINITY, GOLF_BUMPER_COLOR, "bouncy_ball", NULL),
+        GOLF_ALT_BUMPER_COLOR
+    ));
+    finish_course(hole, scene);
+}
+
+// a long maze with patches of rough, ending in a nook behind a row of pillars
+static void build_hole_3(golf_hole_t *hole, scene_t *scene){
+    hole->course = add_polygon(scene, HOLE3_COURSE, sizeof(HOLE3_COURSE) / sizeof(vector_t), HOLE3_GRID, GOLF_COURSE_COLOR, GOLF_ALT_COURSE_COLOR, "course");
+    body_t *patches[sizeof(HOLE3_PATCHES) / sizeof(HOLE3_PATCHES[0])];
+    size_t num_patches = sizeof(patches) / sizeof(patches[0]);
+    for(size_t i = 0; i < num_patches; i++){
+        patches[i] = add_polygon(scene, HOLE3_PATCHES[i], 4, HOLE3_GRID, GOLF_PATCH_COLOR, GOLF_ALT_PATCH_COLOR, "patch");
+    }
+    add_cup(hole, scene, (vector_t){25.5/27, 10.5/13});
+    init_balls(hole, (vector_t){1.0/27, 3.5/13}, (vector_t){2.0/27, 3.5/13});
+    finish_course(hole, scene);
+    for(size_t i = 0; i < num_patches; i++){
+        add_friction_patch(hole, scene, patches[i], HOLE3_PATCH_FRICTIONS[i]);
+    }
+}
+
+golf_hole_t *golf_hole_init(scene_t *scene, size_t number){
+    assert(number >= 1 && number <= GOLF_HOLE_COUNT);
+    golf_hole_t *hole = malloc(sizeof(golf_hole_t));
+    assert(hole);
+    hole->balls = body_list_init(GOLF_HOLE_PLAYERS);
+    hole->obstacles = body_list_init(GOLF_HOLE_INITIAL_OBSTACLES);
+    switch(number){
+        case 1:
+            build_hole_1(hole, scene);
+            break;
+        case 2:
+            build_hole_2(hole, scene);
+            break;
+        default:
+            build_hole_3(hole, scene);
+            break;
+    }
+    VEC_FOR_EACH(body_t *, ball, hole->balls){
+        scene_add_body(scene, *ball);
+    }
+    return hole;
+}
+
+void golf_hole_free(golf_hole_t *hole){
+    body_list_free(hole->balls);
+    body_list_free(hole->obstacles);
+    free(hole);
+}
+
+body_t *golf_hole_get_ball(golf_hole_t *hole, size_t player){
+    assert(player >= 1 && player <= GOLF_HOLE_PLAYERS);
+    return body_list_get(hole->balls, player - 1);
+}
+
+body_t *golf_hole_get_cup(golf_hole_t *hole){
+    return hole->cup;
+}
+
+body_t *golf_hole_get_course(golf_hole_t *hole){
+    return hole->course;
+}
+
+size_t golf_hole_obstacles(golf_hole_t *hole){
+    return body_list_size(hole->obstacles);
+}
+
+body_t *golf_hole_get_obstacle(golf_hole_t *hole, size_t index){
+    return body_list_get(hole->obstacles, index);
+}
+
+void golf_hole_hit(body_t *ball, vector_t drag){
+    double length_squared = vec_dot(drag, drag);
+    if(length_squared > GOLF_MAX_DRAG_SQUARED){
+        drag = vec_multiply(GOLF_MAX_DRAG_SQUARED / length_squared, drag);
+    }
+    // the screen's y axis points down, so only x is flipped to launch the ball away from the drag
+    vector_t impulse = vec_multiply(GOLF_LAUNCH_FACTOR * body_get_mass(ball), drag);
+    impulse.x = -impulse.x;
+    body_add_impulse(ball, impulse);
+}
+
+bool golf_hole_sinks(body_t *ball){
+    vector_t velocity = body_get_velocity(ball);
+    return vec_dot(velocity, velocity) < GOLF_MAX_SINK_SPEED_SQUARED;
+}
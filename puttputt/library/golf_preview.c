@@ -0,0 +1,121 @@
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "golf_preview.h"
+#include "golf_hole.h"
+#include "body.h"
+#include "scene.h"
+#include "forces.h"
+#include "typed_vec.h"
+
+DECLARE_VEC(path_list, vector_t)
+
+// the same tick and rest detection as demo/golf.c, so the ball stops where it would in the game
+const double GOLF_PREVIEW_STEP = 1.0 / 240;
+const double GOLF_PREVIEW_SLEEP_SPEED = 2;
+const size_t GOLF_PREVIEW_SLEEP_TICKS = 60;
+// how far ahead a stroke is played out
+const double GOLF_PREVIEW_SECONDS = 4;
+// the path gets a point every this many pixels, and at bounces that are at least GOLF_PREVIEW_MIN_SPACING from the last one
+const double GOLF_PREVIEW_SPACING = 20;
+const double GOLF_PREVIEW_MIN_SPACING = 1;
+// a ball turning by more than acos() of this in one tick has bounced
+const double GOLF_PREVIEW_TURN_COS = 0.9;
+const size_t GOLF_PREVIEW_MAX_POINTS = 200;
+
+typedef struct golf_preview{
+    scene_t *scene;
+    golf_hole_t *hole;
+    // the hole with every body at rest, put back before each prediction
+    void *rest;
+    // the ball being hit, how fast it was going on the last tick, and whether it has dropped in
+    body_t *ball;
+    vector_t velocity;
+    bool sunk;
+    path_list_t *path;
+} golf_preview_t;
+
+static void drop_in(body_t *ball, body_t *cup, vector_t axis, golf_preview_t *preview){
+    (void) cup;
+    (void) axis;
+    if(ball == preview->ball && golf_hole_sinks(ball)) preview->sunk = true;
+}
+
+golf_preview_t *golf_preview_init(size_t number){
+    golf_preview_t *preview = malloc(sizeof(golf_preview_t));
+    assert(preview);
+    preview->scene = scene_init();
+    scene_enable_sleeping(preview->scene, GOLF_PREVIEW_SLEEP_SPEED, GOLF_PREVIEW_SLEEP_TICKS);
+    preview->hole = golf_hole_init(preview->scene, number);
+    for(size_t player = 1; player <= GOLF_HOLE_PLAYERS; player++){
+        body_t *ball = golf_hole_get_ball(preview->hole, player);
+        create_collision(preview->scene, ball, golf_hole_get_cup(preview->hole), (collision_handler_t) drop_in, preview, NULL);
+    }
+    // the course is left to fall asleep, so a prediction only wakes up what the ball touches
+    scene_fast_forward(preview->scene, GOLF_PREVIEW_STEP * (GOLF_PREVIEW_SLEEP_TICKS + 1), GOLF_PREVIEW_STEP, NULL, NULL);
+    preview->rest = malloc(scene_snapshot(preview->scene, NULL));
+    assert(preview->rest);
+    scene_snapshot(preview->scene, preview->rest);
+    preview->ball = NULL;
+    preview->velocity = VEC_ZERO;
+    preview->sunk = false;
+    preview->path = path_list_init(GOLF_PREVIEW_MAX_POINTS);
+    return preview;
+}
+
+void golf_preview_free(golf_preview_t *preview){
+    golf_hole_free(preview->hole);
+    scene_free(preview->scene);
+    free(preview->rest);
+    path_list_free(preview->path);
+    free(preview);
+}
+
+// adds a point to the path, unless it is right on top of the last one
+static void add_point(golf_preview_t *preview, vector_t point, double spacing){
+    vector_t last = path_list_get(preview->path, path_list_size(preview->path) - 1);
+    if(vec_dist(point, last) >= spacing) path_list_add(preview->path, point);
+}
+
+// records where the ball went on each tick, until it stops or drops in
+static bool follow_ball(scene_t *scene, golf_preview_t *preview){
+    (void) scene;
+    vector_t velocity = body_get_velocity(preview->ball);
+    double speeds = sqrt(vec_dot(velocity, velocity) * vec_dot(preview->velocity, preview->velocity));
+    bool turned = vec_dot(velocity, preview->velocity) < GOLF_PREVIEW_TURN_COS * speeds;
+    add_point(preview, body_get_centroid(preview->ball), turned ? GOLF_PREVIEW_MIN_SPACING : GOLF_PREVIEW_SPACING);
+    preview->velocity = velocity;
+    return !preview->sunk && !body_is_asleep(preview->ball) && path_list_size(preview->path) < GOLF_PREVIEW_MAX_POINTS;
+}
+
+const vector_t *golf_preview_predict(
+    golf_preview_t *preview,
+    size_t player,
+    vector_t position,
+    vector_t cup,
+    vector_t drag,
+    size_t *n
+){
+    scene_restore(preview->scene, preview->rest);
+    // the caller's copy of the hole may have been scrolled, so positions are moved onto this one and back
+    body_t *preview_cup = golf_hole_get_cup(preview->hole);
+    vector_t offset = vec_subtract(cup, body_get_centroid(preview_cup));
+    preview->ball = golf_hole_get_ball(preview->hole, player);
+    preview->sunk = false;
+    body_set_centroid(preview->ball, vec_subtract(position, offset));
+    golf_hole_hit(preview->ball, drag);
+    preview->velocity = body_get_velocity(preview->ball);
+    path_list_clear(preview->path);
+    path_list_add(preview->path, body_get_centroid(preview->ball));
+
+    scene_fast_forward(preview->scene, GOLF_PREVIEW_SECONDS, GOLF_PREVIEW_STEP, (tick_handler_t) follow_ball, preview);
+    vector_t end = preview->sunk ? body_get_centroid(preview_cup) : body_get_centroid(preview->ball);
+    add_point(preview, end, GOLF_PREVIEW_MIN_SPACING);
+
+    VEC_FOR_EACH(vector_t, point, preview->path){
+        *point = vec_add(*point, offset);
+    }
+    *n = path_list_size(preview->path);
+    return path_list_data(preview->path);
+}
@@ -0,0 +1,329 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <sched.h>
+#include "job_system.h"
+
+const size_t JOB_DEQUE_INITIAL_SIZE = 64;
+// the number of times an idle worker looks for jobs before going to sleep
+const int JOB_IDLE_ROUNDS = 64;
+// the number of jobs parallel_for queues at a time
+const size_t JOB_SUBMIT_BATCH = 64;
+
+typedef struct{
+    job_t job;
+    job_counter_t *counter;
+} job_entry_t;
+
+typedef struct job_batch{
+    struct job_batch *next;
+    job_counter_t *counter;
+    size_t count;
+    job_t jobs[];
+} job_batch_t;
+
+// a ring buffer of jobs; its owner pushes and pops the newest end, thieves take the oldest
+typedef struct{
+    pthread_mutex_t lock;
+    job_entry_t *entries;
+    size_t capacity;
+    size_t head;
+    size_t size;
+} job_deque_t;
+
+typedef struct{
+    job_system_t *jobs;
+    size_t index;
+} worker_t;
+
+typedef struct job_system{
+    size_t num_threads;
+    // the threads besides the one that created the system
+    pthread_t *threads;
+    worker_t *workers;
+    // one deque per thread; the first is shared by every thread that is not a worker
+    job_deque_t *deques;
+    // the number of jobs sitting in deques
+    atomic_size_t queued;
+    pthread_mutex_t sleep_lock;
+    pthread_cond_t wake;
+    bool stopping;
+} job_system_t;
+
+typedef struct{
+    job_func_t func;
+    void *aux;
+    size_t count;
+    size_t grain;
+} job_range_t;
+
+// the job system the current thread works for, and its deque
+static _Thread_local job_system_t *current_jobs = NULL;
+static _Thread_local size_t current_deque = 0;
+
+static void deque_init(job_deque_t *deque){
+    pthread_mutex_init(&deque->lock, NULL);
+    deque->capacity = JOB_DEQUE_INITIAL_SIZE;
+    deque->entries = malloc(deque->capacity * sizeof(job_entry_t));
+    assert(deque->entries);
+    deque->head = 0;
+    deque->size = 0;
+}
+
+static void deque_destroy(job_deque_t *deque){
+    pthread_mutex_destroy(&deque->lock);
+    free(deque->entries);
+}
+
+static void deque_push(job_deque_t *deque, job_entry_t entry){
+    pthread_mutex_lock(&deque->lock);
+    if(deque->size == deque->capacity){
+        job_entry_t *entries = malloc(2 * deque->capacity * sizeof(job_entry_t));
+        assert(entries);
+        for(size_t i = 0; i < deque->size; i++){
+            entries[i] = deque->entries[(deque->head + i) % deque->capacity];
+        }
+        free(deque->entries);
+        deque->entries = entries;
+        deque->capacity *= 2;
+        deque->head = 0;
+    }
+    deque->entries[(deque->head + deque->size) % deque->capacity] = entry;
+    deque->size++;
+    pthread_mutex_unlock(&deque->lock);
+}
+
+// takes the newest job, which is the most likely to still be in cache
+static bool deque_pop(job_deque_t *deque, job_entry_t *entry){
+    pthread_mutex_lock(&deque->lock);
+    bool found = deque->size > 0;
+    if(found){
+        deque->size--;
+        *entry = deque->entries[(deque->head + deque->size) % deque->capacity];
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return found;
+}
+
+// takes the oldest job, which is usually the start of a large piece of work
+static bool deque_steal(job_deque_t *deque, job_entry_t *entry){
+    pthread_mutex_lock(&deque->lock);
+    bool found = deque->size > 0;
+    if(found){
+        *entry = deque->entries[deque->head];
+        deque->head = (deque->head + 1) % deque->capacity;
+        deque->size--;
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return found;
+}
+
+static size_t own_deque(job_system_t *jobs){
+    return current_jobs == jobs ? current_deque : 0;
+}
+
+static bool find_job(job_system_t *jobs, job_entry_t *entry){
+    if(atomic_load(&jobs->queued) == 0) return false;
+    size_t self = own_deque(jobs);
+    bool found = deque_pop(&jobs->deques[self], entry);
+    for(size_t i = 1; !found && i < jobs->num_threads; i++){
+        found = deque_steal(&jobs->deques[(self + i) % jobs->num_threads], entry);
+    }
+    if(found) atomic_fetch_sub(&jobs->queued, 1);
+    return found;
+}
+
+static void queue_jobs(job_system_t *jobs, const job_t *batch, size_t count, job_counter_t *counter){
+    job_deque_t *deque = &jobs->deques[own_deque(jobs)];
+    for(size_t i = 0; i < count; i++){
+        deque_push(deque, (job_entry_t){.job = batch[i], .counter = counter});
+    }
+    atomic_fetch_add(&jobs->queued, count);
+    pthread_mutex_lock(&jobs->sleep_lock);
+    pthread_cond_broadcast(&jobs->wake);
+    pthread_mutex_unlock(&jobs->sleep_lock);
+}
+
+// counts a job as finished, releasing the jobs held back until its counter reached zero
+static void finish_job(job_system_t *jobs, job_counter_t *counter){
+    // the decrement happens under the lock, so a waiter that takes the lock afterwards
+    // knows this thread is done with the counter
+    pthread_mutex_lock(&counter->lock);
+    job_batch_t *released = NULL;
+    if(atomic_fetch_sub(&counter->pending, 1) == 1){
+        released = counter->dependents;
+        counter->dependents = NULL;
+    }
+    pthread_mutex_unlock(&counter->lock);
+    while(released != NULL){
+        job_batch_t *next = released->next;
+        queue_jobs(jobs, released->jobs, released->count, released->counter);
+        free(released);
+        released = next;
+    }
+}
+
+static void run_job(job_system_t *jobs, job_entry_t *entry){
+    entry->job.func(entry->job.aux, entry->job.index);
+    if(entry->counter != NULL) finish_job(jobs, entry->counter);
+}
+
+static void *worker_main(void *arg){
+    worker_t *worker = arg;
+    job_system_t *jobs = worker->jobs;
+    current_jobs = jobs;
+    current_deque = worker->index;
+    job_entry_t entry;
+    while(true){
+        bool found = false;
+        for(int round = 0; !found && round < JOB_IDLE_ROUNDS; round++){
+            found = find_job(jobs, &entry);
+            if(!found) sched_yield();
+        }
+        if(found){
+            run_job(jobs, &entry);
+            continue;
+        }
+        pthread_mutex_lock(&jobs->sleep_lock);
+        while(atomic_load(&jobs->queued) == 0 && !jobs->stopping){
+            pthread_cond_wait(&jobs->wake, &jobs->sleep_lock);
+        }
+        bool stopping = jobs->stopping;
+        pthread_mutex_unlock(&jobs->sleep_lock);
+        if(stopping) break;
+    }
+    return NULL;
+}
+
+job_system_t *job_system_init(size_t num_threads){
+    assert(num_threads > 0);
+    job_system_t *jobs = malloc(sizeof(job_system_t));
+    assert(jobs);
+    jobs->num_threads = num_threads;
+    jobs->threads = malloc(num_threads * sizeof(pthread_t));
+    jobs->workers = malloc(num_threads * sizeof(worker_t));
+    jobs->deques = malloc(num_threads * sizeof(job_deque_t));
+    assert(jobs->threads && jobs->workers && jobs->deques);
+    for(size_t i = 0; i < num_threads; i++){
+        deque_init(&jobs->deques[i]);
+    }
+    atomic_init(&jobs->queued, 0);
+    pthread_mutex_init(&jobs->sleep_lock, NULL);
+    pthread_cond_init(&jobs->wake, NULL);
+    jobs->stopping = false;
+    for(size_t i = 1; i < num_threads; i++){
+        jobs->workers[i] = (worker_t){.jobs = jobs, .index = i};
+        int error = pthread_create(&jobs->threads[i], NULL, worker_main, &jobs->workers[i]);
+        assert(error == 0);
+    }
+    return jobs;
+}
+
+void job_system_free(job_system_t *jobs){
+    assert(atomic_load(&jobs->queued) == 0);
+    pthread_mutex_lock(&jobs->sleep_lock);
+    jobs->stopping = true;
+    pthread_cond_broadcast(&jobs->wake);
+    pthread_mutex_unlock(&jobs->sleep_lock);
+    for(size_t i = 1; i < jobs->num_threads; i++){
+        pthread_join(jobs->threads[i], NULL);
+    }
+    for(size_t i = 0; i < jobs->num_threads; i++){
+        deque_destroy(&jobs->deques[i]);
+    }
+    pthread_mutex_destroy(&jobs->sleep_lock);
+    pthread_cond_destroy(&jobs->wake);
+    free(jobs->threads);
+    free(jobs->workers);
+    free(jobs->deques);
+    free(jobs);
+}
+
+size_t job_system_size(job_system_t *jobs){
+    return jobs == NULL ? 1 : jobs->num_threads;
+}
+
+void job_counter_init(job_counter_t *counter){
+    atomic_init(&counter->pending, 0);
+    pthread_mutex_init(&counter->lock, NULL);
+    counter->dependents = NULL;
+}
+
+void job_counter_destroy(job_counter_t *counter){
+    assert(atomic_load(&counter->pending) == 0 && counter->dependents == NULL);
+    pthread_mutex_destroy(&counter->lock);
+}
+
+void job_system_submit(job_system_t *jobs, const job_t *batch, size_t count, job_counter_t *counter){
+    if(count == 0) return;
+    if(counter != NULL) atomic_fetch_add(&counter->pending, count);
+    queue_jobs(jobs, batch, count, counter);
+}
+
+void job_system_submit_after(
+    job_system_t *jobs,
+    const job_t *batch,
+    size_t count,
+    job_counter_t *after,
+    job_counter_t *counter
+){
+    if(count == 0) return;
+    if(counter != NULL) atomic_fetch_add(&counter->pending, count);
+    pthread_mutex_lock(&after->lock);
+    if(atomic_load(&after->pending) == 0){
+        pthread_mutex_unlock(&after->lock);
+        queue_jobs(jobs, batch, count, counter);
+        return;
+    }
+    job_batch_t *held = malloc(sizeof(job_batch_t) + count * sizeof(job_t));
+    assert(held);
+    held->counter = counter;
+    held->count = count;
+    memcpy(held->jobs, batch, count * sizeof(job_t));
+    held->next = after->dependents;
+    after->dependents = held;
+    pthread_mutex_unlock(&after->lock);
+}
+
+void job_system_wait(job_system_t *jobs, job_counter_t *counter){
+    job_entry_t entry;
+    while(atomic_load(&counter->pending) > 0){
+        if(find_job(jobs, &entry)) run_job(jobs, &entry);
+        else sched_yield();
+    }
+    // the thread that finished the last job may still hold the lock
+    pthread_mutex_lock(&counter->lock);
+    pthread_mutex_unlock(&counter->lock);
+}
+
+static void run_range(job_range_t *range, size_t chunk){
+    size_t start = chunk * range->grain;
+    size_t end = start + range->grain < range->count ? start + range->grain : range->count;
+    for(size_t i = start; i < end; i++){
+        range->func(range->aux, i);
+    }
+}
+
+void job_system_parallel_for(job_system_t *jobs, size_t count, size_t grain, job_func_t func, void *aux){
+    assert(grain > 0);
+    if(jobs == NULL || jobs->num_threads == 1 || count <= grain){
+        for(size_t i = 0; i < count; i++){
+            func(aux, i);
+        }
+        return;
+    }
+    job_range_t range = {.func = func, .aux = aux, .count = count, .grain = grain};
+    job_counter_t counter;
+    job_counter_init(&counter);
+    job_t batch[JOB_SUBMIT_BATCH];
+    size_t chunks = (count + grain - 1) / grain;
+    for(size_t start = 0; start < chunks; start += JOB_SUBMIT_BATCH){
+        size_t size = chunks - start < JOB_SUBMIT_BATCH ? chunks - start : JOB_SUBMIT_BATCH;
+        for(size_t i = 0; i < size; i++){
+            batch[i] = (job_t){.func = (job_func_t) run_range, .aux = &range, .index = start + i};
+        }
+        job_system_submit(jobs, batch, size, &counter);
+    }
+    job_system_wait(jobs, &counter);
+    job_counter_destroy(&counter);
+}
@@ -44,19 +44,17 @@ void list_set(list_t *list, size_t index, void* value){
 void list_add(list_t *list, void *value){
     assert(value);
     if(list->length >= list->capacity){
-        *list = *list_increase_capacity(list);
+        list_increase_capacity(list);
     }
     list->arr[list->length] = value;
     list->length++;
 }
 
 list_t *list_increase_capacity(list_t *list){
-    list_t *new_list = list_init((list->capacity + 1) * GROWING_RATE, list->free_list);
-    for(size_t i = 0; i < list->length; i++){
-        new_list->arr[i] = list->arr[i];
-    }
-    new_list->length = list->length;
-    return new_list;
+    list->capacity = (list->capacity + 1) * GROWING_RATE;
+    list->arr = realloc(list->arr, list->capacity * sizeof(void*));
+    assert(list->arr);
+    return list;
 }
 
 void *list_remove(list_t *list, size_t index){
@@ -0,0 +1,126 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "pair_map.h"
+
+const size_t PAIR_MAP_MIN_SLOTS = 16;
+
+typedef struct{
+    const void *a;
+    const void *b;
+    void *value;
+} pair_slot_t;
+
+typedef struct pair_map{
+    pair_slot_t *slots;
+    size_t capacity;
+    size_t size;
+} pair_map_t;
+
+// orders the pair so (a, b) and (b, a) share a slot
+static void pair_order(const void **a, const void **b){
+    if((uintptr_t) *a > (uintptr_t) *b){
+        const void *temp = *a;
+        *a = *b;
+        *b = temp;
+    }
+}
+
+static size_t pair_hash(const void *a, const void *b){
+    uint64_t h = (uint64_t) (uintptr_t) a * 0x9E3779B97F4A7C15ULL;
+    h ^= (uint64_t) (uintptr_t) b + 0x632BE59BD9B4E019ULL + (h << 6) + (h >> 2);
+    h ^= h >> 31;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 29;
+    return (size_t) h;
+}
+
+static pair_slot_t *pair_map_alloc_slots(size_t capacity){
+    pair_slot_t *slots = calloc(capacity, sizeof(pair_slot_t));
+    assert(slots);
+    return slots;
+}
+
+pair_map_t *pair_map_init(size_t initial_size){
+    pair_map_t *map = malloc(sizeof(pair_map_t));
+    assert(map);
+    size_t capacity = PAIR_MAP_MIN_SLOTS;
+    while(capacity < 2 * initial_size) capacity *= 2;
+    map->slots = pair_map_alloc_slots(capacity);
+    map->capacity = capacity;
+    map->size = 0;
+    return map;
+}
+
+void pair_map_free(pair_map_t *map){
+    free(map->slots);
+    free(map);
+}
+
+size_t pair_map_size(pair_map_t *map){
+    return map->size;
+}
+
+// finds the slot holding the pair, or the empty slot where it would go
+static size_t pair_map_find(pair_map_t *map, const void *a, const void *b){
+    size_t mask = map->capacity - 1;
+    size_t i = pair_hash(a, b) & mask;
+    while(map->slots[i].value != NULL && (map->slots[i].a != a || map->slots[i].b != b)){
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+static void pair_map_grow(pair_map_t *map){
+    pair_slot_t *old_slots = map->slots;
+    size_t old_capacity = map->capacity;
+    map->capacity *= 2;
+    map->slots = pair_map_alloc_slots(map->capacity);
+    for(size_t i = 0; i < old_capacity; i++){
+        if(old_slots[i].value != NULL){
+            map->slots[pair_map_find(map, old_slots[i].a, old_slots[i].b)] = old_slots[i];
+        }
+    }
+    free(old_slots);
+}
+
+void *pair_map_get(pair_map_t *map, const void *a, const void *b){
+    pair_order(&a, &b);
+    return map->slots[pair_map_find(map, a, b)].value;
+}
+
+void pair_map_set(pair_map_t *map, const void *a, const void *b, void *value){
+    assert(value);
+    pair_order(&a, &b);
+    // keeps the load factor at or below one half
+    if(2 * (map->size + 1) > map->capacity) pair_map_grow(map);
+    pair_slot_t *slot = &map->slots[pair_map_find(map, a, b)];
+    if(slot->value == NULL) map->size++;
+    slot->a = a;
+    slot->b = b;
+    slot->value = value;
+}
+
+void *pair_map_remove(pair_map_t *map, const void *a, const void *b){
+    pair_order(&a, &b);
+    size_t mask = map->capacity - 1;
+    size_t hole = pair_map_find(map, a, b);
+    void *removed = map->slots[hole].value;
+    if(removed == NULL) return NULL;
+    map->slots[hole].value = NULL;
+    map->size--;
+    // shifts later entries of the probe run back so lookups never stop early
+    size_t i = (hole + 1) & mask;
+    while(map->slots[i].value != NULL){
+        size_t home = pair_hash(map->slots[i].a, map->slots[i].b) & mask;
+        bool movable = (i > hole) ? (home <= hole || home > i) : (home <= hole && home > i);
+        if(movable){
+            map->slots[hole] = map->slots[i];
+            map->slots[i].value = NULL;
+            hole = i;
+        }
+        i = (i + 1) & mask;
+    }
+    return removed;
+}
@@ -1,50 +1,178 @@
 #include <math.h>
-#include <stdlib.h> 
+#include <stdlib.h>
+#include <assert.h>
 #include "list.h"
 #include "vector.h"
+#include "polygon.h"
 
-double polygon_area(list_t *polygon){
+const size_t POLYGON_MIN_SIZE = 4;
+
+typedef struct polygon{
+    vector_t *points;
+    size_t size;
+    size_t capacity;
+} polygon_t;
+
+static double points_area(vector_t *points, size_t n){
     double size = 0;
-    size_t polygon_size = list_size(polygon);
-    for(size_t i = 0; i<polygon_size; i++){
-        size += vec_cross((*(vector_t*)list_get(polygon, i % polygon_size)), (*(vector_t*)(list_get(polygon, (i+1) % polygon_size))));
+    for(size_t i = 0; i<n; i++){
+        size += vec_cross(points[i], points[(i+1) % n]);
     }
     return fabs(size)/2;
 }
 
-vector_t polygon_centroid(list_t *polygon){
+static vector_t points_centroid(vector_t *points, size_t n){
     double centroid_x = 0;
     double centroid_y = 0;
-    size_t polygon_size = list_size(polygon);
-    for(size_t i = 0; i < polygon_size; i++){
+    for(size_t i = 0; i < n; i++){
         //% makes the values loop around
-        centroid_x += ((((vector_t*)list_get(polygon, i % polygon_size))->x + ((vector_t*)list_get(polygon, (i+1) % polygon_size))->x) 
-                        * vec_cross((*(vector_t*)list_get(polygon, i % polygon_size)), (*(vector_t*)list_get(polygon, (i+1) % polygon_size))));
-        centroid_y += ((((vector_t*)list_get(polygon, i % polygon_size))->y + ((vector_t*)list_get(polygon, (i+1) % polygon_size))->y) 
-                        * vec_cross((*(vector_t*)list_get(polygon, i % polygon_size)), (*(vector_t*)list_get(polygon, (i+1) % polygon_size))));
+        vector_t point1 = points[i];
+        vector_t point2 = points[(i+1) % n];
+        centroid_x += (point1.x + point2.x) * vec_cross(point1, point2);
+        centroid_y += (point1.y + point2.y) * vec_cross(point1, point2);
     }
-    centroid_x /= (6 * polygon_area(polygon));
-    centroid_y /= (6 * polygon_area(polygon));
+    centroid_x /= (6 * points_area(points, n));
+    centroid_y /= (6 * points_area(points, n));
     vector_t centroid = {.x = centroid_x, .y = centroid_y};
     return centroid;
 }
 
+static vector_t rotate_point(vector_t point, double angle, vector_t center){
+    return vec_add(vec_rotate(vec_add(point, vec_negate(center)), angle), center);
+}
+
+double polygon_area(list_t *polygon){
+    polygon_t *points = polygon_from_list(polygon);
+    double area = polygon_get_area(points);
+    polygon_free(points);
+    return area;
+}
+
+vector_t polygon_centroid(list_t *polygon){
+    polygon_t *points = polygon_from_list(polygon);
+    vector_t centroid = polygon_get_centroid(points);
+    polygon_free(points);
+    return centroid;
+}
+
 void polygon_translate(list_t *polygon, vector_t translation){
     for(size_t i = 0; i<list_size(polygon); i++){
-        vector_t *new_vec = malloc(sizeof(vector_t));
-        *new_vec = vec_add(*(vector_t*)(list_get(polygon, i)), translation);
-        free(list_get(polygon, i));
-        list_set(polygon, i, (void *) new_vec);
+        vector_t *vec = list_get(polygon, i);
+        *vec = vec_add(*vec, translation);
     }
 }
 
 void polygon_rotate(list_t *polygon, double angle, vector_t point){
-    polygon_translate(polygon, vec_negate(point));
     for(size_t i = 0; i<list_size(polygon); i++){
-        vector_t *new_vec = malloc(sizeof(vector_t));
-        *new_vec = vec_rotate(*(vector_t*)(list_get(polygon, i)), angle);
-        free(list_get(polygon, i));
-        list_set(polygon, i, new_vec);
+        vector_t *vec = list_get(polygon, i);
+        *vec = rotate_point(*vec, angle, point);
+    }
+}
+
+polygon_t *polygon_init(size_t initial_size){
+    polygon_t *polygon = malloc(sizeof(polygon_t));
+    assert(polygon);
+    polygon->capacity = initial_size > POLYGON_MIN_SIZE ? initial_size : POLYGON_MIN_SIZE;
+    polygon->points = malloc(polygon->capacity * sizeof(vector_t));
+    assert(polygon->points);
+    polygon->size = 0;
+    return polygon;
+}
+
+polygon_t *polygon_from_list(list_t *points){
+    polygon_t *polygon = polygon_init(list_size(points));
+    for(size_t i = 0; i < list_size(points); i++){
+        polygon_add(polygon, *(vector_t *) list_get(points, i));
+    }
+    return polygon;
+}
+
+static void free_vec_list(list_t *list){
+    for(size_t i = 0; i < list_size(list); i++){
+        free(list_get(list, i));
+    }
+    free(list);
+}
+
+list_t *polygon_to_list(polygon_t *polygon){
+    list_t *points = list_init(polygon->size, (free_func_t) free_vec_list);
+    for(size_t i = 0; i < polygon->size; i++){
+        vector_t *point = malloc(sizeof(vector_t));
+        assert(point);
+        *point = polygon->points[i];
+        list_add(points, point);
+    }
+    return points;
+}
+
+polygon_t *polygon_copy(polygon_t *polygon){
+    polygon_t *copy = polygon_init(polygon->size);
+    for(size_t i = 0; i < polygon->size; i++){
+        copy->points[i] = polygon->points[i];
     }
-    polygon_translate(polygon, point);
-}
\ No newline at end of file
+    copy->size = polygon->size;
+    return copy;
+}
+
+void polygon_free(polygon_t *polygon){
+    free(polygon->points);
+    free(polygon);
+}
+
+size_t polygon_size(polygon_t *polygon){
+    return polygon->size;
+}
+
+vector_t polygon_get(polygon_t *polygon, size_t index){
+    assert(index < polygon->size);
+    return polygon->points[index];
+}
+
+vector_t *polygon_points(polygon_t *polygon){
+    return polygon->points;
+}
+
+void polygon_add(polygon_t *polygon, vector_t point){
+    if(polygon->size == polygon->capacity){
+        polygon->capacity *= 2;
+        polygon->points = realloc(polygon->points, polygon->capacity * sizeof(vector_t));
+        assert(polygon->points);
+    }
+    polygon->points[polygon->size++] = point;
+}
+
+double polygon_get_area(polygon_t *polygon){
+    return points_area(polygon->points, polygon->size);
+}
+
+vector_t polygon_get_centroid(polygon_t *polygon){
+    return points_centroid(polygon->points, polygon->size);
+}
+
+void polygon_move_by(polygon_t *polygon, vector_t translation){
+    for(size_t i = 0; i < polygon->size; i++){
+        polygon->points[i] = vec_add(polygon->points[i], translation);
+    }
+}
+
+void polygon_rotate_about(polygon_t *polygon, double angle, vector_t point){
+    for(size_t i = 0; i < polygon->size; i++){
+        polygon->points[i] = rotate_point(polygon->points[i], angle, point);
+    }
+}
+
+void polygon_transform(polygon_t *dest, polygon_t *local, vector_t position, double angle){
+    while(dest->capacity < local->size){
+        dest->capacity *= 2;
+        dest->points = realloc(dest->points, dest->capacity * sizeof(vector_t));
+        assert(dest->points);
+    }
+    double c = cos(angle);
+    double s = sin(angle);
+    for(size_t i = 0; i < local->size; i++){
+        vector_t point = local->points[i];
+        dest->points[i].x = position.x + point.x * c - point.y * s;
+        dest->points[i].y = position.y + point.x * s + point.y * c;
+    }
+    dest->size = local->size;
+}
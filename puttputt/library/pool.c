@@ -0,0 +1,89 @@
+#include <stddef.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "pool.h"
+
+typedef struct pool_chunk{
+    struct pool_chunk *next;
+} pool_chunk_t;
+
+// a released object holds the next released object
+typedef struct pool_slot{
+    struct pool_slot *next;
+} pool_slot_t;
+
+typedef struct pool{
+    size_t object_size;
+    size_t chunk_size;
+    pool_chunk_t *chunks;
+    pool_slot_t *free_slots;
+    size_t live;
+    size_t peak;
+} pool_t;
+
+static size_t align_up(size_t size){
+    return (size + sizeof(max_align_t) - 1) / sizeof(max_align_t) * sizeof(max_align_t);
+}
+
+pool_t *pool_init(size_t object_size, size_t chunk_size){
+    assert(chunk_size > 0);
+    pool_t *pool = malloc(sizeof(pool_t));
+    assert(pool);
+    pool->object_size = align_up(object_size > sizeof(pool_slot_t) ? object_size : sizeof(pool_slot_t));
+    pool->chunk_size = chunk_size;
+    pool->chunks = NULL;
+    pool->free_slots = NULL;
+    pool->live = 0;
+    pool->peak = 0;
+    return pool;
+}
+
+void pool_free(pool_t *pool){
+    pool_chunk_t *chunk = pool->chunks;
+    while(chunk != NULL){
+        pool_chunk_t *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    free(pool);
+}
+
+// adds a chunk's worth of objects to the free list, keeping them in address order
+static void pool_grow(pool_t *pool){
+    size_t header = align_up(sizeof(pool_chunk_t));
+    pool_chunk_t *chunk = malloc(header + pool->chunk_size * pool->object_size);
+    assert(chunk);
+    chunk->next = pool->chunks;
+    pool->chunks = chunk;
+    char *objects = (char *) chunk + header;
+    for(size_t i = pool->chunk_size; i > 0; i--){
+        pool_slot_t *slot = (pool_slot_t *) (objects + (i - 1) * pool->object_size);
+        slot->next = pool->free_slots;
+        pool->free_slots = slot;
+    }
+}
+
+void *pool_alloc(pool_t *pool){
+    if(pool->free_slots == NULL) pool_grow(pool);
+    pool_slot_t *slot = pool->free_slots;
+    pool->free_slots = slot->next;
+    pool->live++;
+    if(pool->live > pool->peak) pool->peak = pool->live;
+    return slot;
+}
+
+void pool_release(pool_t *pool, void *object){
+    assert(pool->live > 0);
+    pool_slot_t *slot = object;
+    slot->next = pool->free_slots;
+    pool->free_slots = slot;
+    pool->live--;
+}
+
+size_t pool_live(pool_t *pool){
+    return pool->live;
+}
+
+size_t pool_peak(pool_t *pool){
+    return pool->peak;
+}
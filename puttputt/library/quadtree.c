@@ -0,0 +1,211 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <math.h>
+#include "quadtree.h"
+
+const int32_t QUADTREE_NONE = -1;
+// points closer together than the smallest node are chained in one leaf
+const int QUADTREE_MAX_DEPTH = 24;
+const size_t QUADTREE_INITIAL_NODES = 64;
+
+typedef struct{
+    vector_t center;
+    double half_size;
+    double mass;
+    vector_t center_of_mass;
+    // the first child, the other three follow it; QUADTREE_NONE for leaves
+    int32_t children;
+    // the first point in a leaf, followed through the next array
+    int32_t first;
+} quad_node_t;
+
+typedef struct quadtree{
+    quad_node_t *nodes;
+    size_t num_nodes;
+    size_t nodes_capacity;
+    // the next point in the same leaf as each point
+    int32_t *next;
+    size_t next_capacity;
+    const vector_t *positions;
+    const double *masses;
+    size_t num_points;
+} quadtree_t;
+
+quadtree_t *quadtree_init(void){
+    quadtree_t *tree = malloc(sizeof(quadtree_t));
+    assert(tree);
+    tree->nodes_capacity = QUADTREE_INITIAL_NODES;
+    tree->nodes = malloc(tree->nodes_capacity * sizeof(quad_node_t));
+    assert(tree->nodes);
+    tree->num_nodes = 0;
+    tree->next = NULL;
+    tree->next_capacity = 0;
+    tree->positions = NULL;
+    tree->masses = NULL;
+    tree->num_points = 0;
+    return tree;
+}
+
+void quadtree_free(quadtree_t *tree){
+    free(tree->nodes);
+    free(tree->next);
+    free(tree);
+}
+
+// adds four empty children to a leaf, returning the index of the first
+static int32_t split_node(quadtree_t *tree, int32_t index){
+    if(tree->num_nodes + 4 > tree->nodes_capacity){
+        tree->nodes_capacity *= 2;
+        tree->nodes = realloc(tree->nodes, tree->nodes_capacity * sizeof(quad_node_t));
+        assert(tree->nodes);
+    }
+    int32_t first = tree->num_nodes;
+    double quarter = tree->nodes[index].half_size / 2;
+    for(int i = 0; i < 4; i++){
+        quad_node_t *child = &tree->nodes[first + i];
+        child->center = tree->nodes[index].center;
+        child->center.x += (i & 1) ? quarter : -quarter;
+        child->center.y += (i & 2) ? quarter : -quarter;
+        child->half_size = quarter;
+        child->children = QUADTREE_NONE;
+        child->first = QUADTREE_NONE;
+    }
+    tree->num_nodes += 4;
+    tree->nodes[index].children = first;
+    return first;
+}
+
+static int32_t child_for(quadtree_t *tree, int32_t index, vector_t position){
+    quad_node_t *node = &tree->nodes[index];
+    int quadrant = (position.x >= node->center.x) | ((position.y >= node->center.y) << 1);
+    return node->children + quadrant;
+}
+
+static void insert_point(quadtree_t *tree, int32_t point){
+    vector_t position = tree->positions[point];
+    int32_t index = 0;
+    int depth = 0;
+    while(tree->nodes[index].children != QUADTREE_NONE){
+        index = child_for(tree, index, position);
+        depth++;
+    }
+    // pushes the existing point down until the two points land in different leaves
+    while(tree->nodes[index].first != QUADTREE_NONE && depth < QUADTREE_MAX_DEPTH){
+        int32_t other = tree->nodes[index].first;
+        tree->nodes[index].first = QUADTREE_NONE;
+        split_node(tree, index);
+        int32_t other_leaf = child_for(tree, index, tree->positions[other]);
+        tree->nodes[other_leaf].first = other;
+        index = child_for(tree, index, position);
+        depth++;
+    }
+    tree->next[point] = tree->nodes[index].first;
+    tree->nodes[index].first = point;
+}
+
+// fills in the mass and center of mass of a node and everything below it
+static void sum_masses(quadtree_t *tree, int32_t index){
+    quad_node_t *node = &tree->nodes[index];
+    double mass = 0;
+    vector_t moment = VEC_ZERO;
+    if(node->children == QUADTREE_NONE){
+        for(int32_t point = node->first; point != QUADTREE_NONE; point = tree->next[point]){
+            mass += tree->masses[point];
+            moment = vec_add(moment, vec_multiply(tree->masses[point], tree->positions[point]));
+        }
+    }
+    else{
+        int32_t first = node->children;
+        for(int i = 0; i < 4; i++){
+            sum_masses(tree, first + i);
+            quad_node_t *child = &tree->nodes[first + i];
+            mass += child->mass;
+            moment = vec_add(moment, vec_multiply(child->mass, child->center_of_mass));
+        }
+        node = &tree->nodes[index];
+    }
+    node->mass = mass;
+    node->center_of_mass = mass > 0 ? vec_multiply(1 / mass, moment) : node->center;
+}
+
+void quadtree_build(quadtree_t *tree, const vector_t *positions, const double *masses, size_t n){
+    tree->positions = positions;
+    tree->masses = masses;
+    tree->num_points = n;
+    tree->num_nodes = 0;
+    if(n == 0) return;
+    if(n > tree->next_capacity){
+        tree->next_capacity = n;
+        tree->next = realloc(tree->next, n * sizeof(int32_t));
+        assert(tree->next);
+    }
+    // the root is the smallest square containing every point
+    vector_t min = positions[0];
+    vector_t max = positions[0];
+    for(size_t i = 1; i < n; i++){
+        min.x = fmin(min.x, positions[i].x);
+        min.y = fmin(min.y, positions[i].y);
+        max.x = fmax(max.x, positions[i].x);
+        max.y = fmax(max.y, positions[i].y);
+    }
+    quad_node_t *root = &tree->nodes[0];
+    root->center = vec_multiply(0.5, vec_add(min, max));
+    root->half_size = fmax(fmax(max.x - min.x, max.y - min.y) / 2, 1);
+    root->children = QUADTREE_NONE;
+    root->first = QUADTREE_NONE;
+    tree->num_nodes = 1;
+    for(size_t i = 0; i < n; i++){
+        insert_point(tree, i);
+    }
+    sum_masses(tree, 0);
+}
+
+// adds the pull of a mass at the given displacement to the field
+static void add_pull(vector_t *field, double dx, double dy, double mass, double min_dist){
+    double dist_squared = dx * dx + dy * dy;
+    if(dist_squared <= min_dist * min_dist) return;
+    double scale = mass / (dist_squared * sqrt(dist_squared));
+    field->x += scale * dx;
+    field->y += scale * dy;
+}
+
+static bool node_contains(quad_node_t *node, vector_t position){
+    return fabs(position.x - node->center.x) <= node->half_size
+        && fabs(position.y - node->center.y) <= node->half_size;
+}
+
+vector_t quadtree_field(quadtree_t *tree, size_t index, double theta, double min_dist){
+    assert(index < tree->num_points);
+    vector_t position = tree->positions[index];
+    vector_t field = VEC_ZERO;
+    // opening a node replaces it with its four children, and leaves are never deeper than the max depth
+    int32_t stack[3 * QUADTREE_MAX_DEPTH + 4];
+    size_t count = 0;
+    stack[count++] = 0;
+    while(count > 0){
+        quad_node_t *node = &tree->nodes[stack[--count]];
+        if(node->mass == 0) continue;
+        if(node->children == QUADTREE_NONE){
+            for(int32_t point = node->first; point != QUADTREE_NONE; point = tree->next[point]){
+                if(point == (int32_t) index) continue;
+                vector_t other = tree->positions[point];
+                add_pull(&field, other.x - position.x, other.y - position.y, tree->masses[point], min_dist);
+            }
+            continue;
+        }
+        double dx = node->center_of_mass.x - position.x;
+        double dy = node->center_of_mass.y - position.y;
+        double width = 2 * node->half_size;
+        // a node is never approximated if the point is inside it, so it never pulls on itself
+        if(width * width < theta * theta * (dx * dx + dy * dy) && !node_contains(node, position)){
+            add_pull(&field, dx, dy, node->mass, min_dist);
+            continue;
+        }
+        for(int i = 0; i < 4; i++){
+            stack[count++] = node->children + i;
+        }
+    }
+    return field;
+}
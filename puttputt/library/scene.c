@@ -1,33 +1,255 @@
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <assert.h>
+#include <math.h>
 #include "forces.h"
 #include "body.h"
 #include "list.h"
 #include "scene.h"
 #include "force.h"
+#include "aabb.h"
+#include "aabb_tree.h"
+#include "broadphase.h"
+#include "pair_map.h"
+#include "body_store.h"
+#include "arena.h"
+#include "pool.h"
+#include "force_batch.h"
+#include "contact_solver.h"
+#include "collision.h"
+#include "job_system.h"
+#include "snapshot.h"
+#include "typed_vec.h"
 
 const int DEFAULT_NUM_BODIES = 20;
+// how far a body can move before it has to be reinserted into the tree
+const double FAT_BOUNDS_MARGIN = 4;
+const size_t SCENE_ARENA_SIZE = 16384;
+// the number of forces and force parameters to allocate at a time
+const size_t SCENE_POOL_CHUNK = 256;
+const size_t SCENE_CLONE_MIN_CHUNK = 16;
+// the number of slots each job moves
+const size_t SCENE_INTEGRATE_CHUNK = 2048;
+// the number of halvings used to find when a non-circular bullet first touches something
+const int SCENE_BULLET_BISECTIONS = 16;
+// the first bytes of every scene snapshot, to catch restoring something else
+const uint32_t SCENE_SNAPSHOT_MAGIC = 0x70757474;
+// the flags saved for each force
+const uint8_t SNAPSHOT_FORCE_ACTIVE = 1;
+const uint8_t SNAPSHOT_FORCE_RECENT = 2;
+
+typedef struct{
+    body_t *body;
+    // the centroid before the tick moved the body
+    vector_t start;
+} bullet_t;
+
+typedef struct{
+    scene_t *scene;
+    body_t *bullet;
+    vector_t start;
+    vector_t end;
+    // the earliest time of impact found so far, as a fraction of the tick
+    double toi;
+} sweep_t;
+
+typedef struct{
+    scene_t *scene;
+    body_t *body;
+} contact_query_t;
+
+typedef struct{
+    body_store_t *store;
+    double dt;
+} integration_t;
+
+// where a handle's body or force is in the scene's list, and how many times the handle has been given out
+typedef struct{
+    size_t generation;
+    size_t position;
+} handle_entry_t;
+
+DECLARE_VEC(handle_entry_list, handle_entry_t)
+DECLARE_VEC(index_list, size_t)
+DECLARE_VEC(handle_list, scene_handle_t)
+
+// a slot's body's handle, and the handles of the forces on the body, some of which may have been removed since
+typedef struct{
+    size_t handle;
+    handle_list_t *forces;
+} slot_info_t;
+
+DECLARE_VEC(slot_info_list, slot_info_t)
+DECLARE_VEC(body_ptr_list, body_t *)
+
+typedef struct{
+    handle_entry_list_t *entries;
+    // the entries whose handles have been released, reused last in first out
+    index_list_t *unused;
+} handle_table_t;
 
 typedef struct scene{
+    // each body is at the index of its slot in the store
     list_t* bodies;
+    // the physics state of every body, stored contiguously
+    body_store_t *store;
     list_t* forces;
     void* state;
+    // set in a clone, whose state belongs to the scene it was copied from
+    bool borrowed_state;
+    aabb_tree_t *tree;
+    // if non-NULL, the grid that finds the pairs of bodies instead of the tree, refilled every tick
+    broadphase_t *grid;
+    double grid_cell_size;
+    // handles to the bodies and forces, which stay valid while the lists are compacted
+    handle_table_t body_handles;
+    handle_table_t force_handles;
+    // what is known about the body in each slot, in the same order as the bodies
+    slot_info_list_t *slots;
+    // forces added before all their bodies were in the scene, so they are not in their bodies' lists yet
+    handle_list_t *unlinked_forces;
+    // set while scene_clone() adds the copies of the forces, whose handles and links are copied instead
+    bool copying_forces;
+    // the bodies found to be removed at the end of a tick, and the handles of the forces to free with them
+    body_ptr_list_t *removed_bodies;
+    handle_list_t *removed_forces;
+    // maps each pair of bodies to the list of contact forces between them
+    pair_map_t *contacts;
+    // contact forces whose bodies' bounding boxes overlapped last tick
+    handle_list_t *recent_contacts;
+    // memory that only lives until the next tick
+    arena_t *arena;
+    pool_t *force_pool;
+    pool_t *aux_pool;
+    // the built-in forces, evaluated a kind at a time
+    force_batch_t *batch;
+    // the pairs of bodies that bounce off each other
+    contact_solver_t *solver;
+    // the time scene_step_fixed() has been given but not yet simulated
+    double accumulator;
+    // how far the scene is between the last two fixed steps, for drawing
+    double alpha;
+    // bodies slower than sleep_speed for sleep_ticks ticks in a row go to sleep; 0 ticks never sleeps
+    double sleep_speed;
+    size_t sleep_ticks;
+    // the parent of each slot in the union-find forest of islands, while ticking with sleeping on
+    size_t *islands;
+    size_t island_count;
+    // the job system to split work across, if any; not owned by the scene
+    job_system_t *jobs;
 } scene_t;
 
+static void handle_table_init(handle_table_t *table){
+    table->entries = handle_entry_list_init(DEFAULT_NUM_BODIES);
+    table->unused = index_list_init(DEFAULT_NUM_BODIES);
+}
+
+static void handle_table_copy(handle_table_t *copy, handle_table_t *table){
+    copy->entries = handle_entry_list_init(handle_entry_list_size(table->entries));
+    handle_entry_list_append(copy->entries, handle_entry_list_data(table->entries), handle_entry_list_size(table->entries));
+    copy->unused = index_list_init(index_list_size(table->unused));
+    index_list_append(copy->unused, index_list_data(table->unused), index_list_size(table->unused));
+}
+
+static void handle_table_free(handle_table_t *table){
+    handle_entry_list_free(table->entries);
+    index_list_free(table->unused);
+}
+
+// gives out a handle to whatever is at a position, returning the index of its entry.
+// generations start at 1, so a zeroed handle never refers to anything
+static size_t handle_acquire(handle_table_t *table, size_t position){
+    if(index_list_size(table->unused) > 0){
+        size_t index = index_list_swap_remove(table->unused, index_list_size(table->unused) - 1);
+        handle_entry_list_data(table->entries)[index].position = position;
+        return index;
+    }
+    handle_entry_list_add(table->entries, (handle_entry_t){.generation = 1, .position = position});
+    return handle_entry_list_size(table->entries) - 1;
+}
+
+// makes every copy of a handle stale, so its entry can be given out again
+static void handle_release(handle_table_t *table, size_t index){
+    handle_entry_list_data(table->entries)[index].generation++;
+    index_list_add(table->unused, index);
+}
+
+static void handle_move(handle_table_t *table, size_t index, size_t position){
+    handle_entry_list_data(table->entries)[index].position = position;
+}
+
+static scene_handle_t handle_get(handle_table_t *table, size_t index){
+    return (scene_handle_t){.index = index, .generation = handle_entry_list_get(table->entries, index).generation};
+}
+
+// gets the position of a handle's body or force, or SIZE_MAX if it has been removed
+static size_t handle_resolve(handle_table_t *table, scene_handle_t handle){
+    if(handle.index >= handle_entry_list_size(table->entries)) return SIZE_MAX;
+    handle_entry_t entry = handle_entry_list_get(table->entries, handle.index);
+    return entry.generation == handle.generation ? entry.position : SIZE_MAX;
+}
+
 scene_t *scene_init(void){
     scene_t *scene = malloc(sizeof(scene_t));
     assert(scene);
     scene->bodies = list_init(DEFAULT_NUM_BODIES, (free_func_t) scene_bodies_free);
+    scene->store = body_store_init(DEFAULT_NUM_BODIES);
     scene->forces = list_init(DEFAULT_NUM_BODIES, (free_func_t) scene_forces_free);
     scene->state = NULL;
+    scene->borrowed_state = false;
+    scene->tree = aabb_tree_init(FAT_BOUNDS_MARGIN);
+    scene->grid = NULL;
+    scene->grid_cell_size = 0;
+    handle_table_init(&scene->body_handles);
+    handle_table_init(&scene->force_handles);
+    scene->slots = slot_info_list_init(DEFAULT_NUM_BODIES);
+    scene->unlinked_forces = handle_list_init(DEFAULT_NUM_BODIES);
+    scene->copying_forces = false;
+    scene->removed_bodies = body_ptr_list_init(DEFAULT_NUM_BODIES);
+    scene->removed_forces = handle_list_init(DEFAULT_NUM_BODIES);
+    scene->contacts = pair_map_init(DEFAULT_NUM_BODIES);
+    scene->recent_contacts = handle_list_init(DEFAULT_NUM_BODIES);
+    scene->arena = arena_init(SCENE_ARENA_SIZE);
+    scene->force_pool = force_pool_init(SCENE_POOL_CHUNK);
+    scene->aux_pool = aux_pool_init(SCENE_POOL_CHUNK);
+    scene->batch = force_batch_init();
+    scene->solver = contact_solver_init();
+    scene->accumulator = 0;
+    scene->alpha = 1;
+    scene->sleep_speed = 0;
+    scene->sleep_ticks = 0;
+    scene->islands = NULL;
+    scene->island_count = 0;
+    scene->jobs = NULL;
     return scene;
 }
 
+// removes a contact force from the list kept for its pair of bodies
+static void scene_unlink_contact(scene_t *scene, force_t *force){
+    list_t *bodies = force_get_bodies(force);
+    body_t *body1 = list_get(bodies, 0);
+    body_t *body2 = list_get(bodies, 1);
+    list_t *pair_forces = pair_map_get(scene->contacts, body1, body2);
+    for(size_t i = 0; i < list_size(pair_forces); i++){
+        if(list_get(pair_forces, i) == force){
+            list_remove(pair_forces, i);
+            break;
+        }
+    }
+    if(list_size(pair_forces) == 0){
+        pair_map_remove(scene->contacts, body1, body2);
+        list_free(pair_forces);
+    }
+}
+
 void scene_forces_free(scene_t *scene){
     for(size_t i = 0; i < list_size(scene->forces); i++){
-        force_free(list_get(scene->forces, i));
+        force_t *force = list_get(scene->forces, i);
+        if(force_is_contact(force)) scene_unlink_contact(scene, force);
+        force_free(force);
     }
     free(scene->forces);
 }
@@ -42,6 +264,25 @@ void scene_bodies_free(scene_t *scene){
 void scene_free(scene_t *scene){
     scene_bodies_free(scene);
     scene_forces_free(scene);
+    aabb_tree_free(scene->tree);
+    if(scene->grid != NULL) broadphase_free(scene->grid);
+    body_store_free(scene->store);
+    handle_table_free(&scene->body_handles);
+    handle_table_free(&scene->force_handles);
+    VEC_FOR_EACH(slot_info_t, info, scene->slots){
+        if(info->forces != NULL) handle_list_free(info->forces);
+    }
+    slot_info_list_free(scene->slots);
+    handle_list_free(scene->unlinked_forces);
+    body_ptr_list_free(scene->removed_bodies);
+    handle_list_free(scene->removed_forces);
+    pair_map_free(scene->contacts);
+    handle_list_free(scene->recent_contacts);
+    arena_free(scene->arena);
+    pool_free(scene->force_pool);
+    pool_free(scene->aux_pool);
+    force_batch_free(scene->batch);
+    contact_solver_free(scene->solver);
     free(scene);
 }
 
@@ -54,6 +295,10 @@ body_t *scene_get_body(scene_t *scene, size_t index){
 }
 
 void scene_add_body(scene_t *scene, body_t *body){
+    body_attach(body, scene->store);
+    body_set_proxy(body, aabb_tree_insert(scene->tree, body, body_get_bounds(body)));
+    size_t handle = handle_acquire(&scene->body_handles, list_size(scene->bodies));
+    slot_info_list_add(scene->slots, (slot_info_t){.handle = handle, .forces = NULL});
     return list_add(scene->bodies, body);
 }
 
@@ -62,12 +307,152 @@ void scene_remove_body(scene_t *scene, size_t index) {
     body_remove(list_get(scene->bodies, index));
 }
 
+scene_handle_t scene_body_handle(scene_t *scene, body_t *body){
+    assert(body_get_store(body) == scene->store);
+    return handle_get(&scene->body_handles, slot_info_list_get(scene->slots, body_get_slot(body)).handle);
+}
+
+body_t *scene_resolve_body(scene_t *scene, scene_handle_t handle){
+    size_t position = handle_resolve(&scene->body_handles, handle);
+    return position != SIZE_MAX ? list_get(scene->bodies, position) : NULL;
+}
+
+scene_handle_t scene_force_handle(scene_t *scene, force_t *force){
+    scene_handle_t handle = handle_get(&scene->force_handles, force_get_handle(force));
+    assert(list_get(scene->forces, handle_resolve(&scene->force_handles, handle)) == force);
+    return handle;
+}
+
+force_t *scene_resolve_force(scene_t *scene, scene_handle_t handle){
+    size_t position = handle_resolve(&scene->force_handles, handle);
+    return position != SIZE_MAX ? list_get(scene->forces, position) : NULL;
+}
+
+// adds a force to the list of a body's forces, first dropping the ones that have been removed if the list is full
+static void add_body_force(scene_t *scene, size_t slot, scene_handle_t handle){
+    slot_info_t *info = &slot_info_list_data(scene->slots)[slot];
+    if(info->forces == NULL) info->forces = handle_list_init(1);
+    handle_list_t *forces = info->forces;
+    if(forces->size == forces->capacity){
+        size_t kept = 0;
+        VEC_FOR_EACH(scene_handle_t, force, forces){
+            if(handle_resolve(&scene->force_handles, *force) != SIZE_MAX) forces->data[kept++] = *force;
+        }
+        forces->size = kept;
+    }
+    handle_list_add(forces, handle);
+}
+
+// adds a force to the lists of its bodies' forces; returns false, without adding it, if they are not all in the scene yet
+static bool link_force(scene_t *scene, force_t *force){
+    list_t *bodies = force_get_bodies(force);
+    for(size_t i = 0; i < list_size(bodies); i++){
+        if(body_get_store(list_get(bodies, i)) != scene->store) return false;
+    }
+    scene_handle_t handle = scene_force_handle(scene, force);
+    for(size_t i = 0; i < list_size(bodies); i++){
+        add_body_force(scene, body_get_slot(list_get(bodies, i)), handle);
+    }
+    return true;
+}
+
+// adds a force to the end of the scene's list, gives it a handle, and links it to its bodies
+static void scene_add_force(scene_t *scene, force_t *force){
+    list_add(scene->forces, force);
+    if(scene->copying_forces) return;
+    force_set_handle(force, handle_acquire(&scene->force_handles, list_size(scene->forces) - 1));
+    if(!link_force(scene, force)) handle_list_add(scene->unlinked_forces, scene_force_handle(scene, force));
+}
+
 void scene_add_force_creator(scene_t *scene, force_creator_t forcer, void *aux, free_func_t freer){
-    list_add(scene->forces, force_init(forcer, aux, freer));
+    scene_add_force(scene, force_init_from_pool(scene->force_pool, forcer, aux, freer, list_init(0, free)));
+}
+
+force_t *scene_add_bodies_force_creator(scene_t *scene, force_creator_t forcer, void *aux, list_t *bodies, free_func_t freer){
+    force_t *force = force_init_from_pool(scene->force_pool, forcer, aux, freer, bodies);
+    scene_add_force(scene, force);
+    return force;
 }
 
-void scene_add_bodies_force_creator(scene_t *scene, force_creator_t forcer, void *aux, list_t *bodies, free_func_t freer){
-    list_add(scene->forces, force_init_with_bodies(forcer, aux, freer, bodies));
+force_t *scene_add_contact_force_creator(scene_t *scene, force_creator_t forcer, void *aux, list_t *bodies, free_func_t freer){
+    force_t *force = force_init_from_pool(scene->force_pool, forcer, aux, freer, bodies);
+    force_set_contact(force);
+    // the force runs once before the broadphase has seen its bodies
+    force_set_active(force, true);
+    body_t *body1 = list_get(bodies, 0);
+    body_t *body2 = list_get(bodies, 1);
+    list_t *pair_forces = pair_map_get(scene->contacts, body1, body2);
+    if(pair_forces == NULL){
+        pair_forces = list_init(1, (free_func_t) free);
+        pair_map_set(scene->contacts, body1, body2, pair_forces);
+    }
+    list_add(pair_forces, force);
+    scene_add_force(scene, force);
+    return force;
+}
+
+arena_t *scene_get_arena(scene_t *scene){
+    return scene->arena;
+}
+
+pool_t *scene_get_force_pool(scene_t *scene){
+    return scene->force_pool;
+}
+
+pool_t *scene_get_aux_pool(scene_t *scene){
+    return scene->aux_pool;
+}
+
+force_batch_t *scene_get_force_batch(scene_t *scene){
+    return scene->batch;
+}
+
+contact_solver_t *scene_get_contact_solver(scene_t *scene){
+    return scene->solver;
+}
+
+void scene_set_job_system(scene_t *scene, job_system_t *jobs){
+    scene->jobs = jobs;
+}
+
+job_system_t *scene_get_job_system(scene_t *scene){
+    return scene->jobs;
+}
+
+void scene_use_grid(scene_t *scene, double cell_size){
+    assert(cell_size >= 0);
+    scene->grid_cell_size = cell_size;
+    if(cell_size == 0 && scene->grid != NULL){
+        broadphase_free(scene->grid);
+        scene->grid = NULL;
+    }
+    else if(cell_size > 0 && scene->grid == NULL){
+        scene->grid = broadphase_init();
+    }
+}
+
+void scene_enable_sleeping(scene_t *scene, double sleep_speed, size_t sleep_ticks){
+    assert(sleep_speed >= 0);
+    scene->sleep_speed = sleep_speed;
+    scene->sleep_ticks = sleep_ticks;
+    if(sleep_ticks > 0) return;
+    bool *asleep = body_store_asleep(scene->store);
+    for(size_t i = 0; i < body_store_size(scene->store); i++){
+        if(asleep[i]) body_store_wake(scene->store, i);
+    }
+}
+
+size_t scene_awake_bodies(scene_t *scene){
+    bool *asleep = body_store_asleep(scene->store);
+    size_t awake = 0;
+    for(size_t i = 0; i < body_store_size(scene->store); i++){
+        if(!asleep[i]) awake++;
+    }
+    return awake;
+}
+
+void scene_query(scene_t *scene, aabb_t box, aabb_query_handler_t handler, void *aux){
+    aabb_tree_query(scene->tree, box, handler, aux);
 }
 
 void *scene_get_state(scene_t *scene){
@@ -75,41 +460,612 @@ void *scene_get_state(scene_t *scene){
 }
 
 void scene_set_state(scene_t *scene, void *state){
-    free(scene->state);
+    if(!scene->borrowed_state) free(scene->state);
     scene->state = state;
+    scene->borrowed_state = false;
+}
+
+static size_t island_find(size_t *islands, size_t slot){
+    while(islands[slot] != slot){
+        islands[slot] = islands[islands[slot]];
+        slot = islands[slot];
+    }
+    return slot;
+}
+
+// puts two bodies in the same island, unless one is static, since static bodies do not carry motion between others
+static void island_link(size_t slot1, size_t slot2, scene_t *scene){
+    double *inverse_masses = body_store_inverse_masses(scene->store);
+    if(inverse_masses[slot1] == 0 || inverse_masses[slot2] == 0) return;
+    scene->islands[island_find(scene->islands, slot1)] = island_find(scene->islands, slot2);
+}
+
+// puts all the moving bodies a force acts on in the same island
+static void link_force_bodies(scene_t *scene, list_t *bodies){
+    double *inverse_masses = body_store_inverse_masses(scene->store);
+    size_t first = SIZE_MAX;
+    for(size_t i = 0; i < list_size(bodies); i++){
+        body_t *body = list_get(bodies, i);
+        if(body_get_store(body) != scene->store) continue;
+        size_t slot = body_get_slot(body);
+        if(inverse_masses[slot] == 0) continue;
+        if(first == SIZE_MAX) first = slot;
+        else island_link(first, slot, scene);
+    }
+}
+
+// bodies that might be touching an awake body wake up and share its island
+static void wake_pair(scene_t *scene, size_t slot1, size_t slot2){
+    bool *asleep = body_store_asleep(scene->store);
+    double *inverse_masses = body_store_inverse_masses(scene->store);
+    if(asleep[slot1] && inverse_masses[slot1] != 0) body_store_wake(scene->store, slot1);
+    if(asleep[slot2] && inverse_masses[slot2] != 0) body_store_wake(scene->store, slot2);
+    island_link(slot1, slot2, scene);
+}
+
+static void activate_pair(body_t *body1, body_t *body2, scene_t *scene){
+    size_t slot1 = body_get_slot(body1);
+    size_t slot2 = body_get_slot(body2);
+    bool *asleep = body_store_asleep(scene->store);
+    if(asleep[slot1] && asleep[slot2]) return;
+    bool solved = contact_solver_activate(scene->solver, body1, body2);
+    list_t *pair_forces = pair_map_get(scene->contacts, body1, body2);
+    if(scene->islands != NULL && (solved || pair_forces != NULL)) wake_pair(scene, slot1, slot2);
+    if(pair_forces == NULL) return;
+    for(size_t i = 0; i < list_size(pair_forces); i++){
+        force_t *force = list_get(pair_forces, i);
+        force_set_active(force, true);
+        handle_list_add(scene->recent_contacts, scene_force_handle(scene, force));
+    }
+}
+
+static bool activate_awake_pair(body_t *other, contact_query_t *query){
+    if(other == query->body) return true;
+    // a pair of awake bodies is found from the body in the lower slot
+    if(!body_is_asleep(other) && body_get_slot(other) < body_get_slot(query->body)) return true;
+    activate_pair(query->body, other, query->scene);
+    return true;
+}
+
+// finds the pairs involving an awake body, since two sleeping bodies cannot have started touching
+static void scene_find_awake_pairs(scene_t *scene){
+    for(size_t i = 0; i < scene_bodies(scene); i++){
+        body_t *body = list_get(scene->bodies, i);
+        if(body_is_asleep(body)) continue;
+        contact_query_t query = {.scene = scene, .body = body};
+        aabb_t bounds = aabb_tree_get_bounds(scene->tree, body_get_proxy(body));
+        aabb_tree_query(scene->tree, bounds, (aabb_query_handler_t) activate_awake_pair, &query);
+    }
+}
+
+// marks the contact forces whose bodies might be touching this tick
+static void scene_find_contacts(scene_t *scene){
+    // forces that were touching last tick run once more so they see the bodies separate
+    VEC_FOR_EACH(scene_handle_t, handle, scene->recent_contacts){
+        force_t *force = scene_resolve_force(scene, *handle);
+        if(force != NULL) force_set_active(force, true);
+    }
+    handle_list_clear(scene->recent_contacts);
+    if(pair_map_size(scene->contacts) == 0 && contact_solver_size(scene->solver) == 0) return;
+    if(scene->islands != NULL){
+        scene_find_awake_pairs(scene);
+        return;
+    }
+    if(scene->grid == NULL){
+        aabb_tree_find_pairs(scene->tree, (pair_handler_t) activate_pair, scene);
+        return;
+    }
+    // the grid is given the tree's fat boxes, so it finds the same pairs
+    broadphase_clear(scene->grid, scene->grid_cell_size);
+    for(size_t i = 0; i < scene_bodies(scene); i++){
+        body_t *body = list_get(scene->bodies, i);
+        broadphase_insert(scene->grid, body, aabb_tree_get_bounds(scene->tree, body_get_proxy(body)));
+    }
+    broadphase_find_pairs(scene->grid, (pair_handler_t) activate_pair, scene);
+}
+
+// refits the tree to wherever the bodies have moved since the last tick
+static void scene_update_tree(scene_t *scene){
+    for(size_t i = 0; i < scene_bodies(scene); i++){
+        body_t *body = list_get(scene->bodies, i);
+        if(body_is_asleep(body)) continue;
+        aabb_tree_move(scene->tree, body_get_proxy(body), body_get_bounds(body));
+    }
+}
+
+// records where each bullet is before the bodies move, in memory from the tick's arena
+static bullet_t *scene_find_bullets(scene_t *scene, size_t *count){
+    *count = 0;
+    for(size_t i = 0; i < scene_bodies(scene); i++){
+        if(body_is_bullet(list_get(scene->bodies, i))) (*count)++;
+    }
+    if(*count == 0) return NULL;
+    bullet_t *bullets = arena_alloc(scene->arena, *count * sizeof(bullet_t));
+    size_t next = 0;
+    for(size_t i = 0; i < scene_bodies(scene); i++){
+        body_t *body = list_get(scene->bodies, i);
+        if(body_is_bullet(body)) bullets[next++] = (bullet_t){.body = body, .start = body_get_centroid(body)};
+    }
+    return bullets;
+}
+
+// finds when a bullet first touches another body by checking positions along its path,
+// close enough together that it cannot skip over anything, then halving the gap before the first hit
+static double sample_toi(sweep_t *sweep, body_t *other){
+    vector_t *centroid = &body_store_centroids(sweep->scene->store)[body_get_slot(sweep->bullet)];
+    aabb_t bounds = body_get_bounds(sweep->bullet);
+    double spacing = fmin(bounds.max.x - bounds.min.x, bounds.max.y - bounds.min.y) / 2;
+    vector_t motion = vec_subtract(sweep->end, sweep->start);
+    double distance = sqrt(vec_dot(motion, motion));
+    size_t samples = spacing > 0 ? (size_t) ceil(distance / spacing) : 1;
+    if(samples == 0) samples = 1;
+    double free_t = -1;
+    double hit_t = INFINITY;
+    for(size_t k = 0; k <= samples; k++){
+        double t = (double) k / samples;
+        *centroid = vec_add(sweep->start, vec_multiply(t, motion));
+        if(find_body_collision(sweep->bullet, other).collided){
+            hit_t = t;
+            break;
+        }
+        free_t = t;
+    }
+    if(free_t >= 0 && hit_t != INFINITY){
+        for(int i = 0; i < SCENE_BULLET_BISECTIONS; i++){
+            double t = (free_t + hit_t) / 2;
+            *centroid = vec_add(sweep->start, vec_multiply(t, motion));
+            if(find_body_collision(sweep->bullet, other).collided) hit_t = t;
+            else free_t = t;
+        }
+    }
+    *centroid = sweep->end;
+    return hit_t;
+}
+
+// the time of impact between a bullet and a static body, as a fraction of the tick
+static double sweep_toi(sweep_t *sweep, body_t *other){
+    if(body_get_shape_kind(sweep->bullet) != SHAPE_CIRCLE) return sample_toi(sweep, other);
+    // the bullet stops a little inside, so the contact solver sees the bodies touching next tick
+    double radius = body_get_radius(sweep->bullet);
+    radius -= fmin(contact_solver_get_slop(scene_get_contact_solver(sweep->scene)) / 2, radius / 2);
+    vector_t start, end;
+    switch(body_get_shape_kind(other)){
+        case SHAPE_CIRCLE:
+            return find_circle_toi(sweep->start, sweep->end, radius, body_get_centroid(other), body_get_radius(other));
+        case SHAPE_CAPSULE:
+            body_get_segment(other, &start, &end);
+            return find_circle_capsule_toi(sweep->start, sweep->end, radius, start, end, body_get_radius(other));
+        case SHAPE_POLYGON:
+        default: {
+            size_t n;
+            const vector_t *shape = body_shape_view(other, &n);
+            return find_circle_polygon_toi(sweep->start, sweep->end, radius, shape, n);
+        }
+    }
+}
+
+static bool sweep_body(body_t *other, sweep_t *sweep){
+    if(other == sweep->bullet || body_get_mass(other) != INFINITY) return true;
+    if(!contact_solver_has_pair(sweep->scene->solver, sweep->bullet, other)) return true;
+    double toi = sweep_toi(sweep, other);
+    if(toi < sweep->toi) sweep->toi = toi;
+    return true;
+}
+
+// stops each bullet at the first static body it would have bounced off during the tick
+static void scene_sweep_bullets(scene_t *scene, bullet_t *bullets, size_t count){
+    for(size_t i = 0; i < count; i++){
+        sweep_t sweep = {.scene = scene, .bullet = bullets[i].body, .start = bullets[i].start, .toi = INFINITY};
+        sweep.end = body_get_centroid(sweep.bullet);
+        vector_t motion = vec_subtract(sweep.end, sweep.start);
+        if(motion.x == 0 && motion.y == 0) continue;
+        aabb_t end_bounds = body_get_bounds(sweep.bullet);
+        aabb_t start_bounds = {.min = vec_subtract(end_bounds.min, motion), .max = vec_subtract(end_bounds.max, motion)};
+        aabb_tree_query(scene->tree, aabb_union(start_bounds, end_bounds), (aabb_query_handler_t) sweep_body, &sweep);
+        // a bullet already touching something at the start is left to the contact solver
+        if(sweep.toi > 0 && sweep.toi < 1){
+            body_store_centroids(scene->store)[body_get_slot(sweep.bullet)] = vec_add(sweep.start, vec_multiply(sweep.toi, motion));
+        }
+    }
+}
+
+// gets whether a force only acts on bodies that are asleep, so running it would do nothing
+static bool force_is_asleep(force_t *force){
+    list_t *bodies = force_get_bodies(force);
+    // a force that does not name its bodies could act on any of them
+    if(list_size(bodies) == 0) return false;
+    for(size_t i = 0; i < list_size(bodies); i++){
+        if(!body_is_asleep(list_get(bodies, i))) return false;
+    }
+    return true;
+}
+
+// starts every body in its own island, keeping the islands found so far
+static void scene_start_islands(scene_t *scene){
+    size_t count = body_store_size(scene->store);
+    size_t *islands = arena_alloc(scene->arena, (count + 1) * sizeof(size_t));
+    for(size_t i = 0; i < count; i++){
+        islands[i] = i < scene->island_count ? scene->islands[i] : i;
+    }
+    scene->islands = islands;
+    scene->island_count = count;
+}
+
+// puts each island whose bodies have all been still for long enough to sleep, and wakes the rest.
+// static bodies sleep on their own once they stop moving, and only wake when they are moved
+static void scene_update_sleep(scene_t *scene){
+    size_t count = body_store_size(scene->store);
+    vector_t *velocities = body_store_velocities(scene->store);
+    double *inverse_masses = body_store_inverse_masses(scene->store);
+    bool *asleep = body_store_asleep(scene->store);
+    size_t *still_ticks = body_store_still_ticks(scene->store);
+    // bodies may have been added during the tick
+    if(count > scene->island_count) scene_start_islands(scene);
+    double max_speed_squared = scene->sleep_speed * scene->sleep_speed;
+    for(size_t i = 0; i < count; i++){
+        if(asleep[i]) continue;
+        double speed_squared = vec_dot(velocities[i], velocities[i]);
+        bool still = inverse_masses[i] == 0 ? speed_squared == 0 : speed_squared < max_speed_squared;
+        still_ticks[i] = still ? still_ticks[i] + 1 : 0;
+    }
+    for(size_t i = 0; i < list_size(scene->forces); i++){
+        force_t *force = list_get(scene->forces, i);
+        if(!force_is_contact(force)) link_force_bodies(scene, force_get_bodies(force));
+    }
+    force_batch_for_each_pair(scene->batch, (slot_pair_handler_t) island_link, scene);
+    // the fewest still ticks of any body in each island, kept at its root
+    size_t *island_ticks = arena_alloc(scene->arena, (count + 1) * sizeof(size_t));
+    for(size_t i = 0; i < count; i++){
+        island_ticks[i] = SIZE_MAX;
+    }
+    for(size_t i = 0; i < count; i++){
+        if(inverse_masses[i] == 0) continue;
+        size_t root = island_find(scene->islands, i);
+        if(still_ticks[i] < island_ticks[root]) island_ticks[root] = still_ticks[i];
+    }
+    for(size_t i = 0; i < count; i++){
+        if(inverse_masses[i] == 0){
+            asleep[i] = still_ticks[i] >= scene->sleep_ticks;
+            continue;
+        }
+        bool sleep = island_ticks[island_find(scene->islands, i)] >= scene->sleep_ticks;
+        if(sleep && !asleep[i]) velocities[i] = VEC_ZERO;
+        if(!sleep && asleep[i]) still_ticks[i] = 0;
+        asleep[i] = sleep;
+    }
+    scene->islands = NULL;
+    scene->island_count = 0;
+}
+
+static void integrate_chunk(integration_t *integration, size_t chunk){
+    size_t start = chunk * SCENE_INTEGRATE_CHUNK;
+    size_t end = start + SCENE_INTEGRATE_CHUNK;
+    if(end > body_store_size(integration->store)) end = body_store_size(integration->store);
+    body_store_integrate_range(integration->store, integration->dt, start, end);
+}
+
+// moves every body at once, streaming through the store, a chunk of slots per job
+static void scene_integrate(scene_t *scene, double dt){
+    integration_t integration = {.store = scene->store, .dt = dt};
+    size_t chunks = (body_store_size(scene->store) + SCENE_INTEGRATE_CHUNK - 1) / SCENE_INTEGRATE_CHUNK;
+    job_system_parallel_for(scene->jobs, chunks, 1, (job_func_t) integrate_chunk, &integration);
+}
+
+// gets whether a body a force acts on has been removed
+static bool has_removed_body(force_t *force){
+    list_t *bodies = force_get_bodies(force);
+    for(size_t i = 0; i < list_size(bodies); i++){
+        if(body_is_removed(list_get(bodies, i))) return true;
+    }
+    return false;
+}
+
+// queues a force to be freed at the end of the tick; a force queued twice is only freed once,
+// since its handle no longer finds it the second time
+static void queue_force_removal(scene_t *scene, force_t *force){
+    force_remove(force);
+    handle_list_add(scene->removed_forces, scene_force_handle(scene, force));
+}
+
+// links the forces whose bodies have all been added since, and queues the ones with a removed body
+static void scene_link_forces(scene_t *scene){
+    scene_handle_t *unlinked = handle_list_data(scene->unlinked_forces);
+    size_t kept = 0;
+    for(size_t i = 0; i < handle_list_size(scene->unlinked_forces); i++){
+        force_t *force = scene_resolve_force(scene, unlinked[i]);
+        if(force == NULL) continue;
+        if(has_removed_body(force)) queue_force_removal(scene, force);
+        else if(!link_force(scene, force)) unlinked[kept++] = unlinked[i];
+    }
+    scene->unlinked_forces->size = kept;
+}
+
+// frees a force, moving the last force into its place in the list
+static void scene_free_force(scene_t *scene, force_t *force){
+    size_t handle = force_get_handle(force);
+    size_t position = handle_entry_list_get(scene->force_handles.entries, handle).position;
+    force_t *last = list_remove(scene->forces, list_size(scene->forces) - 1);
+    if(last != force){
+        list_set(scene->forces, position, last);
+        handle_move(&scene->force_handles, force_get_handle(last), position);
+    }
+    handle_release(&scene->force_handles, handle);
+    if(force_is_contact(force)) scene_unlink_contact(scene, force);
+    force_free(force);
+}
+
+// frees a body, moving the body in the last slot into its slot, as body_store_remove() does
+static void scene_free_body(scene_t *scene, body_t *body){
+    size_t slot = body_get_slot(body);
+    aabb_tree_remove(scene->tree, body_get_proxy(body));
+    contact_solver_remove_body(scene->solver, body);
+    force_batch_remove_slot(scene->batch, slot, body_store_size(scene->store) - 1);
+    body_t *moved = body_store_remove(scene->store, slot);
+    slot_info_t info = slot_info_list_swap_remove(scene->slots, slot);
+    handle_release(&scene->body_handles, info.handle);
+    if(info.forces != NULL) handle_list_free(info.forces);
+    list_remove(scene->bodies, list_size(scene->bodies) - 1);
+    if(moved != NULL){
+        body_set_slot(moved, slot);
+        list_set(scene->bodies, slot, moved);
+        handle_move(&scene->body_handles, slot_info_list_get(scene->slots, slot).handle, slot);
+    }
+    body_free(body);
+}
+
+// frees the bodies marked with body_remove() and the forces on them.
+// finding them takes one pass over the bodies, like the rest of the tick;
+// from there, only their own forces are visited, and the last body or force fills each gap
+static void scene_remove_flagged(scene_t *scene){
+    if(handle_list_size(scene->unlinked_forces) > 0) scene_link_forces(scene);
+    force_batch_drop_removed(scene->batch);
+    for(size_t i = 0; i < scene_bodies(scene); i++){
+        body_t *body = list_get(scene->bodies, i);
+        if(!body_is_removed(body)) continue;
+        body_ptr_list_add(scene->removed_bodies, body);
+        handle_list_t *forces = slot_info_list_get(scene->slots, i).forces;
+        if(forces == NULL) continue;
+        VEC_FOR_EACH(scene_handle_t, handle, forces){
+            force_t *force = scene_resolve_force(scene, *handle);
+            if(force != NULL) queue_force_removal(scene, force);
+        }
+    }
+    VEC_FOR_EACH(scene_handle_t, handle, scene->removed_forces){
+        force_t *force = scene_resolve_force(scene, *handle);
+        if(force != NULL) scene_free_force(scene, force);
+    }
+    handle_list_clear(scene->removed_forces);
+    VEC_FOR_EACH(body_t *, body, scene->removed_bodies){
+        scene_free_body(scene, *body);
+    }
+    body_ptr_list_clear(scene->removed_bodies);
 }
 
 void scene_tick(scene_t *scene, double dt){
+    arena_reset(scene->arena);
+    if(scene->sleep_ticks > 0) scene_start_islands(scene);
+    scene_update_tree(scene);
+    scene_find_contacts(scene);
+    force_batch_apply(scene->batch, scene->store, scene->tree, scene->jobs);
     //creates force if force is not removed else removes force from list
     for(size_t i = 0; i < list_size(scene->forces); i++){
         force_t *force = list_get(scene->forces, i);
+        // forces removed with force_remove() are only found here
+        if(force_is_removed(force)){
+            queue_force_removal(scene, force);
+            continue;
+        }
+        if(force_is_contact(force)){
+            if(!force_is_active(force)) continue;
+            force_set_active(force, false);
+        }
+        if(scene->islands != NULL && force_is_asleep(force)) continue;
         force_create(force);
     }
-    //moves body if body is not removed else removes body from list
-    for(size_t i = 0; i < scene_bodies(scene); i++){
-        body_tick(list_get(scene->bodies, i), dt);
+    contact_solver_solve(scene->solver, scene->store, dt, scene->jobs);
+    size_t num_bullets;
+    bullet_t *bullets = scene_find_bullets(scene, &num_bullets);
+    scene_integrate(scene, dt);
+    scene_sweep_bullets(scene, bullets, num_bullets);
+    if(scene->islands != NULL) scene_update_sleep(scene);
+    scene_remove_flagged(scene);
+}
+
+size_t scene_step_fixed(scene_t *scene, double frame_dt, double step, size_t max_substeps){
+    assert(step > 0);
+    assert(max_substeps > 0);
+    scene->accumulator += frame_dt;
+    size_t substeps = 0;
+    while(scene->accumulator >= step && substeps < max_substeps){
+        body_store_save_previous(scene->store);
+        scene_tick(scene, step);
+        scene->accumulator -= step;
+        substeps++;
     }
-    //flags forces with remove if any of their corresponding bodies are removed
+    // after a long hitch, drop the time that could not be simulated rather than falling further behind
+    if(scene->accumulator >= step) scene->accumulator = fmod(scene->accumulator, step);
+    scene->alpha = scene->accumulator / step;
+    return substeps;
+}
+
+double scene_get_alpha(scene_t *scene){
+    return scene->alpha;
+}
+
+size_t scene_fast_forward(scene_t *scene, double duration, double step, tick_handler_t handler, void *aux){
+    assert(step > 0);
+    size_t max_ticks = (size_t) (duration / step);
+    size_t ticks = 0;
+    while(ticks < max_ticks){
+        scene_tick(scene, step);
+        ticks++;
+        if(handler != NULL && !handler(scene, aux)) break;
+        if(scene->sleep_ticks > 0 && scene_awake_bodies(scene) == 0) break;
+    }
+    return ticks;
+}
+
+// marks which forces are recent contacts, by their position in the list; NULL if there are none
+static bool *find_recent_contacts(scene_t *scene){
+    if(handle_list_size(scene->recent_contacts) == 0 || list_size(scene->forces) == 0) return NULL;
+    bool *recent = calloc(list_size(scene->forces), sizeof(bool));
+    assert(recent);
+    VEC_FOR_EACH(scene_handle_t, handle, scene->recent_contacts){
+        size_t position = handle_resolve(&scene->force_handles, *handle);
+        if(position != SIZE_MAX) recent[position] = true;
+    }
+    return recent;
+}
+
+// writes each force's flags and changing state, in the order of the scene's list
+static void snapshot_forces(scene_t *scene, void *buffer, size_t *offset){
+    bool *recent = buffer != NULL ? find_recent_contacts(scene) : NULL;
     for(size_t i = 0; i < list_size(scene->forces); i++){
-        list_t *bodies = force_get_bodies(list_get(scene->forces, i));
-        for(size_t j = 0; j < list_size(bodies); j++){
-            if(body_is_removed(list_get(bodies, j))){
-                force_remove(list_get(scene->forces, i));
-                break;
-            }
-        }
+        force_t *force = list_get(scene->forces, i);
+        uint8_t flags = force_is_active(force) ? SNAPSHOT_FORCE_ACTIVE : 0;
+        if(recent != NULL && recent[i]) flags |= SNAPSHOT_FORCE_RECENT;
+        size_t size;
+        void *state = force_get_state(force, &size);
+        snapshot_write(buffer, offset, &flags, sizeof(uint8_t));
+        snapshot_write(buffer, offset, state, size);
+    }
+    free(recent);
+}
+
+size_t scene_snapshot(scene_t *scene, void *buffer){
+    size_t offset = 0;
+    size_t num_bodies = list_size(scene->bodies);
+    size_t num_forces = list_size(scene->forces);
+    snapshot_write(buffer, &offset, &SCENE_SNAPSHOT_MAGIC, sizeof(uint32_t));
+    snapshot_write(buffer, &offset, &num_bodies, sizeof(size_t));
+    snapshot_write(buffer, &offset, &num_forces, sizeof(size_t));
+    snapshot_write(buffer, &offset, &scene->accumulator, sizeof(double));
+    snapshot_write(buffer, &offset, &scene->alpha, sizeof(double));
+    for(size_t i = 0; i < num_bodies; i++){
+        double angle = body_get_angle(list_get(scene->bodies, i));
+        snapshot_write(buffer, &offset, &angle, sizeof(double));
+    }
+    offset += body_store_snapshot(scene->store, buffer != NULL ? (char *) buffer + offset : NULL);
+    offset += aabb_tree_snapshot(scene->tree, buffer != NULL ? (char *) buffer + offset : NULL);
+    offset += contact_solver_snapshot(scene->solver, buffer != NULL ? (char *) buffer + offset : NULL);
+    snapshot_forces(scene, buffer, &offset);
+    return offset;
+}
+
+void scene_restore(scene_t *scene, const void *buffer){
+    size_t offset = 0;
+    uint32_t magic;
+    size_t num_bodies, num_forces;
+    snapshot_read(buffer, &offset, &magic, sizeof(uint32_t));
+    snapshot_read(buffer, &offset, &num_bodies, sizeof(size_t));
+    snapshot_read(buffer, &offset, &num_forces, sizeof(size_t));
+    assert(magic == SCENE_SNAPSHOT_MAGIC);
+    assert(num_bodies == list_size(scene->bodies));
+    assert(num_forces == list_size(scene->forces));
+    snapshot_read(buffer, &offset, &scene->accumulator, sizeof(double));
+    snapshot_read(buffer, &offset, &scene->alpha, sizeof(double));
+    for(size_t i = 0; i < num_bodies; i++){
+        double angle;
+        snapshot_read(buffer, &offset, &angle, sizeof(double));
+        body_set_angle(list_get(scene->bodies, i), angle);
+    }
+    offset += body_store_restore(scene->store, (const char *) buffer + offset);
+    offset += aabb_tree_restore(scene->tree, (const char *) buffer + offset);
+    offset += contact_solver_restore(scene->solver, (const char *) buffer + offset);
+    handle_list_clear(scene->recent_contacts);
+    for(size_t i = 0; i < num_forces; i++){
+        force_t *force = list_get(scene->forces, i);
+        uint8_t flags;
+        size_t size;
+        void *state = force_get_state(force, &size);
+        snapshot_read(buffer, &offset, &flags, sizeof(uint8_t));
+        snapshot_read(buffer, &offset, state, size);
+        force_set_active(force, flags & SNAPSHOT_FORCE_ACTIVE);
+        if(flags & SNAPSHOT_FORCE_RECENT) handle_list_add(scene->recent_contacts, scene_force_handle(scene, force));
     }
+}
+
+// copies each force into a clone, in the same order, along with its handle, flags and changing state
+static void clone_forces(scene_t *scene, scene_t *clone){
+    clone->copying_forces = true;
     for(size_t i = 0; i < list_size(scene->forces); i++){
         force_t *force = list_get(scene->forces, i);
-        if(force_is_removed(force)){
-            force_free(list_remove(scene->forces, i));
-            i--;
-        }
+        force_clone(force, clone);
+        assert(list_size(clone->forces) == i + 1);
+        force_t *copy = list_get(clone->forces, i);
+        force_set_handle(copy, force_get_handle(force));
+        force_set_active(copy, force_is_active(force));
+        size_t size, copy_size;
+        void *state = force_get_state(force, &size);
+        void *copy_state = force_get_state(copy, &copy_size);
+        assert(copy_size == size);
+        if(size > 0) memcpy(copy_state, state, size);
     }
-    for(size_t i = 0; i<scene_bodies(scene); i++){
-        if(body_is_removed(list_get(scene->bodies, i))){
-            body_free(list_remove(scene->bodies, i));
-            i--;
+    clone->copying_forces = false;
+}
+
+scene_t *scene_clone(scene_t *scene){
+    // a copy missing a force would not play out the same, so nothing is copied
+    for(size_t i = 0; i < list_size(scene->forces); i++){
+        if(!force_is_cloneable(list_get(scene->forces, i))) return NULL;
+    }
+    scene_t *clone = malloc(sizeof(scene_t));
+    assert(clone);
+    // each body keeps its slot and proxy, so everything that refers to bodies by them can be copied as is
+    clone->store = body_store_clone(scene->store);
+    clone->tree = aabb_tree_clone(scene->tree);
+    clone->grid = NULL;
+    scene_use_grid(clone, scene->grid_cell_size);
+    clone->bodies = list_init(list_size(scene->bodies), (free_func_t) scene_bodies_free);
+    for(size_t i = 0; i < list_size(scene->bodies); i++){
+        body_t *body = body_clone(list_get(scene->bodies, i), clone->store);
+        aabb_tree_set_item(clone->tree, body_get_proxy(body), body);
+        list_add(clone->bodies, body);
+    }
+    clone->forces = list_init(list_size(scene->forces), (free_func_t) scene_forces_free);
+    // collision handlers in the copy, which are passed the clone, find the same state
+    clone->state = scene->state;
+    clone->borrowed_state = true;
+    // the handles are copied too, so handles to the original's bodies and forces find their copies
+    handle_table_copy(&clone->body_handles, &scene->body_handles);
+    handle_table_copy(&clone->force_handles, &scene->force_handles);
+    clone->slots = slot_info_list_init(slot_info_list_size(scene->slots));
+    VEC_FOR_EACH(slot_info_t, info, scene->slots){
+        slot_info_t copy = {.handle = info->handle, .forces = NULL};
+        if(info->forces != NULL){
+            copy.forces = handle_list_init(handle_list_size(info->forces));
+            handle_list_append(copy.forces, handle_list_data(info->forces), handle_list_size(info->forces));
         }
+        slot_info_list_add(clone->slots, copy);
     }
-}
\ No newline at end of file
+    clone->unlinked_forces = handle_list_init(handle_list_size(scene->unlinked_forces));
+    handle_list_append(clone->unlinked_forces, handle_list_data(scene->unlinked_forces), handle_list_size(scene->unlinked_forces));
+    clone->copying_forces = false;
+    clone->removed_bodies = body_ptr_list_init(DEFAULT_NUM_BODIES);
+    clone->removed_forces = handle_list_init(DEFAULT_NUM_BODIES);
+    clone->contacts = pair_map_init(DEFAULT_NUM_BODIES);
+    clone->recent_contacts = handle_list_init(handle_list_size(scene->recent_contacts));
+    handle_list_append(clone->recent_contacts, handle_list_data(scene->recent_contacts), handle_list_size(scene->recent_contacts));
+    clone->arena = arena_init(SCENE_ARENA_SIZE);
+    // a clone is often thrown away after a few ticks, so its pools start out with room for just its forces
+    size_t chunk = list_size(scene->forces);
+    if(chunk < SCENE_CLONE_MIN_CHUNK) chunk = SCENE_CLONE_MIN_CHUNK;
+    if(chunk > SCENE_POOL_CHUNK) chunk = SCENE_POOL_CHUNK;
+    clone->force_pool = force_pool_init(chunk);
+    clone->aux_pool = aux_pool_init(chunk);
+    clone->batch = force_batch_clone(scene->batch, scene->store);
+    clone->solver = contact_solver_clone(scene->solver, clone->store);
+    clone->accumulator = scene->accumulator;
+    clone->alpha = scene->alpha;
+    clone->sleep_speed = scene->sleep_speed;
+    clone->sleep_ticks = scene->sleep_ticks;
+    clone->islands = NULL;
+    clone->island_count = 0;
+    clone->jobs = scene->jobs;
+    clone_forces(scene, clone);
+    return clone;
+}
+
+body_t *scene_get_clone(scene_t *clone, body_t *body){
+    return body_store_get_owner(clone->store, body_get_slot(body));
+}
@@ -6,11 +6,17 @@
 #include <SDL2/SDL2_gfxPrimitives.h>
 #include <SDL2/SDL_image.h>
 #include "sdl_wrapper.h"
+#include "typed_vec.h"
+#include "arena.h"
+
+DECLARE_VEC(rect_list, SDL_Rect)
+DECLARE_VEC(texture_list, SDL_Texture *)
 
 const char WINDOW_TITLE[] = "CS 3";
 const int WINDOW_WIDTH = 1000;
 const int WINDOW_HEIGHT = 500;
 const double MS_PER_S = 1e3;
+const size_t FRAME_ARENA_SIZE = 16384;
 
 /**
  * The coordinate at the center of the screen.
@@ -28,10 +34,18 @@ SDL_Window *window;
  * The renderer used to draw the scene.
  */
 SDL_Renderer *renderer;
-list_t *texture_text;
-list_t *rect_text;
-list_t *texture_img;
-list_t *rect_img;
+/**
+ * The textures drawn over the scene in the current frame, and where to draw them.
+ * Cleared by sdl_show().
+ */
+texture_list_t *texture_text;
+rect_list_t *rect_text;
+texture_list_t *texture_img;
+rect_list_t *rect_img;
+/**
+ * Memory used while drawing one frame. Reset by sdl_clear().
+ */
+arena_t *frame_arena;
 /**
  * The keypress handler, or NULL if none has been configured.
  */
@@ -117,20 +131,11 @@ char get_keycode(SDL_Keycode key) {
     }
 }
 
-void sdl_free_rect(list_t *list){
-    for(size_t i = 0; i < list_size(list); i++){
-        free(list_remove(list, i));
-        i--;
-    }
-    free(list);
-}
-
-void sdl_free_texture(list_t *list){
-    for(size_t i = 0; i < list_size(list); i++){
-        SDL_DestroyTexture(list_remove(list, i));
-        i--;
+void sdl_clear_textures(texture_list_t *textures){
+    VEC_FOR_EACH(SDL_Texture *, texture, textures){
+        SDL_DestroyTexture(*texture);
     }
-    free(list);
+    texture_list_clear(textures);
 }
 
 void sdl_init(vector_t min, vector_t max) {
@@ -151,11 +156,13 @@ void sdl_init(vector_t min, vector_t max) {
     );
     renderer = SDL_CreateRenderer(window, -1, 0);
 
-    rect_text = list_init(10, (free_func_t)sdl_free_rect);
-    texture_text = list_init(10, (free_func_t)sdl_free_texture);
+    rect_text = rect_list_init(10);
+    texture_text = texture_list_init(10);
 
-    rect_img = list_init(10, (free_func_t)sdl_free_rect);
-    texture_img = list_init(10, (free_func_t)sdl_free_texture);
+    rect_img = rect_list_init(10);
+    texture_img = texture_list_init(10);
+
+    frame_arena = arena_init(FRAME_ARENA_SIZE);
 }
 
 bool sdl_is_done(void *scene) {
@@ -226,13 +233,23 @@ bool sdl_is_done(void *scene) {
 }
 
 void sdl_clear(void) {
+    arena_reset(frame_arena);
     SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
     SDL_RenderClear(renderer);
 }
 
 void sdl_draw_polygon(list_t *points, rgb_color_t color, SDL_Surface *texture, bool has_texture, SDL_Rect *rect) {
+    polygon_t *polygon = polygon_from_list(points);
+    sdl_draw_shape(polygon, color, texture, has_texture, rect);
+    polygon_free(polygon);
+}
+
+void sdl_draw_shape(polygon_t *polygon, rgb_color_t color, SDL_Surface *texture, bool has_texture, SDL_Rect *rect) {
+    sdl_draw_points(polygon_points(polygon), polygon_size(polygon), color, texture, has_texture, rect);
+}
+
+void sdl_draw_points(const vector_t *points, size_t n, rgb_color_t color, SDL_Surface *texture, bool has_texture, SDL_Rect *rect) {
     // Check parameters
-    size_t n = list_size(points);
     assert(n >= 3);
     assert(0 <= color.r && color.r <= 1);
     assert(0 <= color.g && color.g <= 1);
@@ -241,13 +258,10 @@ void sdl_draw_polygon(list_t *points, rgb_color_t color, SDL_Surface *texture, b
     vector_t window_center = get_window_center();
 
     // Convert each vertex to a point on screen
-    int16_t *x_points = malloc(sizeof(*x_points) * n),
-            *y_points = malloc(sizeof(*y_points) * n);
-    assert(x_points != NULL);
-    assert(y_points != NULL);
+    int16_t *x_points = arena_alloc(frame_arena, sizeof(*x_points) * n),
+            *y_points = arena_alloc(frame_arena, sizeof(*y_points) * n);
     for (size_t i = 0; i < n; i++) {
-        vector_t *vertex = list_get(points, i);
-        vector_t pixel = get_window_position(*vertex, window_center);
+        vector_t pixel = get_window_position(points[i], window_center);
         x_points[i] = pixel.x;
         y_points[i] = pixel.y;
     }
@@ -260,26 +274,20 @@ void sdl_draw_polygon(list_t *points, rgb_color_t color, SDL_Surface *texture, b
     /*
     if(has_texture){
         SDL_Texture *img_texture = SDL_CreateTextureFromSurface(renderer, texture);
-        list_add(rect_img, rect);
-        list_add(texture_img, img_texture);
+        rect_list_add(rect_img, *rect);
+        texture_list_add(texture_img, img_texture);
         SDL_RenderCopy(renderer, img_texture, NULL, rect);
         //texturedPolygon(renderer, x_points, y_points, n, texture, 0, 0);
     }
     */
-    free(x_points);
-    free(y_points);
 }
 
 void sdl_draw_text(SDL_Surface *surface, double x, double y, double w, double h){
     SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
     SDL_FreeSurface(surface);
-    SDL_Rect *rect = malloc(sizeof(*rect));
-    rect->x = x;
-    rect->y = y;
-    rect->w = w;
-    rect->h = h;
-    list_add(rect_text, rect);
-    list_add(texture_text, texture);
+    SDL_Rect rect = {.x = x, .y = y, .w = w, .h = h};
+    rect_list_add(rect_text, rect);
+    texture_list_add(texture_text, texture);
 }
 
 void sdl_show(void) {
@@ -296,21 +304,17 @@ void sdl_show(void) {
     boundary->h = min_pixel.y - max_pixel.y;
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
     SDL_RenderDrawRect(renderer, boundary);
-    for(size_t i = 0; i < list_size(texture_text); i++){
-        SDL_RenderCopy(renderer, list_get(texture_text, i), NULL, list_get(rect_text, i));
+    for(size_t i = 0; i < texture_list_size(texture_text); i++){
+        SDL_RenderCopy(renderer, texture_list_get(texture_text, i), NULL, &rect_list_data(rect_text)[i]);
     }
-    for(size_t i = 0; i < list_size(texture_img); i++){
-        SDL_RenderCopy(renderer, list_get(texture_img, i), NULL, list_get(rect_img, i));
+    for(size_t i = 0; i < texture_list_size(texture_img); i++){
+        SDL_RenderCopy(renderer, texture_list_get(texture_img, i), NULL, &rect_list_data(rect_img)[i]);
     }
-    list_free(texture_text);
-    list_free(rect_text);
-    rect_text = list_init(10, (free_func_t)sdl_free_rect);
-    texture_text = list_init(10, (free_func_t)sdl_free_texture);
-
-    list_free(texture_img);
-    list_free(rect_img);
-    rect_img = list_init(10, (free_func_t)sdl_free_rect);
-    texture_img = list_init(10, (free_func_t)sdl_free_texture);
+    sdl_clear_textures(texture_text);
+    rect_list_clear(rect_text);
+
+    sdl_clear_textures(texture_img);
+    rect_list_clear(rect_img);
     free(boundary);
 
     SDL_RenderPresent(renderer);
@@ -318,12 +322,24 @@ void sdl_show(void) {
 
 void sdl_render_scene(scene_t *scene) {
     sdl_clear();
+    double alpha = scene_get_alpha(scene);
     size_t body_count = scene_bodies(scene);
     for (size_t i = 0; i < body_count; i++) {
         body_t *body = scene_get_body(scene, i);
-        list_t *shape = body_get_shape(body);
-        if(!body_is_hidden(body)) sdl_draw_polygon(shape, body_get_color(body), body_get_texture(body), body_has_texture(body), body_get_rect(body));
-        list_free(shape);
+        if(body_is_hidden(body)) continue;
+        size_t n;
+        const vector_t *shape = body_shape_view(body, &n);
+        SDL_Rect rect = body_get_rect(body);
+        // draws the body part of the way back to where it was before the last fixed step
+        vector_t offset = vec_multiply(alpha - 1, vec_subtract(body_get_centroid(body), body_get_previous_centroid(body)));
+        if(offset.x != 0 || offset.y != 0){
+            vector_t *moved = arena_alloc(frame_arena, n * sizeof(vector_t));
+            for(size_t j = 0; j < n; j++) moved[j] = vec_add(shape[j], offset);
+            shape = moved;
+            rect.x += offset.x;
+            rect.y += offset.y;
+        }
+        sdl_draw_points(shape, n, body_get_color(body), body_get_texture(body), body_has_texture(body), &rect);
     }
     sdl_show();
 }
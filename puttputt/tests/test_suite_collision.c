@@ -0,0 +1,132 @@
+#include "collision.h"
+#include "test_util.h"
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+// enough vertices to run every lane of the 4-wide projection and its scalar tail
+#define MAX_VERTICES 13
+#define NUM_PAIRS 2000
+#define EPSILON 1e-9
+
+// a convex polygon with its vertices on a circle, in counterclockwise order.
+// the vertices are spaced unevenly, so no two edges are parallel and no two axes tie
+static size_t random_polygon(vector_t *points){
+    size_t n = 3 + rand() % (MAX_VERTICES - 2);
+    vector_t center = {rand() % 200, rand() % 200};
+    double radius = 10 + rand() % 40;
+    double start = 2 * M_PI * rand() / RAND_MAX;
+    for(size_t i = 0; i < n; i++){
+        double angle = start + 2 * M_PI * (i + 0.8 * rand() / RAND_MAX) / n;
+        points[i] = (vector_t){center.x + radius * cos(angle), center.y + radius * sin(angle)};
+    }
+    return n;
+}
+
+// the separating axis test, one vertex at a time
+static double reference_overlap(const vector_t *shape1, size_t n1, const vector_t *shape2, size_t n2, vector_t *axis){
+    double best = INFINITY;
+    for(size_t i = 0; i < n1; i++){
+        vector_t edge = vec_subtract(shape1[i], shape1[(i + 1) % n1]);
+        vector_t normal = {-edge.y, edge.x};
+        normal = vec_multiply(1 / sqrt(vec_dot(normal, normal)), normal);
+        double min1 = INFINITY, max1 = -INFINITY, min2 = INFINITY, max2 = -INFINITY;
+        for(size_t j = 0; j < n1; j++){
+            min1 = fmin(min1, vec_dot(shape1[j], normal));
+            max1 = fmax(max1, vec_dot(shape1[j], normal));
+        }
+        for(size_t j = 0; j < n2; j++){
+            min2 = fmin(min2, vec_dot(shape2[j], normal));
+            max2 = fmax(max2, vec_dot(shape2[j], normal));
+        }
+        if(max1 < min2 || max2 < min1) return -1;
+        double overlap = fmin(max1, max2) - fmax(min1, min2);
+        if(overlap < best){
+            best = overlap;
+            *axis = normal;
+        }
+    }
+    return best;
+}
+
+static collision_info_t reference_collision(const vector_t *shape1, size_t n1, const vector_t *shape2, size_t n2){
+    vector_t axis1, axis2;
+    double overlap1 = reference_overlap(shape1, n1, shape2, n2, &axis1);
+    if(overlap1 < 0) return (collision_info_t){.collided = false};
+    double overlap2 = reference_overlap(shape2, n2, shape1, n1, &axis2);
+    if(overlap2 < 0) return (collision_info_t){.collided = false};
+    if(overlap1 < overlap2) return (collision_info_t){.collided = true, .axis = axis1, .depth = overlap1};
+    return (collision_info_t){.collided = true, .axis = axis2, .depth = overlap2};
+}
+
+static void assert_same_collision(collision_info_t actual, collision_info_t expected){
+    assert(actual.collided == expected.collided);
+    if(!expected.collided) return;
+    assert(within(EPSILON, actual.depth, expected.depth));
+    assert(vec_within(EPSILON, actual.axis, expected.axis));
+}
+
+// find_collision_points() projects several vertices at a time where the compiler allows it
+void test_points_match_scalar(){
+    srand(1);
+    size_t collided = 0;
+    for(size_t k = 0; k < NUM_PAIRS; k++){
+        vector_t shape1[MAX_VERTICES], shape2[MAX_VERTICES];
+        size_t n1 = random_polygon(shape1);
+        size_t n2 = random_polygon(shape2);
+        collision_info_t expected = reference_collision(shape1, n1, shape2, n2);
+        assert_same_collision(find_collision_points(shape1, n1, shape2, n2), expected);
+        if(expected.collided) collided++;
+    }
+    // both outcomes are covered
+    assert(collided > NUM_PAIRS / 10 && collided < NUM_PAIRS * 9 / 10);
+}
+
+void test_cached_axes_match_scalar(){
+    srand(2);
+    for(size_t k = 0; k < NUM_PAIRS; k++){
+        vector_t shape1[MAX_VERTICES], shape2[MAX_VERTICES];
+        vector_t normals1[MAX_VERTICES], intervals1[MAX_VERTICES];
+        vector_t normals2[MAX_VERTICES], intervals2[MAX_VERTICES];
+        size_t n1 = random_polygon(shape1);
+        size_t n2 = random_polygon(shape2);
+        find_edge_axes(shape1, n1, normals1, intervals1);
+        find_edge_axes(shape2, n2, normals2, intervals2);
+        collision_info_t actual = find_collision_axes(shape1, n1, normals1, intervals1, shape2, n2, normals2, intervals2);
+        assert_same_collision(actual, reference_collision(shape1, n1, shape2, n2));
+    }
+}
+
+void test_one_against_many_match_scalar(){
+    srand(3);
+    vector_t shape[MAX_VERTICES];
+    vector_t others[NUM_PAIRS][MAX_VERTICES];
+    const vector_t *views[NUM_PAIRS];
+    size_t counts[NUM_PAIRS];
+    collision_info_t results[NUM_PAIRS];
+    size_t n = random_polygon(shape);
+    for(size_t k = 0; k < NUM_PAIRS; k++){
+        counts[k] = random_polygon(others[k]);
+        views[k] = others[k];
+    }
+    find_collisions(shape, n, views, counts, NUM_PAIRS, results);
+    for(size_t k = 0; k < NUM_PAIRS; k++){
+        assert_same_collision(results[k], reference_collision(shape, n, others[k], counts[k]));
+    }
+}
+
+int main(int argc, char *argv[]){
+    // Run all tests if there are no command-line arguments
+    bool all_tests = argc == 1;
+    // Read test name from file
+    char testname[100];
+    if(!all_tests){
+        read_testname(argv[1], testname, sizeof(testname));
+    }
+
+    DO_TEST(test_points_match_scalar)
+    DO_TEST(test_cached_axes_match_scalar)
+    DO_TEST(test_one_against_many_match_scalar)
+
+    puts("collision_test PASS");
+}
@@ -0,0 +1,293 @@
+#include "force.h"
+#include "forces.h"
+#include "scene.h"
+#include "test_util.h"
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+#define DT 1e-3
+#define NUM_BODIES 8
+
+const rgb_color_t GRAY = {0.5, 0.5, 0.5};
+
+static body_t *make_circle(vector_t center, double radius){
+    return body_init_circle(center, radius, 16, 1, GRAY, NULL, NULL);
+}
+
+// counts how often a force runs and whether its aux was freed
+typedef struct{
+    size_t *calls;
+    size_t *frees;
+}counter_t;
+
+static counter_t *counter_init(size_t *calls, size_t *frees){
+    counter_t *counter = malloc(sizeof(counter_t));
+    assert(counter);
+    *counter = (counter_t){.calls = calls, .frees = frees};
+    return counter;
+}
+
+static void count_call(counter_t *counter){
+    (*counter->calls)++;
+}
+
+static void counter_free(counter_t *counter){
+    (*counter->frees)++;
+    free(counter);
+}
+
+static force_t *add_counter(scene_t *scene, body_t *body, size_t *calls, size_t *frees){
+    list_t *bodies = list_init(1, NULL);
+    list_add(bodies, body);
+    return scene_add_bodies_force_creator(
+        scene, (force_creator_t) count_call, counter_init(calls, frees), bodies, (free_func_t) counter_free
+    );
+}
+
+// bodies moving apart, bouncing off each other and pulled back together by springs
+static scene_t *make_busy_scene(void){
+    scene_t *scene = scene_init();
+    for(size_t i = 0; i < NUM_BODIES; i++){
+        body_t *body = make_circle((vector_t){30 * i, 10 * (i % 3)}, 12);
+        body_set_velocity(body, (vector_t){50 - 15.0 * i, 20.0 * (i % 2)});
+        scene_add_body(scene, body);
+    }
+    for(size_t i = 0; i < NUM_BODIES; i++){
+        body_t *body = scene_get_body(scene, i);
+        if(i > 0) create_spring(scene, 20, body, scene_get_body(scene, i - 1));
+        for(size_t j = i + 1; j < NUM_BODIES; j++){
+            create_physics_collision(scene, 0.9, body, scene_get_body(scene, j));
+        }
+    }
+    return scene;
+}
+
+void test_handles_survive_removal(){
+    scene_t *scene = scene_init();
+    body_t *bodies[NUM_BODIES];
+    scene_handle_t handles[NUM_BODIES];
+    for(size_t i = 0; i < NUM_BODIES; i++){
+        bodies[i] = make_circle((vector_t){100 * i, 0}, 5);
+        scene_add_body(scene, bodies[i]);
+        handles[i] = scene_body_handle(scene, bodies[i]);
+    }
+    body_remove(bodies[2]);
+    body_remove(bodies[5]);
+    // still found until the end of the tick that frees them
+    assert(scene_resolve_body(scene, handles[2]) == bodies[2]);
+    scene_tick(scene, DT);
+    assert(scene_bodies(scene) == NUM_BODIES - 2);
+    for(size_t i = 0; i < NUM_BODIES; i++){
+        body_t *expected = i == 2 || i == 5 ? NULL : bodies[i];
+        assert(scene_resolve_body(scene, handles[i]) == expected);
+    }
+    // a freed slot is reused, but the old handle does not find its new body
+    body_t *late = make_circle(VEC_ZERO, 5);
+    scene_add_body(scene, late);
+    assert(scene_resolve_body(scene, handles[2]) == NULL);
+    assert(scene_resolve_body(scene, handles[5]) == NULL);
+    assert(scene_resolve_body(scene, scene_body_handle(scene, late)) == late);
+    scene_free(scene);
+}
+
+void test_removing_body_frees_its_forces(){
+    scene_t *scene = scene_init();
+    body_t *kept = make_circle(VEC_ZERO, 5);
+    body_t *removed = make_circle((vector_t){100, 0}, 5);
+    scene_add_body(scene, kept);
+    scene_add_body(scene, removed);
+    size_t kept_calls = 0, kept_frees = 0, removed_calls = 0, removed_frees = 0;
+    add_counter(scene, kept, &kept_calls, &kept_frees);
+    force_t *force = add_counter(scene, removed, &removed_calls, &removed_frees);
+    scene_handle_t handle = scene_force_handle(scene, force);
+    scene_tick(scene, DT);
+    assert(kept_calls == 1 && removed_calls == 1);
+    body_remove(removed);
+    scene_tick(scene, DT);
+    assert(removed_frees == 1);
+    assert(scene_resolve_force(scene, handle) == NULL);
+    scene_tick(scene, DT);
+    assert(kept_calls == 3 && removed_calls == 2);
+    assert(kept_frees == 0);
+    scene_free(scene);
+    assert(kept_frees == 1 && removed_frees == 1);
+}
+
+void test_force_remove_stops_force(){
+    scene_t *scene = scene_init();
+    body_t *body = make_circle(VEC_ZERO, 5);
+    body_t *other = make_circle((vector_t){100, 0}, 5);
+    scene_add_body(scene, body);
+    scene_add_body(scene, other);
+    size_t calls = 0, frees = 0, other_calls = 0, other_frees = 0;
+    force_t *force = add_counter(scene, body, &calls, &frees);
+    force_t *other_force = add_counter(scene, other, &other_calls, &other_frees);
+    scene_handle_t handle = scene_force_handle(scene, force);
+    scene_tick(scene, DT);
+    force_remove(force);
+    scene_tick(scene, DT);
+    scene_tick(scene, DT);
+    assert(calls == 1 && frees == 1);
+    assert(scene_resolve_force(scene, handle) == NULL);
+
+    // removing the force and its body in the same tick frees the force once
+    size_t other_calls_before = other_calls;
+    force_remove(other_force);
+    body_remove(other);
+    scene_tick(scene, DT);
+    assert(other_calls == other_calls_before && other_frees == 1);
+    assert(scene_bodies(scene) == 1);
+    scene_free(scene);
+    assert(frees == 1 && other_frees == 1);
+}
+
+void test_grid_plays_out_like_tree(){
+    scene_t *scene = make_busy_scene();
+    scene_t *gridded = make_busy_scene();
+    scene_use_grid(gridded, 50);
+    for(size_t i = 0; i < 1000; i++){
+        scene_tick(scene, DT);
+        scene_tick(gridded, DT);
+        // switching back to the tree partway through picks up where the grid left off
+        if(i == 500) scene_use_grid(gridded, 0);
+    }
+    for(size_t i = 0; i < NUM_BODIES; i++){
+        assert(vec_within(1e-6, body_get_centroid(scene_get_body(gridded, i)), body_get_centroid(scene_get_body(scene, i))));
+    }
+    scene_free(scene);
+    scene_free(gridded);
+}
+
+void test_snapshot_round_trip(){
+    scene_t *scene = make_busy_scene();
+    for(size_t i = 0; i < 100; i++) scene_tick(scene, DT);
+    size_t size = scene_snapshot(scene, NULL);
+    void *buffer = malloc(size);
+    assert(buffer);
+    assert(scene_snapshot(scene, buffer) == size);
+
+    vector_t centroids[NUM_BODIES], velocities[NUM_BODIES];
+    for(size_t i = 0; i < 500; i++) scene_tick(scene, DT);
+    for(size_t i = 0; i < NUM_BODIES; i++){
+        centroids[i] = body_get_centroid(scene_get_body(scene, i));
+        velocities[i] = body_get_velocity(scene_get_body(scene, i));
+    }
+    scene_restore(scene, buffer);
+    for(size_t i = 0; i < 500; i++) scene_tick(scene, DT);
+    for(size_t i = 0; i < NUM_BODIES; i++){
+        assert(vec_equal(body_get_centroid(scene_get_body(scene, i)), centroids[i]));
+        assert(vec_equal(body_get_velocity(scene_get_body(scene, i)), velocities[i]));
+    }
+    free(buffer);
+    scene_free(scene);
+}
+
+static void count_hit(body_t *body1, body_t *body2, vector_t axis, scene_t *scene){
+    (void) body1;
+    (void) body2;
+    (void) axis;
+    (*(size_t *) scene_get_state(scene))++;
+}
+
+void test_clone_shares_state(){
+    scene_t *scene = scene_init();
+    size_t *hits = malloc(sizeof(size_t));
+    assert(hits);
+    *hits = 0;
+    scene_set_state(scene, hits);
+    body_t *ball = make_circle(VEC_ZERO, 10);
+    body_t *wall = make_circle((vector_t){50, 0}, 10);
+    body_set_velocity(ball, (vector_t){1000, 0});
+    scene_add_body(scene, ball);
+    scene_add_body(scene, wall);
+    create_collision(scene, ball, wall, (collision_handler_t) count_hit, scene, NULL);
+    scene_t *clone = scene_clone(scene);
+    assert(clone != NULL);
+    assert(scene_get_state(clone) == hits);
+    for(size_t i = 0; i < 100; i++){
+        scene_tick(scene, DT);
+        scene_tick(clone, DT);
+    }
+    assert(*hits == 2);
+    // the copy's state can be replaced without freeing the original's
+    scene_set_state(clone, NULL);
+    scene_free(clone);
+    assert(*hits == 2);
+    scene_free(scene);
+    free(hits);
+}
+
+void test_sleep_and_wake(){
+    scene_t *scene = scene_init();
+    body_t *resting = make_circle(VEC_ZERO, 10);
+    body_t *moving = make_circle((vector_t){-200, 0}, 10);
+    scene_add_body(scene, resting);
+    scene_add_body(scene, moving);
+    create_physics_collision(scene, 1, resting, moving);
+    scene_enable_sleeping(scene, 1, 10);
+    for(size_t i = 0; i < 20; i++) scene_tick(scene, DT);
+    assert(body_is_asleep(resting) && body_is_asleep(moving));
+    assert(scene_awake_bodies(scene) == 0);
+
+    // an asleep body does not move until it is woken
+    body_set_velocity(moving, (vector_t){1000, 0});
+    body_wake(moving);
+    assert(!body_is_asleep(moving));
+    scene_tick(scene, DT);
+    assert(body_get_centroid(moving).x > -200);
+    assert(body_is_asleep(resting));
+
+    // running into the resting body wakes it and passes on the push
+    for(size_t i = 0; i < 300; i++) scene_tick(scene, DT);
+    assert(!body_is_asleep(resting));
+    assert(body_get_velocity(resting).x > 0);
+    scene_free(scene);
+}
+
+void test_moving_in_place_keeps_sleeping(){
+    scene_t *scene = scene_init();
+    body_t *body = make_circle(VEC_ZERO, 10);
+    scene_add_body(scene, body);
+    scene_enable_sleeping(scene, 1, 10);
+    for(size_t i = 0; i < 20; i++) scene_tick(scene, DT);
+    assert(body_is_asleep(body));
+    body_set_centroid(body, VEC_ZERO);
+    body_translate(body, VEC_ZERO);
+    assert(body_is_asleep(body));
+
+    // a translated body is still drawn moving along its path
+    vector_t offset = {5, -3};
+    body_translate(body, offset);
+    assert(!body_is_asleep(body));
+    body_set_velocity(body, (vector_t){1000, 0});
+    scene_step_fixed(scene, DT, DT, 1);
+    vector_t previous = body_get_previous_centroid(body);
+    vector_t step = vec_subtract(body_get_centroid(body), previous);
+    body_translate(body, offset);
+    assert(vec_equal(body_get_previous_centroid(body), vec_add(previous, offset)));
+    assert(vec_isclose(vec_subtract(body_get_centroid(body), body_get_previous_centroid(body)), step));
+    assert(step.x > 0);
+    scene_free(scene);
+}
+
+int main(int argc, char *argv[]){
+    // Run all tests if there are no command-line arguments
+    bool all_tests = argc == 1;
+    // Read test name from file
+    char testname[100];
+    if(!all_tests){
+        read_testname(argv[1], testname, sizeof(testname));
+    }
+
+    DO_TEST(test_handles_survive_removal)
+    DO_TEST(test_removing_body_frees_its_forces)
+    DO_TEST(test_force_remove_stops_force)
+    DO_TEST(test_grid_plays_out_like_tree)
+    DO_TEST(test_snapshot_round_trip)
+    DO_TEST(test_clone_shares_state)
+    DO_TEST(test_sleep_and_wake)
+    DO_TEST(test_moving_in_place_keeps_sleeping)
+
+    puts("scene_test PASS");
+}